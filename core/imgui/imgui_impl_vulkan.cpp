@@ -89,6 +89,9 @@
 #ifndef IM_MAX
 #define IM_MAX(A, B)    (((A) >= (B)) ? (A) : (B))
 #endif
+#ifndef IM_MIN
+#define IM_MIN(A, B)    (((A) <= (B)) ? (A) : (B))
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -129,12 +132,14 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdBindVertexBuffers) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdCopyBufferToImage) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdDrawIndexed) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdDrawIndexedIndirect) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdPipelineBarrier) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdPushConstants) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdSetScissor) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdSetViewport) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateBuffer) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateCommandPool) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateDescriptorPool) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateDescriptorSetLayout) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateFence) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateFramebuffer) \
@@ -149,6 +154,7 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCreateSwapchainKHR) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyBuffer) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyCommandPool) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyDescriptorPool) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyDescriptorSetLayout) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyFence) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkDestroyFramebuffer) \
@@ -197,12 +203,51 @@ static PFN_vkCmdEndRenderingKHR     ImGuiImplVulkanFuncs_vkCmdEndRenderingKHR;
 // [Please zero-clear before use!]
 struct ImGui_ImplVulkan_FrameRenderBuffers
 {
-    VkDeviceMemory      VertexBufferMemory;
-    VkDeviceMemory      IndexBufferMemory;
+    ImGui_ImplVulkan_MemoryAllocation VertexBufferMemory;
+    ImGui_ImplVulkan_MemoryAllocation IndexBufferMemory;
     VkDeviceSize        VertexBufferSize;
     VkDeviceSize        IndexBufferSize;
     VkBuffer            VertexBuffer;
     VkBuffer            IndexBuffer;
+
+    // Buffers and offsets actually bound for this frame (our own buffers, or a slice of the streaming ring buffer)
+    VkBuffer            DrawVertexBuffer;
+    VkDeviceSize        DrawVertexOffset;
+    VkBuffer            DrawIndexBuffer;
+    VkDeviceSize        DrawIndexOffset;
+
+    // Bindless: one VkDrawIndexedIndirectCommand per ImDrawCmd, followed by their ImGui_ImplVulkan_BindlessInstance
+    ImGui_ImplVulkan_MemoryAllocation IndirectBufferMemory;
+    VkDeviceSize        IndirectBufferSize;
+    VkBuffer            IndirectBuffer;
+    VkDeviceSize        DrawInstanceOffset;
+};
+
+// Per-instance vertex attributes of an ImDrawCmd drawn by the bindless pipeline, 'firstInstance' of its indirect command selects it
+struct ImGui_ImplVulkan_BindlessInstance
+{
+    ImVec4              ClipRect;               // Unprojected, compared with vertex positions through gl_ClipDistance
+    uint32_t            Texture;                // Slot in the texture array
+};
+
+// Bindless: slot of a removed texture, in-flight frames may still sample it until the frame that removed it completes
+struct ImGui_ImplVulkan_RetiredSlot
+{
+    int                 Slot;
+    uint64_t            RetireFrame;            // ImGui_ImplVulkan_Data::FrameSerial when the texture was removed
+};
+
+// Persistently mapped ring buffer shared by all in-flight frames, see ImGui_ImplVulkan_InitInfo::UseStreamingBuffer
+// [Please zero-clear before use!]
+struct ImGui_ImplVulkan_StreamingBuffer
+{
+    VkBuffer            Buffer;
+    ImGui_ImplVulkan_MemoryAllocation Memory;
+    VkDeviceSize        Size;
+    VkDeviceSize        Head;                   // Next free byte
+    VkDeviceSize*       FrameStart;             // Start of the data of each in-flight frame, or ~0 if it uploaded nothing
+    uint32_t            FrameCount;
+    char*               MappedData;
 };
 
 // Each viewport will hold 1 ImGui_ImplVulkanH_WindowRenderBuffers
@@ -228,7 +273,7 @@ struct ImGui_ImplVulkan_Data
 
     // Font data
     VkSampler                   FontSampler;
-    VkDeviceMemory              FontMemory;
+    ImGui_ImplVulkan_MemoryAllocation FontMemory;
     VkImage                     FontImage;
     VkImageView                 FontView;
     VkDescriptorSet             FontDescriptorSet;
@@ -237,6 +282,40 @@ struct ImGui_ImplVulkan_Data
 
     // Render buffers for main window
     ImGui_ImplVulkan_WindowRenderBuffers MainWindowRenderBuffers;
+    ImGui_ImplVulkan_StreamingBuffer StreamingBuffer;
+    VkDeviceSize                NonCoherentAtomSize;
+    uint32_t                    MaxDrawIndirectCount;
+
+    // Bindless rendering, see ImGui_ImplVulkan_InitInfo::UseBindless
+    VkDescriptorSetLayout       BindlessSetLayout;
+    VkPipelineLayout            BindlessPipelineLayout;
+    VkPipeline                  BindlessPipeline;
+    VkShaderModule              BindlessShaderModuleVert;
+    VkShaderModule              BindlessShaderModuleFrag;
+    VkDescriptorPool            BindlessDescriptorPool;
+    VkDescriptorSet             BindlessDescriptorSet;
+    ImVector<VkDescriptorSet>   BindlessTextures;       // Descriptor set registered in each slot of the array, VK_NULL_HANDLE when free
+    ImVector<int>               BindlessFreeSlots;
+    ImVector<ImGui_ImplVulkan_RetiredSlot> BindlessRetiredSlots; // Back to BindlessFreeSlots once ImGui_ImplVulkan_BeginDrawData() reuses the frame of their removal
+    uint64_t                    FrameSerial;            // Frames started by ImGui_ImplVulkan_BeginDrawData()
+    ImGuiStorage                BindlessSlots;          // Key of the descriptor set -> slot + 1, see ImGui_ImplVulkan_BindlessSlot()
+
+    // Frame being uploaded/recorded, see ImGui_ImplVulkan_BeginDrawData()
+    ImVector<int>               ListVtxOffsets;         // Prefix sums over the lists, CmdListsCount + 1 entries
+    ImVector<int>               ListIdxOffsets;
+    ImDrawVert*                 UploadVtxDst;           // Mapped destination of the frame, nullptr when there is nothing to upload
+    ImDrawIdx*                  UploadIdxDst;
+    ImVector<int>               ListCmdOffsets;         // Bindless: index of the first indirect command of each list, CmdListsCount + 1 entries
+    VkDrawIndexedIndirectCommand* UploadIndirectDst;
+    ImGui_ImplVulkan_BindlessInstance* UploadInstanceDst;
+    ImGui_ImplVulkan_FrameRenderBuffers* DrawRenderBuffers;
+    bool                        DrawStateTracking;
+    bool                        DrawRebasedIndices;     // Indices already include the vertex offset of their list and command, draws use vertexOffset 0
+    bool                        DrawBindless;
+    ImGui_ImplVulkan_RenderStats RenderStats;
+    VkPipeline                  DrawPipeline;
+    int                         DrawFbWidth;
+    int                         DrawFbHeight;
 
     ImGui_ImplVulkan_Data()
     {
@@ -354,6 +433,157 @@ static uint32_t __glsl_shader_frag_spv[] =
     0x00010038
 };
 
+// Bindless variant of glsl_shader.vert, see ImGui_ImplVulkan_InitInfo::UseBindless.
+// NOTE: unlike the shaders above, this SPIR-V was assembled by hand from the GLSL below (generator word 0) and has not been
+// through glslangValidator or spirv-val yet, which is why UseBindless is opt-in. Regenerate and validate it with:
+// # glslangValidator -V -x -o glsl_shader_bindless.vert.u32 glsl_shader_bindless.vert
+// # spirv-val glsl_shader_bindless.vert.spv
+/*
+#version 450 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec4 aClipRect;     // Per instance
+layout(location = 4) in uint aTexture;      // Per instance
+layout(push_constant) uniform uPushConstant { vec2 uScale; vec2 uTranslate; } pc;
+
+out gl_PerVertex { vec4 gl_Position; float gl_ClipDistance[4]; };
+layout(location = 0) out struct { vec4 Color; vec2 UV; } Out;
+layout(location = 2) flat out uint Texture;
+
+void main()
+{
+    Out.Color = aColor;
+    Out.UV = aUV;
+    Texture = aTexture;
+    gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
+    gl_ClipDistance[0] = aPos.x - aClipRect.x;
+    gl_ClipDistance[1] = aPos.y - aClipRect.y;
+    gl_ClipDistance[2] = aClipRect.z - aPos.x;
+    gl_ClipDistance[3] = aClipRect.w - aPos.y;
+}
+*/
+static uint32_t __glsl_shader_vert_bindless_spv[] =
+{
+    0x07230203,0x00010000,0x00000000,0x00000049,0x00000000,0x00020011,0x00000001,0x00020011,
+    0x00000020,0x0006000b,0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,
+    0x00000000,0x00000001,0x000d000f,0x00000000,0x00000002,0x6e69616d,0x00000000,0x00000003,
+    0x00000004,0x00000005,0x00000006,0x00000007,0x00000008,0x00000009,0x0000000a,0x00030003,
+    0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,0x00000000,0x00030005,0x0000000b,
+    0x00000000,0x00050006,0x0000000b,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x0000000b,
+    0x00000001,0x00005655,0x00030005,0x00000003,0x0074754f,0x00040005,0x00000004,0x6c6f4361,
+    0x0000726f,0x00030005,0x00000005,0x00565561,0x00040005,0x00000008,0x74786554,0x00657275,
+    0x00050005,0x00000009,0x78655461,0x65727574,0x00000000,0x00060005,0x0000000c,0x505f6c67,
+    0x65567265,0x78657472,0x00000000,0x00060006,0x0000000c,0x00000000,0x505f6c67,0x7469736f,
+    0x006e6f69,0x00070006,0x0000000c,0x00000001,0x435f6c67,0x4470696c,0x61747369,0x0065636e,
+    0x00030005,0x00000006,0x00000000,0x00040005,0x00000007,0x736f5061,0x00000000,0x00050005,
+    0x0000000a,0x696c4361,0x63655270,0x00000074,0x00060005,0x0000000d,0x73755075,0x6e6f4368,
+    0x6e617473,0x00000074,0x00050006,0x0000000d,0x00000000,0x61635375,0x0000656c,0x00060006,
+    0x0000000d,0x00000001,0x61725475,0x616c736e,0x00006574,0x00030005,0x0000000e,0x00006370,
+    0x00040047,0x00000003,0x0000001e,0x00000000,0x00040047,0x00000004,0x0000001e,0x00000002,
+    0x00040047,0x00000005,0x0000001e,0x00000001,0x00030047,0x00000008,0x0000000e,0x00040047,
+    0x00000008,0x0000001e,0x00000002,0x00040047,0x00000009,0x0000001e,0x00000004,0x00050048,
+    0x0000000c,0x00000000,0x0000000b,0x00000000,0x00050048,0x0000000c,0x00000001,0x0000000b,
+    0x00000003,0x00030047,0x0000000c,0x00000002,0x00040047,0x00000007,0x0000001e,0x00000000,
+    0x00040047,0x0000000a,0x0000001e,0x00000003,0x00050048,0x0000000d,0x00000000,0x00000023,
+    0x00000000,0x00050048,0x0000000d,0x00000001,0x00000023,0x00000008,0x00030047,0x0000000d,
+    0x00000002,0x00020013,0x0000000f,0x00030021,0x00000010,0x0000000f,0x00030016,0x00000011,
+    0x00000020,0x00040017,0x00000012,0x00000011,0x00000004,0x00040017,0x00000013,0x00000011,
+    0x00000002,0x0004001e,0x0000000b,0x00000012,0x00000013,0x00040020,0x00000014,0x00000003,
+    0x0000000b,0x0004003b,0x00000014,0x00000003,0x00000003,0x00040015,0x00000015,0x00000020,
+    0x00000001,0x0004002b,0x00000015,0x00000016,0x00000000,0x0004002b,0x00000015,0x00000017,
+    0x00000001,0x0004002b,0x00000015,0x00000018,0x00000002,0x0004002b,0x00000015,0x00000019,
+    0x00000003,0x00040020,0x0000001a,0x00000001,0x00000012,0x0004003b,0x0000001a,0x00000004,
+    0x00000001,0x00040020,0x0000001b,0x00000003,0x00000012,0x00040020,0x0000001c,0x00000001,
+    0x00000013,0x0004003b,0x0000001c,0x00000005,0x00000001,0x00040020,0x0000001d,0x00000003,
+    0x00000013,0x00040015,0x0000001e,0x00000020,0x00000000,0x00040020,0x0000001f,0x00000003,
+    0x0000001e,0x0004003b,0x0000001f,0x00000008,0x00000003,0x00040020,0x00000020,0x00000001,
+    0x0000001e,0x0004003b,0x00000020,0x00000009,0x00000001,0x0004002b,0x0000001e,0x00000021,
+    0x00000004,0x0004001c,0x00000022,0x00000011,0x00000021,0x0004001e,0x0000000c,0x00000012,
+    0x00000022,0x00040020,0x00000023,0x00000003,0x0000000c,0x0004003b,0x00000023,0x00000006,
+    0x00000003,0x0004003b,0x0000001c,0x00000007,0x00000001,0x0004003b,0x0000001a,0x0000000a,
+    0x00000001,0x0004001e,0x0000000d,0x00000013,0x00000013,0x00040020,0x00000024,0x00000009,
+    0x0000000d,0x0004003b,0x00000024,0x0000000e,0x00000009,0x00040020,0x00000025,0x00000009,
+    0x00000013,0x0004002b,0x00000011,0x00000026,0x00000000,0x0004002b,0x00000011,0x00000027,
+    0x3f800000,0x00040020,0x00000028,0x00000003,0x00000011,0x00050036,0x0000000f,0x00000002,
+    0x00000000,0x00000010,0x000200f8,0x00000029,0x0004003d,0x00000012,0x0000002a,0x00000004,
+    0x00050041,0x0000001b,0x0000002b,0x00000003,0x00000016,0x0003003e,0x0000002b,0x0000002a,
+    0x0004003d,0x00000013,0x0000002c,0x00000005,0x00050041,0x0000001d,0x0000002d,0x00000003,
+    0x00000017,0x0003003e,0x0000002d,0x0000002c,0x0004003d,0x0000001e,0x0000002e,0x00000009,
+    0x0003003e,0x00000008,0x0000002e,0x0004003d,0x00000013,0x0000002f,0x00000007,0x00050041,
+    0x00000025,0x00000030,0x0000000e,0x00000016,0x0004003d,0x00000013,0x00000031,0x00000030,
+    0x00050085,0x00000013,0x00000032,0x0000002f,0x00000031,0x00050041,0x00000025,0x00000033,
+    0x0000000e,0x00000017,0x0004003d,0x00000013,0x00000034,0x00000033,0x00050081,0x00000013,
+    0x00000035,0x00000032,0x00000034,0x00050051,0x00000011,0x00000036,0x00000035,0x00000000,
+    0x00050051,0x00000011,0x00000037,0x00000035,0x00000001,0x00070050,0x00000012,0x00000038,
+    0x00000036,0x00000037,0x00000026,0x00000027,0x00050041,0x0000001b,0x00000039,0x00000006,
+    0x00000016,0x0003003e,0x00000039,0x00000038,0x0004003d,0x00000012,0x0000003a,0x0000000a,
+    0x00050051,0x00000011,0x0000003b,0x0000002f,0x00000000,0x00050051,0x00000011,0x0000003c,
+    0x0000002f,0x00000001,0x00050051,0x00000011,0x0000003d,0x0000003a,0x00000000,0x00050051,
+    0x00000011,0x0000003e,0x0000003a,0x00000001,0x00050051,0x00000011,0x0000003f,0x0000003a,
+    0x00000002,0x00050051,0x00000011,0x00000040,0x0000003a,0x00000003,0x00050083,0x00000011,
+    0x00000041,0x0000003b,0x0000003d,0x00060041,0x00000028,0x00000042,0x00000006,0x00000017,
+    0x00000016,0x0003003e,0x00000042,0x00000041,0x00050083,0x00000011,0x00000043,0x0000003c,
+    0x0000003e,0x00060041,0x00000028,0x00000044,0x00000006,0x00000017,0x00000017,0x0003003e,
+    0x00000044,0x00000043,0x00050083,0x00000011,0x00000045,0x0000003f,0x0000003b,0x00060041,
+    0x00000028,0x00000046,0x00000006,0x00000017,0x00000018,0x0003003e,0x00000046,0x00000045,
+    0x00050083,0x00000011,0x00000047,0x00000040,0x0000003c,0x00060041,0x00000028,0x00000048,
+    0x00000006,0x00000017,0x00000019,0x0003003e,0x00000048,0x00000047,0x000100fd,0x00010038
+};
+
+
+// Bindless variant of glsl_shader.frag, hand-assembled and unvalidated like the vertex shader above. Regenerate and validate it with:
+// # glslangValidator -V -x -o glsl_shader_bindless.frag.u32 glsl_shader_bindless.frag
+// # spirv-val glsl_shader_bindless.frag.spv
+/*
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+layout(location = 0) out vec4 fColor;
+layout(set=0, binding=0) uniform sampler2D sTextures[];
+layout(location = 0) in struct { vec4 Color; vec2 UV; } In;
+layout(location = 2) flat in uint Texture;
+void main()
+{
+    fColor = In.Color * texture(sTextures[nonuniformEXT(Texture)], In.UV.st);
+}
+*/
+static uint32_t __glsl_shader_frag_bindless_spv[] =
+{
+    0x07230203,0x00010000,0x00000000,0x00000026,0x00000000,0x00020011,0x00000001,0x00020011,
+    0x000014b5,0x00020011,0x000014b6,0x00020011,0x000014bb,0x0008000a,0x5f565053,0x5f545845,
+    0x63736564,0x74706972,0x695f726f,0x7865646e,0x00676e69,0x0006000b,0x00000001,0x4c534c47,
+    0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,0x0008000f,0x00000004,
+    0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00000005,0x00030010,0x00000002,
+    0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,0x00000000,
+    0x00040005,0x00000003,0x6c6f4366,0x0000726f,0x00030005,0x00000006,0x00000000,0x00050006,
+    0x00000006,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x00000006,0x00000001,0x00005655,
+    0x00030005,0x00000004,0x00006e49,0x00050005,0x00000007,0x78655473,0x65727574,0x00000073,
+    0x00040005,0x00000005,0x74786554,0x00657275,0x00040047,0x00000003,0x0000001e,0x00000000,
+    0x00040047,0x00000004,0x0000001e,0x00000000,0x00040047,0x00000007,0x00000022,0x00000000,
+    0x00040047,0x00000007,0x00000021,0x00000000,0x00030047,0x00000005,0x0000000e,0x00040047,
+    0x00000005,0x0000001e,0x00000002,0x00030047,0x00000008,0x000014b4,0x00030047,0x00000009,
+    0x000014b4,0x00030047,0x0000000a,0x000014b4,0x00020013,0x0000000b,0x00030021,0x0000000c,
+    0x0000000b,0x00030016,0x0000000d,0x00000020,0x00040017,0x0000000e,0x0000000d,0x00000004,
+    0x00040020,0x0000000f,0x00000003,0x0000000e,0x0004003b,0x0000000f,0x00000003,0x00000003,
+    0x00040017,0x00000010,0x0000000d,0x00000002,0x0004001e,0x00000006,0x0000000e,0x00000010,
+    0x00040020,0x00000011,0x00000001,0x00000006,0x0004003b,0x00000011,0x00000004,0x00000001,
+    0x00040015,0x00000012,0x00000020,0x00000001,0x0004002b,0x00000012,0x00000013,0x00000000,
+    0x0004002b,0x00000012,0x00000014,0x00000001,0x00040020,0x00000015,0x00000001,0x0000000e,
+    0x00040020,0x00000016,0x00000001,0x00000010,0x00090019,0x00000017,0x0000000d,0x00000001,
+    0x00000000,0x00000000,0x00000000,0x00000001,0x00000000,0x0003001b,0x00000018,0x00000017,
+    0x0003001d,0x00000019,0x00000018,0x00040020,0x0000001a,0x00000000,0x00000019,0x0004003b,
+    0x0000001a,0x00000007,0x00000000,0x00040015,0x0000001b,0x00000020,0x00000000,0x00040020,
+    0x0000001c,0x00000001,0x0000001b,0x0004003b,0x0000001c,0x00000005,0x00000001,0x00040020,
+    0x0000001d,0x00000000,0x00000018,0x00050036,0x0000000b,0x00000002,0x00000000,0x0000000c,
+    0x000200f8,0x0000001e,0x00050041,0x00000015,0x0000001f,0x00000004,0x00000013,0x0004003d,
+    0x0000000e,0x00000020,0x0000001f,0x0004003d,0x0000001b,0x00000021,0x00000005,0x00040053,
+    0x0000001b,0x00000008,0x00000021,0x00050041,0x0000001d,0x00000009,0x00000007,0x00000008,
+    0x0004003d,0x00000018,0x0000000a,0x00000009,0x00050041,0x00000016,0x00000022,0x00000004,
+    0x00000014,0x0004003d,0x00000010,0x00000023,0x00000022,0x00050057,0x0000000e,0x00000024,
+    0x0000000a,0x00000023,0x00050085,0x0000000e,0x00000025,0x00000020,0x00000024,0x0003003e,
+    0x00000003,0x00000025,0x000100fd,0x00010038
+};
+
 //-----------------------------------------------------------------------------
 // FUNCTIONS
 //-----------------------------------------------------------------------------
@@ -394,15 +624,102 @@ static inline VkDeviceSize AlignBufferSize(VkDeviceSize size, VkDeviceSize align
     return (size + alignment - 1) & ~(alignment - 1);
 }
 
-static void CreateOrResizeBuffer(VkBuffer& buffer, VkDeviceMemory& buffer_memory, VkDeviceSize& buffer_size, size_t new_size, VkBufferUsageFlagBits usage)
+// Allocate memory through the user allocator if any, otherwise with a dedicated vkAllocateMemory() call.
+static void ImGui_ImplVulkan_AllocateMemory(const VkMemoryRequirements& req, VkMemoryPropertyFlags properties, ImGui_ImplVulkan_MemoryAllocation* allocation)
 {
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
-    VkResult err;
+    memset(allocation, 0, sizeof(*allocation));
+    if (v->AllocateMemoryFn != nullptr)
+    {
+        bool ok = v->AllocateMemoryFn(&req, properties, allocation, v->MemoryUserData);
+        check_vk_result(ok ? VK_SUCCESS : VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        return;
+    }
+
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
+    alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(properties, req.memoryTypeBits);
+    VkResult err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &allocation->Memory);
+    check_vk_result(err);
+    allocation->Size = alloc_info.allocationSize;
+    allocation->PropertyFlags = properties;
+}
+
+static void ImGui_ImplVulkan_FreeMemory(ImGui_ImplVulkan_MemoryAllocation* allocation)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (allocation->Memory == VK_NULL_HANDLE)
+        return;
+    if (v->FreeMemoryFn != nullptr)
+        v->FreeMemoryFn(allocation, v->MemoryUserData);
+    else
+        vkFreeMemory(v->Device, allocation->Memory, v->Allocator);
+    memset(allocation, 0, sizeof(*allocation));
+}
+
+// Returns the persistent mapping when the allocator provides one, otherwise maps the range.
+static void* ImGui_ImplVulkan_MapMemory(ImGui_ImplVulkan_MemoryAllocation* allocation, VkDeviceSize size)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (allocation->MappedData != nullptr)
+        return allocation->MappedData;
+    void* data = nullptr;
+    VkResult err = vkMapMemory(v->Device, allocation->Memory, allocation->Offset, size, 0, &data);
+    check_vk_result(err);
+    return data;
+}
+
+static void ImGui_ImplVulkan_UnmapMemory(ImGui_ImplVulkan_MemoryAllocation* allocation)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (allocation->MappedData == nullptr)
+        vkUnmapMemory(v->Device, allocation->Memory);
+}
+
+// Fill a flush range for the allocation, returns false when the memory is coherent and needs no flush.
+static bool ImGui_ImplVulkan_GetFlushRange(const ImGui_ImplVulkan_MemoryAllocation* allocation, VkMappedMemoryRange* range)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (allocation->PropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        return false;
+    memset(range, 0, sizeof(*range));
+    range->sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range->memory = allocation->Memory;
+    range->offset = allocation->Offset;
+    range->size = (v->AllocateMemoryFn != nullptr) ? allocation->Size : VK_WHOLE_SIZE; // Sub-allocations are atom aligned, dedicated ones own the whole memory
+    return true;
+}
+
+// Destroy a buffer and its memory, or hand them to the application if it defers destruction until the GPU is done with them.
+static void ImGui_ImplVulkan_ReleaseBuffer(VkBuffer& buffer, ImGui_ImplVulkan_MemoryAllocation* allocation)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (v->ReleaseBufferFn != nullptr && (buffer != VK_NULL_HANDLE || allocation->Memory != VK_NULL_HANDLE))
+    {
+        v->ReleaseBufferFn(buffer, allocation, v->MemoryUserData);
+        memset(allocation, 0, sizeof(*allocation));
+        buffer = VK_NULL_HANDLE;
+        return;
+    }
     if (buffer != VK_NULL_HANDLE)
         vkDestroyBuffer(v->Device, buffer, v->Allocator);
-    if (buffer_memory != VK_NULL_HANDLE)
-        vkFreeMemory(v->Device, buffer_memory, v->Allocator);
+    buffer = VK_NULL_HANDLE;
+    ImGui_ImplVulkan_FreeMemory(allocation);
+}
+
+static void CreateOrResizeBuffer(VkBuffer& buffer, ImGui_ImplVulkan_MemoryAllocation& buffer_memory, VkDeviceSize& buffer_size, size_t new_size, VkBufferUsageFlags usage)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+    ImGui_ImplVulkan_ReleaseBuffer(buffer, &buffer_memory);
 
     VkDeviceSize buffer_size_aligned = AlignBufferSize(IM_MAX(v->MinAllocationSize, new_size), bd->BufferMemoryAlignment);
     VkBufferCreateInfo buffer_info = {};
@@ -416,34 +733,111 @@ static void CreateOrResizeBuffer(VkBuffer& buffer, VkDeviceMemory& buffer_memory
     VkMemoryRequirements req;
     vkGetBufferMemoryRequirements(v->Device, buffer, &req);
     bd->BufferMemoryAlignment = (bd->BufferMemoryAlignment > req.alignment) ? bd->BufferMemoryAlignment : req.alignment;
-    VkMemoryAllocateInfo alloc_info = {};
-    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    alloc_info.allocationSize = req.size;
-    alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, req.memoryTypeBits);
-    err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &buffer_memory);
-    check_vk_result(err);
+    ImGui_ImplVulkan_AllocateMemory(req, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &buffer_memory);
 
-    err = vkBindBufferMemory(v->Device, buffer, buffer_memory, 0);
+    err = vkBindBufferMemory(v->Device, buffer, buffer_memory.Memory, buffer_memory.Offset);
     check_vk_result(err);
     buffer_size = buffer_size_aligned;
 }
 
+static void ImGui_ImplVulkan_DestroyStreamingBuffer(VkDevice device, ImGui_ImplVulkan_StreamingBuffer* sb, const VkAllocationCallbacks* allocator)
+{
+    IM_UNUSED(device);
+    IM_UNUSED(allocator);
+    if (sb->MappedData != nullptr)
+        ImGui_ImplVulkan_UnmapMemory(&sb->Memory);
+    ImGui_ImplVulkan_ReleaseBuffer(sb->Buffer, &sb->Memory);
+    IM_FREE(sb->FrameStart);
+    memset(sb, 0, sizeof(*sb));
+}
+
+// (Re)create the ring buffer. The previous one may still be read by in-flight frames: release it through ReleaseBufferFn, or wait for the device.
+static void ImGui_ImplVulkan_CreateStreamingBuffer(ImGui_ImplVulkan_StreamingBuffer* sb, VkDeviceSize size, uint32_t frame_count)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+    if (sb->Buffer != VK_NULL_HANDLE)
+    {
+        if (v->ReleaseBufferFn == nullptr)
+        {
+            err = vkDeviceWaitIdle(v->Device);
+            check_vk_result(err);
+        }
+        ImGui_ImplVulkan_DestroyStreamingBuffer(v->Device, sb, v->Allocator);
+    }
+
+    VkBufferCreateInfo buffer_info = {};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size = AlignBufferSize(size, IM_MAX(bd->BufferMemoryAlignment, bd->NonCoherentAtomSize));
+    buffer_info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &sb->Buffer);
+    check_vk_result(err);
+
+    // Prefer coherent memory so that uploads don't need vkFlushMappedMemoryRanges() at all
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(v->Device, sb->Buffer, &req);
+    VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if (v->AllocateMemoryFn == nullptr && ImGui_ImplVulkan_MemoryType(properties, req.memoryTypeBits) == 0xFFFFFFFF)
+        properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    ImGui_ImplVulkan_AllocateMemory(req, properties, &sb->Memory);
+    err = vkBindBufferMemory(v->Device, sb->Buffer, sb->Memory.Memory, sb->Memory.Offset);
+    check_vk_result(err);
+
+    sb->MappedData = (char*)ImGui_ImplVulkan_MapMemory(&sb->Memory, buffer_info.size);
+    sb->Size = buffer_info.size;
+    sb->Head = 0;
+    sb->FrameCount = frame_count;
+    sb->FrameStart = (VkDeviceSize*)IM_ALLOC(sizeof(VkDeviceSize) * frame_count);
+    for (uint32_t n = 0; n < frame_count; n++)
+        sb->FrameStart[n] = ~(VkDeviceSize)0;
+}
+
+// Reserve 'size' bytes for in-flight frame 'frame_index'. Returns the offset in the ring or ~0 if it doesn't fit.
+// Reusing 'frame_index' means the GPU is done with it and with every older frame, so the live data starts at
+// the first frame that uploaded something in rotation order after 'frame_index' and ends at Head.
+static VkDeviceSize ImGui_ImplVulkan_StreamingBufferAlloc(ImGui_ImplVulkan_StreamingBuffer* sb, uint32_t frame_index, VkDeviceSize size)
+{
+    const VkDeviceSize invalid = ~(VkDeviceSize)0;
+    sb->FrameStart[frame_index] = invalid;
+
+    VkDeviceSize tail = invalid;
+    for (uint32_t n = 1; n < sb->FrameCount && tail == invalid; n++)
+        tail = sb->FrameStart[(frame_index + n) % sb->FrameCount];
+
+    VkDeviceSize start = invalid;
+    if (tail == invalid)                                // Nothing in flight
+        start = (size <= sb->Size) ? 0 : invalid;
+    else if (sb->Head > tail)                           // Free space is [Head, Size) then [0, tail)
+        start = (sb->Head + size <= sb->Size) ? sb->Head : (size <= tail ? 0 : invalid);
+    else if (sb->Head + size <= tail)                   // Wrapped, free space is [Head, tail)
+        start = sb->Head;
+    if (start == invalid)
+        return invalid;
+
+    sb->FrameStart[frame_index] = start;
+    sb->Head = start + size;
+    return start;
+}
+
 static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline pipeline, VkCommandBuffer command_buffer, ImGui_ImplVulkan_FrameRenderBuffers* rb, int fb_width, int fb_height)
 {
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    VkPipelineLayout pipeline_layout = bd->DrawBindless ? bd->BindlessPipelineLayout : bd->PipelineLayout;
 
     // Bind pipeline:
     {
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     }
 
-    // Bind Vertex And Index Buffer:
+    // Bind Vertex And Index Buffer (and the per-instance data of the bindless pipeline):
     if (draw_data->TotalVtxCount > 0)
     {
-        VkBuffer vertex_buffers[1] = { rb->VertexBuffer };
-        VkDeviceSize vertex_offset[1] = { 0 };
-        vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, vertex_offset);
-        vkCmdBindIndexBuffer(command_buffer, rb->IndexBuffer, 0, sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+        VkBuffer vertex_buffers[2] = { rb->DrawVertexBuffer, rb->IndirectBuffer };
+        VkDeviceSize vertex_offset[2] = { rb->DrawVertexOffset, rb->DrawInstanceOffset };
+        vkCmdBindVertexBuffers(command_buffer, 0, bd->DrawBindless ? 2 : 1, vertex_buffers, vertex_offset);
+        vkCmdBindIndexBuffer(command_buffer, rb->DrawIndexBuffer, rb->DrawIndexOffset, sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
     }
 
     // Setup viewport:
@@ -467,24 +861,106 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline
         float translate[2];
         translate[0] = -1.0f - draw_data->DisplayPos.x * scale[0];
         translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
-        vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
-        vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
+        vkCmdPushConstants(command_buffer, pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
+        vkCmdPushConstants(command_buffer, pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
+    }
+
+    // Bindless: the texture array is bound once and clipping is done in the vertex shader, so the scissor covers the framebuffer
+    if (bd->DrawBindless)
+    {
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &bd->BindlessDescriptorSet, 0, nullptr);
+        VkRect2D scissor = { { 0, 0 }, { (uint32_t)fb_width, (uint32_t)fb_height } };
+        vkCmdSetScissor(command_buffer, 0, 1, &scissor);
     }
 }
 
+// Key of a descriptor set in ImGui_ImplVulkan_Data::BindlessSlots. Collisions are resolved by ImGui_ImplVulkan_BindlessSlot().
+static ImGuiID ImGui_ImplVulkan_BindlessKey(VkDescriptorSet descriptor_set)
+{
+    ImU64 handle = (ImU64)descriptor_set;
+    return (ImGuiID)(handle ^ (handle >> 32));
+}
+
+// Slot of a texture registered with ImGui_ImplVulkan_AddTexture() in the bindless texture array, or -1
+static int ImGui_ImplVulkan_BindlessSlot(VkDescriptorSet descriptor_set)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    int slot = bd->BindlessSlots.GetInt(ImGui_ImplVulkan_BindlessKey(descriptor_set)) - 1;
+    if (slot >= 0 && bd->BindlessTextures[slot] == descriptor_set)
+        return slot;
+    return bd->BindlessTextures.find_index(descriptor_set);
+}
+
+// Same clipping test as the scissor path of ImGui_ImplVulkan_RecordDrawLists()
+static bool ImGui_ImplVulkan_IsCmdVisible(ImDrawData* draw_data, const ImDrawCmd* pcmd, int fb_width, int fb_height)
+{
+    ImVec2 clip_off = draw_data->DisplayPos;
+    ImVec2 clip_scale = draw_data->FramebufferScale;
+    ImVec2 clip_min(IM_MAX((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, 0.0f), IM_MAX((pcmd->ClipRect.y - clip_off.y) * clip_scale.y, 0.0f));
+    ImVec2 clip_max(IM_MIN((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (float)fb_width), IM_MIN((pcmd->ClipRect.w - clip_off.y) * clip_scale.y, (float)fb_height));
+    return clip_max.x > clip_min.x && clip_max.y > clip_min.y;
+}
+
 // Render function
 void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline)
+{
+    if (!ImGui_ImplVulkan_BeginDrawData(draw_data, pipeline))
+        return;
+    ImGui_ImplVulkan_UploadDrawLists(draw_data, 0, draw_data->CmdListsCount);
+    ImGui_ImplVulkan_EndUpload(draw_data);
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    bd->RenderStats = ImGui_ImplVulkan_RenderStats();
+    ImGui_ImplVulkan_RecordDrawLists(draw_data, command_buffer, 0, draw_data->CmdListsCount, &bd->RenderStats);
+
+    // Note: at this point both vkCmdSetViewport() and vkCmdSetScissor() have been called.
+    // Our last values will leak into user/application rendering IF:
+    // - Your app uses a pipeline with VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR dynamic state
+    // - And you forgot to call vkCmdSetViewport() and vkCmdSetScissor() yourself to explicitly set that state.
+    // If you use VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR you are responsible for setting the values before rendering.
+    // In theory we should aim to backup/restore those values but I am not sure this is possible.
+    // We perform a call to vkCmdSetScissor() to set back a full viewport which is likely to fix things for 99% users but technically this is not perfect. (See github #4644)
+    VkRect2D scissor = { { 0, 0 }, { (uint32_t)bd->DrawFbWidth, (uint32_t)bd->DrawFbHeight } };
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+}
+
+bool ImGui_ImplVulkan_BeginDrawData(ImDrawData* draw_data, VkPipeline pipeline)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
     int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
     int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
     if (fb_width <= 0 || fb_height <= 0)
-        return;
+        return false;
 
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
-    if (pipeline == VK_NULL_HANDLE)
-        pipeline = bd->Pipeline;
+    bd->DrawBindless = v->UseBindless && bd->BindlessPipeline != VK_NULL_HANDLE && pipeline == VK_NULL_HANDLE; // A custom pipeline is built for the classic layout
+    bd->DrawPipeline = bd->DrawBindless ? bd->BindlessPipeline : (pipeline != VK_NULL_HANDLE) ? pipeline : bd->Pipeline;
+    bd->DrawFbWidth = fb_width;
+    bd->DrawFbHeight = fb_height;
+    bd->UploadVtxDst = nullptr;
+    bd->UploadIdxDst = nullptr;
+    bd->UploadIndirectDst = nullptr;
+    bd->UploadInstanceDst = nullptr;
+    bd->DrawStateTracking = v->UseStateTracking;
+    bd->DrawRebasedIndices = v->UseStateTracking && (sizeof(ImDrawIdx) == 4 || draw_data->TotalVtxCount <= 0x10000);
+
+    // Where each list starts in the merged buffers
+    bd->ListVtxOffsets.resize(draw_data->CmdListsCount + 1);
+    bd->ListIdxOffsets.resize(draw_data->CmdListsCount + 1);
+    bd->ListVtxOffsets[0] = 0;
+    bd->ListIdxOffsets[0] = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        bd->ListVtxOffsets[n + 1] = bd->ListVtxOffsets[n] + draw_data->CmdLists[n]->VtxBuffer.Size;
+        bd->ListIdxOffsets[n + 1] = bd->ListIdxOffsets[n] + draw_data->CmdLists[n]->IdxBuffer.Size;
+    }
+    if (bd->DrawBindless)
+    {
+        bd->ListCmdOffsets.resize(draw_data->CmdListsCount + 1);
+        bd->ListCmdOffsets[0] = 0;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            bd->ListCmdOffsets[n + 1] = bd->ListCmdOffsets[n] + draw_data->CmdLists[n]->CmdBuffer.Size;
+    }
 
     // Allocate array to store enough vertex/index buffers
     ImGui_ImplVulkan_WindowRenderBuffers* wrb = &bd->MainWindowRenderBuffers;
@@ -498,8 +974,53 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     IM_ASSERT(wrb->Count == v->ImageCount);
     wrb->Index = (wrb->Index + 1) % wrb->Count;
     ImGui_ImplVulkan_FrameRenderBuffers* rb = &wrb->FrameRenderBuffers[wrb->Index];
+    bd->DrawRenderBuffers = rb;
 
-    if (draw_data->TotalVtxCount > 0)
+    // Reusing the buffers of a frame means the GPU is done with it: so is every frame up to FrameSerial - Count, with the slots they sampled
+    bd->FrameSerial++;
+    for (int n = 0; n < bd->BindlessRetiredSlots.Size; )
+    {
+        if (bd->FrameSerial >= bd->BindlessRetiredSlots[n].RetireFrame + wrb->Count)
+        {
+            bd->BindlessFreeSlots.push_back(bd->BindlessRetiredSlots[n].Slot);
+            bd->BindlessRetiredSlots.erase_unsorted(bd->BindlessRetiredSlots.Data + n);
+        }
+        else
+            n++;
+    }
+
+    if (draw_data->TotalVtxCount > 0 && v->UseStreamingBuffer)
+    {
+        // One bump allocation in the ring holds both vertices and indices of this frame
+        ImGui_ImplVulkan_StreamingBuffer* sb = &bd->StreamingBuffer;
+        VkDeviceSize vertex_size = AlignBufferSize(draw_data->TotalVtxCount * sizeof(ImDrawVert), bd->BufferMemoryAlignment);
+        VkDeviceSize index_size = AlignBufferSize(draw_data->TotalIdxCount * sizeof(ImDrawIdx), bd->BufferMemoryAlignment);
+        VkDeviceSize frame_size = AlignBufferSize(vertex_size + index_size, IM_MAX(bd->BufferMemoryAlignment, bd->NonCoherentAtomSize));
+        if (sb->Buffer == VK_NULL_HANDLE || sb->FrameCount != wrb->Count)
+            ImGui_ImplVulkan_CreateStreamingBuffer(sb, IM_MAX(v->StreamingBufferSize ? v->StreamingBufferSize : 4 * 1024 * 1024, frame_size * wrb->Count), wrb->Count);
+        VkDeviceSize frame_offset = ImGui_ImplVulkan_StreamingBufferAlloc(sb, wrb->Index, frame_size);
+        if (frame_offset == ~(VkDeviceSize)0)
+        {
+            ImGui_ImplVulkan_CreateStreamingBuffer(sb, IM_MAX(sb->Size * 2, frame_size * wrb->Count), wrb->Count);
+            frame_offset = ImGui_ImplVulkan_StreamingBufferAlloc(sb, wrb->Index, frame_size);
+        }
+        IM_ASSERT(frame_offset != ~(VkDeviceSize)0);
+
+        // Vertices and indices are written side by side
+        bd->UploadVtxDst = (ImDrawVert*)(sb->MappedData + frame_offset);
+        bd->UploadIdxDst = (ImDrawIdx*)(sb->MappedData + frame_offset + vertex_size);
+
+        rb->DrawVertexBuffer = sb->Buffer;
+        rb->DrawVertexOffset = frame_offset;
+        rb->DrawIndexBuffer = sb->Buffer;
+        rb->DrawIndexOffset = frame_offset + vertex_size;
+    }
+    else if (v->UseStreamingBuffer && bd->StreamingBuffer.FrameStart != nullptr && wrb->Index < bd->StreamingBuffer.FrameCount)
+    {
+        // Empty frame: release its previous slice of the ring
+        bd->StreamingBuffer.FrameStart[wrb->Index] = ~(VkDeviceSize)0;
+    }
+    else if (draw_data->TotalVtxCount > 0)
     {
         // Create or resize the vertex/index buffers
         size_t vertex_size = AlignBufferSize(draw_data->TotalVtxCount * sizeof(ImDrawVert), bd->BufferMemoryAlignment);
@@ -509,53 +1030,281 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         if (rb->IndexBuffer == VK_NULL_HANDLE || rb->IndexBufferSize < index_size)
             CreateOrResizeBuffer(rb->IndexBuffer, rb->IndexBufferMemory, rb->IndexBufferSize, index_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
 
-        // Upload vertex/index data into a single contiguous GPU buffer
-        ImDrawVert* vtx_dst = nullptr;
-        ImDrawIdx* idx_dst = nullptr;
-        VkResult err = vkMapMemory(v->Device, rb->VertexBufferMemory, 0, vertex_size, 0, (void**)&vtx_dst);
-        check_vk_result(err);
-        err = vkMapMemory(v->Device, rb->IndexBufferMemory, 0, index_size, 0, (void**)&idx_dst);
-        check_vk_result(err);
-        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        // Upload vertex/index data into a single contiguous GPU buffer, unmapped in ImGui_ImplVulkan_EndUpload()
+        bd->UploadVtxDst = (ImDrawVert*)ImGui_ImplVulkan_MapMemory(&rb->VertexBufferMemory, vertex_size);
+        bd->UploadIdxDst = (ImDrawIdx*)ImGui_ImplVulkan_MapMemory(&rb->IndexBufferMemory, index_size);
+
+        rb->DrawVertexBuffer = rb->VertexBuffer;
+        rb->DrawVertexOffset = 0;
+        rb->DrawIndexBuffer = rb->IndexBuffer;
+        rb->DrawIndexOffset = 0;
+    }
+
+    if (bd->DrawBindless && bd->UploadVtxDst != nullptr)
+    {
+        // Indirect commands of the frame, then the instance data they select, both written by ImGui_ImplVulkan_UploadDrawLists()
+        const int cmd_count = bd->ListCmdOffsets[draw_data->CmdListsCount];
+        VkDeviceSize indirect_size = AlignBufferSize(cmd_count * sizeof(VkDrawIndexedIndirectCommand), bd->BufferMemoryAlignment);
+        VkDeviceSize instance_size = AlignBufferSize(cmd_count * sizeof(ImGui_ImplVulkan_BindlessInstance), bd->BufferMemoryAlignment);
+        if (rb->IndirectBuffer == VK_NULL_HANDLE || rb->IndirectBufferSize < indirect_size + instance_size)
+            CreateOrResizeBuffer(rb->IndirectBuffer, rb->IndirectBufferMemory, rb->IndirectBufferSize, indirect_size + instance_size, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        char* indirect_dst = (char*)ImGui_ImplVulkan_MapMemory(&rb->IndirectBufferMemory, indirect_size + instance_size);
+        bd->UploadIndirectDst = (VkDrawIndexedIndirectCommand*)indirect_dst;
+        bd->UploadInstanceDst = (ImGui_ImplVulkan_BindlessInstance*)(indirect_dst + indirect_size);
+        rb->DrawInstanceOffset = indirect_size;
+    }
+    return true;
+}
+
+// Bindless: one indirect command and one instance per ImDrawCmd of list 'n'. Callbacks and fully clipped commands get an empty draw.
+static void ImGui_ImplVulkan_UploadIndirectCommands(ImDrawData* draw_data, int n)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    const ImDrawList* cmd_list = draw_data->CmdLists[n];
+    const int first_cmd = bd->ListCmdOffsets[n];
+    VkDrawIndexedIndirectCommand* indirect_dst = bd->UploadIndirectDst + first_cmd;
+    ImGui_ImplVulkan_BindlessInstance* instance_dst = bd->UploadInstanceDst + first_cmd;
+    for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+    {
+        const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+        const bool visible = pcmd->UserCallback == nullptr && ImGui_ImplVulkan_IsCmdVisible(draw_data, pcmd, bd->DrawFbWidth, bd->DrawFbHeight);
+        VkDrawIndexedIndirectCommand* command = &indirect_dst[cmd_i];
+        command->indexCount = visible ? pcmd->ElemCount : 0;
+        command->instanceCount = 1;
+        command->firstIndex = pcmd->IdxOffset + bd->ListIdxOffsets[n];
+        command->vertexOffset = bd->DrawRebasedIndices ? 0 : (int32_t)(pcmd->VtxOffset + bd->ListVtxOffsets[n]);
+        command->firstInstance = (uint32_t)(first_cmd + cmd_i);
+
+        int slot = 0;
+        if (visible)
         {
-            const ImDrawList* cmd_list = draw_data->CmdLists[n];
-            memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
-            memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-            vtx_dst += cmd_list->VtxBuffer.Size;
-            idx_dst += cmd_list->IdxBuffer.Size;
+            VkDescriptorSet desc_set = (sizeof(ImTextureID) < sizeof(ImU64)) ? bd->FontDescriptorSet : (VkDescriptorSet)pcmd->TextureId;
+            slot = ImGui_ImplVulkan_BindlessSlot(desc_set);
+            IM_ASSERT(slot >= 0 && "Bindless rendering only supports textures registered with ImGui_ImplVulkan_AddTexture()");
         }
-        VkMappedMemoryRange range[2] = {};
-        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        range[0].memory = rb->VertexBufferMemory;
-        range[0].size = VK_WHOLE_SIZE;
-        range[1].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        range[1].memory = rb->IndexBufferMemory;
-        range[1].size = VK_WHOLE_SIZE;
-        err = vkFlushMappedMemoryRanges(v->Device, 2, range);
+        instance_dst[cmd_i].ClipRect = pcmd->ClipRect;
+        instance_dst[cmd_i].Texture = (uint32_t)IM_MAX(slot, 0);
+    }
+}
+
+void ImGui_ImplVulkan_UploadDrawLists(ImDrawData* draw_data, int list_begin, int list_end)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (bd->UploadVtxDst == nullptr)
+        return;
+    for (int n = list_begin; n < list_end; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(bd->UploadVtxDst + bd->ListVtxOffsets[n], cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        if (bd->UploadIndirectDst != nullptr)
+            ImGui_ImplVulkan_UploadIndirectCommands(draw_data, n);
+        if (!bd->DrawRebasedIndices || (bd->ListVtxOffsets[n] == 0 && cmd_list->VtxBuffer.Size <= 0x10000))
+        {
+            // First list or no rebasing: indices are already relative to the right vertex (VtxOffset is only used by lists above 64K vertices)
+            memcpy(bd->UploadIdxDst + bd->ListIdxOffsets[n], cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            continue;
+        }
+
+        // Rebase indices of each command on the merged vertex buffer, so draws of different lists can be merged
+        ImDrawIdx* idx_dst = bd->UploadIdxDst + bd->ListIdxOffsets[n];
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer)
+        {
+            if (cmd.UserCallback != nullptr)
+                continue;
+            const ImDrawIdx base = (ImDrawIdx)(bd->ListVtxOffsets[n] + cmd.VtxOffset);
+            const ImDrawIdx* src = cmd_list->IdxBuffer.Data + cmd.IdxOffset;
+            ImDrawIdx* dst = idx_dst + cmd.IdxOffset;
+            for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                dst[i] = (ImDrawIdx)(src[i] + base);
+        }
+    }
+}
+
+void ImGui_ImplVulkan_EndUpload(ImDrawData* draw_data)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (bd->UploadVtxDst == nullptr)
+        return;
+    bd->UploadVtxDst = nullptr;
+    bd->UploadIdxDst = nullptr;
+
+    ImGui_ImplVulkan_FrameRenderBuffers* rb = bd->DrawRenderBuffers;
+    if (bd->UploadIndirectDst != nullptr)
+    {
+        bd->UploadIndirectDst = nullptr;
+        bd->UploadInstanceDst = nullptr;
+        VkMappedMemoryRange range = {};
+        if (ImGui_ImplVulkan_GetFlushRange(&rb->IndirectBufferMemory, &range))
+        {
+            VkResult err = vkFlushMappedMemoryRanges(v->Device, 1, &range);
+            check_vk_result(err);
+        }
+        ImGui_ImplVulkan_UnmapMemory(&rb->IndirectBufferMemory);
+    }
+
+    if (v->UseStreamingBuffer)
+    {
+        ImGui_ImplVulkan_StreamingBuffer* sb = &bd->StreamingBuffer;
+        VkMappedMemoryRange range = {};
+        if (ImGui_ImplVulkan_GetFlushRange(&sb->Memory, &range))
+        {
+            VkDeviceSize vertex_size = AlignBufferSize(draw_data->TotalVtxCount * sizeof(ImDrawVert), bd->BufferMemoryAlignment);
+            VkDeviceSize index_size = AlignBufferSize(draw_data->TotalIdxCount * sizeof(ImDrawIdx), bd->BufferMemoryAlignment);
+            range.offset = sb->Memory.Offset + rb->DrawVertexOffset;
+            range.size = AlignBufferSize(vertex_size + index_size, IM_MAX(bd->BufferMemoryAlignment, bd->NonCoherentAtomSize));
+            VkResult err = vkFlushMappedMemoryRanges(v->Device, 1, &range);
+            check_vk_result(err);
+        }
+        return;
+    }
+
+    VkMappedMemoryRange range[2] = {};
+    uint32_t range_count = 0;
+    if (ImGui_ImplVulkan_GetFlushRange(&rb->VertexBufferMemory, &range[range_count]))
+        range_count++;
+    if (ImGui_ImplVulkan_GetFlushRange(&rb->IndexBufferMemory, &range[range_count]))
+        range_count++;
+    if (range_count > 0)
+    {
+        VkResult err = vkFlushMappedMemoryRanges(v->Device, range_count, range);
         check_vk_result(err);
-        vkUnmapMemory(v->Device, rb->VertexBufferMemory);
-        vkUnmapMemory(v->Device, rb->IndexBufferMemory);
     }
+    ImGui_ImplVulkan_UnmapMemory(&rb->VertexBufferMemory);
+    ImGui_ImplVulkan_UnmapMemory(&rb->IndexBufferMemory);
+}
+
+static void ImGui_ImplVulkan_AddRenderStats(ImGui_ImplVulkan_RenderStats* dst, const ImGui_ImplVulkan_RenderStats& src)
+{
+    dst->DrawCommands += src.DrawCommands;
+    dst->DrawCalls += src.DrawCalls;
+    dst->ScissorsSet += src.ScissorsSet;
+    dst->ScissorsSkipped += src.ScissorsSkipped;
+    dst->DescriptorSetsBound += src.DescriptorSetsBound;
+    dst->DescriptorSetsSkipped += src.DescriptorSetsSkipped;
+}
+
+// Pending vkCmdDrawIndexed(), extended while the next command continues it with the same state
+struct ImGui_ImplVulkan_PendingDraw
+{
+    uint32_t    IndexCount;
+    uint32_t    FirstIndex;
+    int32_t     VertexOffset;
+};
+
+static void ImGui_ImplVulkan_FlushDraw(VkCommandBuffer command_buffer, ImGui_ImplVulkan_PendingDraw* draw, ImGui_ImplVulkan_RenderStats* stats)
+{
+    if (draw->IndexCount == 0)
+        return;
+    vkCmdDrawIndexed(command_buffer, draw->IndexCount, 1, draw->FirstIndex, draw->VertexOffset, 0);
+    stats->DrawCalls++;
+    draw->IndexCount = 0;
+}
+
+// Bindless: indirect commands [cmd_begin, cmd_end) in as few vkCmdDrawIndexedIndirect() as maxDrawIndirectCount allows
+static void ImGui_ImplVulkan_DrawIndirect(VkCommandBuffer command_buffer, int cmd_begin, int cmd_end, ImGui_ImplVulkan_RenderStats* stats)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    while (cmd_begin < cmd_end)
+    {
+        const uint32_t draw_count = IM_MIN((uint32_t)(cmd_end - cmd_begin), bd->MaxDrawIndirectCount);
+        vkCmdDrawIndexedIndirect(command_buffer, bd->DrawRenderBuffers->IndirectBuffer, cmd_begin * sizeof(VkDrawIndexedIndirectCommand), draw_count, sizeof(VkDrawIndexedIndirectCommand));
+        stats->DrawCalls++;
+        cmd_begin += (int)draw_count;
+    }
+}
+
+// Bindless: every run of commands between user callbacks is one indirect draw, texture and clip rectangle come from the instance data
+static void ImGui_ImplVulkan_RecordDrawListsIndirect(ImDrawData* draw_data, VkCommandBuffer command_buffer, int list_begin, int list_end, ImGui_ImplVulkan_RenderStats* stats)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_SetupRenderState(draw_data, bd->DrawPipeline, command_buffer, bd->DrawRenderBuffers, bd->DrawFbWidth, bd->DrawFbHeight);
+    stats->ScissorsSet++;
+    stats->DescriptorSetsBound++;
+
+    int run_begin = bd->ListCmdOffsets[list_begin];
+    int run_visible = 0;
+    for (int n = list_begin; n < list_end; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback == nullptr)
+            {
+                if (pcmd->ElemCount > 0 && ImGui_ImplVulkan_IsCmdVisible(draw_data, pcmd, bd->DrawFbWidth, bd->DrawFbHeight))
+                    run_visible++;
+                continue;
+            }
+
+            const int cmd_index = bd->ListCmdOffsets[n] + cmd_i;
+            if (run_visible > 0)
+                ImGui_ImplVulkan_DrawIndirect(command_buffer, run_begin, cmd_index, stats);
+            stats->DrawCommands += run_visible;
+            run_begin = cmd_index + 1;
+            run_visible = 0;
+
+            // A user callback may change any state, restore ours after every one of them
+            if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                pcmd->UserCallback(cmd_list, pcmd);
+            ImGui_ImplVulkan_SetupRenderState(draw_data, bd->DrawPipeline, command_buffer, bd->DrawRenderBuffers, bd->DrawFbWidth, bd->DrawFbHeight);
+            stats->ScissorsSet++;
+            stats->DescriptorSetsBound++;
+        }
+    }
+    if (run_visible > 0)
+        ImGui_ImplVulkan_DrawIndirect(command_buffer, run_begin, bd->ListCmdOffsets[list_end], stats);
+    stats->DrawCommands += run_visible;
+}
+
+void ImGui_ImplVulkan_RecordDrawLists(ImDrawData* draw_data, VkCommandBuffer command_buffer, int list_begin, int list_end, ImGui_ImplVulkan_RenderStats* out_stats)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_RenderStats stats = {};
+    if (bd->DrawBindless)
+    {
+        ImGui_ImplVulkan_RecordDrawListsIndirect(draw_data, command_buffer, list_begin, list_end, &stats);
+        if (out_stats != nullptr)
+            ImGui_ImplVulkan_AddRenderStats(out_stats, stats);
+        return;
+    }
+
+    ImGui_ImplVulkan_FrameRenderBuffers* rb = bd->DrawRenderBuffers;
+    VkPipeline pipeline = bd->DrawPipeline;
+    int fb_width = bd->DrawFbWidth;
+    int fb_height = bd->DrawFbHeight;
+    const bool state_tracking = bd->DrawStateTracking;
+    const bool rebased_indices = bd->DrawRebasedIndices;
 
     // Setup desired Vulkan state
     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
 
+    // State bound in this command buffer. Unknown after a user callback.
+    ImGui_ImplVulkan_PendingDraw pending = {};
+    VkRect2D bound_scissor = {};
+    bool scissor_bound = false;
+    VkDescriptorSet bound_desc_set = VK_NULL_HANDLE;
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    int global_vtx_offset = 0;
-    int global_idx_offset = 0;
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    for (int n = list_begin; n < list_end; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        int global_vtx_offset = bd->ListVtxOffsets[n];
+        int global_idx_offset = bd->ListIdxOffsets[n];
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
             if (pcmd->UserCallback != nullptr)
             {
+                ImGui_ImplVulkan_FlushDraw(command_buffer, &pending, &stats);
+                scissor_bound = false;
+                bound_desc_set = VK_NULL_HANDLE;
+
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
@@ -576,42 +1325,78 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 if (clip_max.y > fb_height) { clip_max.y = (float)fb_height; }
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
+                stats.DrawCommands++;
 
-                // Apply scissor/clipping rectangle
                 VkRect2D scissor;
                 scissor.offset.x = (int32_t)(clip_min.x);
                 scissor.offset.y = (int32_t)(clip_min.y);
                 scissor.extent.width = (uint32_t)(clip_max.x - clip_min.x);
                 scissor.extent.height = (uint32_t)(clip_max.y - clip_min.y);
-                vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-                // Bind DescriptorSet with font or user texture
-                VkDescriptorSet desc_set[1] = { (VkDescriptorSet)pcmd->TextureId };
+                VkDescriptorSet desc_set = (VkDescriptorSet)pcmd->TextureId;
                 if (sizeof(ImTextureID) < sizeof(ImU64))
                 {
                     // We don't support texture switches if ImTextureID hasn't been redefined to be 64-bit. Do a flaky check that other textures haven't been used.
                     IM_ASSERT(pcmd->TextureId == (ImTextureID)bd->FontDescriptorSet);
-                    desc_set[0] = bd->FontDescriptorSet;
+                    desc_set = bd->FontDescriptorSet;
+                }
+
+                const uint32_t first_index = pcmd->IdxOffset + global_idx_offset;
+                const int32_t vertex_offset = rebased_indices ? 0 : (int32_t)(pcmd->VtxOffset + global_vtx_offset);
+                if (!state_tracking)
+                {
+                    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+                    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, &desc_set, 0, nullptr);
+                    vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, first_index, vertex_offset, 0);
+                    stats.ScissorsSet++;
+                    stats.DescriptorSetsBound++;
+                    stats.DrawCalls++;
+                    continue;
                 }
-                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, desc_set, 0, nullptr);
 
-                // Draw
-                vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+                // Apply scissor/clipping rectangle and texture only when they change
+                const bool same_scissor = scissor_bound && memcmp(&scissor, &bound_scissor, sizeof(scissor)) == 0;
+                const bool same_desc_set = desc_set == bound_desc_set;
+                if (same_scissor && same_desc_set && pending.IndexCount > 0 && pending.FirstIndex + pending.IndexCount == first_index && pending.VertexOffset == vertex_offset)
+                {
+                    // Continues the pending draw in the index buffer
+                    pending.IndexCount += pcmd->ElemCount;
+                    stats.ScissorsSkipped++;
+                    stats.DescriptorSetsSkipped++;
+                    continue;
+                }
+                ImGui_ImplVulkan_FlushDraw(command_buffer, &pending, &stats);
+                if (same_scissor)
+                {
+                    stats.ScissorsSkipped++;
+                }
+                else
+                {
+                    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+                    bound_scissor = scissor;
+                    scissor_bound = true;
+                    stats.ScissorsSet++;
+                }
+                if (same_desc_set)
+                {
+                    stats.DescriptorSetsSkipped++;
+                }
+                else
+                {
+                    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, &desc_set, 0, nullptr);
+                    bound_desc_set = desc_set;
+                    stats.DescriptorSetsBound++;
+                }
+                pending.IndexCount = pcmd->ElemCount;
+                pending.FirstIndex = first_index;
+                pending.VertexOffset = vertex_offset;
             }
         }
-        global_idx_offset += cmd_list->IdxBuffer.Size;
-        global_vtx_offset += cmd_list->VtxBuffer.Size;
     }
+    ImGui_ImplVulkan_FlushDraw(command_buffer, &pending, &stats);
 
-    // Note: at this point both vkCmdSetViewport() and vkCmdSetScissor() have been called.
-    // Our last values will leak into user/application rendering IF:
-    // - Your app uses a pipeline with VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR dynamic state
-    // - And you forgot to call vkCmdSetViewport() and vkCmdSetScissor() yourself to explicitly set that state.
-    // If you use VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR you are responsible for setting the values before rendering.
-    // In theory we should aim to backup/restore those values but I am not sure this is possible.
-    // We perform a call to vkCmdSetScissor() to set back a full viewport which is likely to fix things for 99% users but technically this is not perfect. (See github #4644)
-    VkRect2D scissor = { { 0, 0 }, { (uint32_t)fb_width, (uint32_t)fb_height } };
-    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+    if (out_stats != nullptr)
+        ImGui_ImplVulkan_AddRenderStats(out_stats, stats);
 }
 
 bool ImGui_ImplVulkan_CreateFontsTexture()
@@ -622,14 +1407,19 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     VkResult err;
 
     // Destroy existing texture (if any)
-    if (bd->FontView || bd->FontImage || bd->FontMemory || bd->FontDescriptorSet)
+    // With an external upload the previous copy may still run on another queue, so wait for the whole device (font rebuilds are rare).
+    const bool external_upload = (v->UploadTextureFn != nullptr);
+    if (bd->FontView || bd->FontImage || bd->FontMemory.Memory || bd->FontDescriptorSet)
     {
-        vkQueueWaitIdle(v->Queue);
+        if (external_upload)
+            vkDeviceWaitIdle(v->Device);
+        else
+            vkQueueWaitIdle(v->Queue);
         ImGui_ImplVulkan_DestroyFontsTexture();
     }
 
-    // Create command pool/buffer
-    if (bd->FontCommandPool == VK_NULL_HANDLE)
+    // Create command pool/buffer (not needed when the upload is done by the application)
+    if (bd->FontCommandPool == VK_NULL_HANDLE && !external_upload)
     {
         VkCommandPoolCreateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -637,7 +1427,7 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
         info.queueFamilyIndex = v->QueueFamily;
         vkCreateCommandPool(v->Device, &info, v->Allocator, &bd->FontCommandPool);
     }
-    if (bd->FontCommandBuffer == VK_NULL_HANDLE)
+    if (bd->FontCommandBuffer == VK_NULL_HANDLE && !external_upload)
     {
         VkCommandBufferAllocateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -648,6 +1438,7 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     }
 
     // Start command buffer
+    if (!external_upload)
     {
         err = vkResetCommandPool(v->Device, bd->FontCommandPool, 0);
         check_vk_result(err);
@@ -679,17 +1470,20 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
         info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        const uint32_t queue_families[2] = { v->QueueFamily, v->UploadQueueFamily };
+        if (external_upload && v->UploadQueueFamily != v->QueueFamily)
+        {
+            // Written by the upload queue, sampled by the graphics queue: no ownership transfer needed
+            info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            info.queueFamilyIndexCount = 2;
+            info.pQueueFamilyIndices = queue_families;
+        }
         err = vkCreateImage(v->Device, &info, v->Allocator, &bd->FontImage);
         check_vk_result(err);
         VkMemoryRequirements req;
         vkGetImageMemoryRequirements(v->Device, bd->FontImage, &req);
-        VkMemoryAllocateInfo alloc_info = {};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
-        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
-        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &bd->FontMemory);
-        check_vk_result(err);
-        err = vkBindImageMemory(v->Device, bd->FontImage, bd->FontMemory, 0);
+        ImGui_ImplVulkan_AllocateMemory(req, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &bd->FontMemory);
+        err = vkBindImageMemory(v->Device, bd->FontImage, bd->FontMemory.Memory, bd->FontMemory.Offset);
         check_vk_result(err);
     }
 
@@ -710,8 +1504,20 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     // Create the Descriptor Set:
     bd->FontDescriptorSet = (VkDescriptorSet)ImGui_ImplVulkan_AddTexture(bd->FontSampler, bd->FontView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
+    // Let the application upload the pixels, it owns staging memory, queue and synchronization
+    if (external_upload)
+    {
+        if (!v->UploadTextureFn(bd->FontImage, (uint32_t)width, (uint32_t)height, pixels, upload_size, v->UploadUserData))
+        {
+            ImGui_ImplVulkan_DestroyFontsTexture();
+            return false;
+        }
+        io.Fonts->SetTexID((ImTextureID)bd->FontDescriptorSet);
+        return true;
+    }
+
     // Create the Upload Buffer:
-    VkDeviceMemory upload_buffer_memory;
+    ImGui_ImplVulkan_MemoryAllocation upload_buffer_memory;
     VkBuffer upload_buffer;
     {
         VkBufferCreateInfo buffer_info = {};
@@ -724,29 +1530,22 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
         VkMemoryRequirements req;
         vkGetBufferMemoryRequirements(v->Device, upload_buffer, &req);
         bd->BufferMemoryAlignment = (bd->BufferMemoryAlignment > req.alignment) ? bd->BufferMemoryAlignment : req.alignment;
-        VkMemoryAllocateInfo alloc_info = {};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
-        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, req.memoryTypeBits);
-        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &upload_buffer_memory);
-        check_vk_result(err);
-        err = vkBindBufferMemory(v->Device, upload_buffer, upload_buffer_memory, 0);
+        ImGui_ImplVulkan_AllocateMemory(req, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &upload_buffer_memory);
+        err = vkBindBufferMemory(v->Device, upload_buffer, upload_buffer_memory.Memory, upload_buffer_memory.Offset);
         check_vk_result(err);
     }
 
     // Upload to Buffer:
     {
-        char* map = nullptr;
-        err = vkMapMemory(v->Device, upload_buffer_memory, 0, upload_size, 0, (void**)(&map));
-        check_vk_result(err);
+        char* map = (char*)ImGui_ImplVulkan_MapMemory(&upload_buffer_memory, upload_size);
         memcpy(map, pixels, upload_size);
         VkMappedMemoryRange range[1] = {};
-        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        range[0].memory = upload_buffer_memory;
-        range[0].size = upload_size;
-        err = vkFlushMappedMemoryRanges(v->Device, 1, range);
-        check_vk_result(err);
-        vkUnmapMemory(v->Device, upload_buffer_memory);
+        if (ImGui_ImplVulkan_GetFlushRange(&upload_buffer_memory, &range[0]))
+        {
+            err = vkFlushMappedMemoryRanges(v->Device, 1, range);
+            check_vk_result(err);
+        }
+        ImGui_ImplVulkan_UnmapMemory(&upload_buffer_memory);
     }
 
     // Copy to Image:
@@ -804,7 +1603,7 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     check_vk_result(err);
 
     vkDestroyBuffer(v->Device, upload_buffer, v->Allocator);
-    vkFreeMemory(v->Device, upload_buffer_memory, v->Allocator);
+    ImGui_ImplVulkan_FreeMemory(&upload_buffer_memory);
 
     return true;
 }
@@ -825,7 +1624,7 @@ void ImGui_ImplVulkan_DestroyFontsTexture()
 
     if (bd->FontView)   { vkDestroyImageView(v->Device, bd->FontView, v->Allocator); bd->FontView = VK_NULL_HANDLE; }
     if (bd->FontImage)  { vkDestroyImage(v->Device, bd->FontImage, v->Allocator); bd->FontImage = VK_NULL_HANDLE; }
-    if (bd->FontMemory) { vkFreeMemory(v->Device, bd->FontMemory, v->Allocator); bd->FontMemory = VK_NULL_HANDLE; }
+    if (bd->FontMemory.Memory) { ImGui_ImplVulkan_FreeMemory(&bd->FontMemory); }
 }
 
 static void ImGui_ImplVulkan_CreateShaderModules(VkDevice device, const VkAllocationCallbacks* allocator)
@@ -850,9 +1649,28 @@ static void ImGui_ImplVulkan_CreateShaderModules(VkDevice device, const VkAlloca
         VkResult err = vkCreateShaderModule(device, &frag_info, allocator, &bd->ShaderModuleFrag);
         check_vk_result(err);
     }
+    if (bd->VulkanInitInfo.UseBindless && bd->BindlessShaderModuleVert == VK_NULL_HANDLE)
+    {
+        VkShaderModuleCreateInfo vert_info = {};
+        vert_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        vert_info.codeSize = sizeof(__glsl_shader_vert_bindless_spv);
+        vert_info.pCode = (uint32_t*)__glsl_shader_vert_bindless_spv;
+        VkResult err = vkCreateShaderModule(device, &vert_info, allocator, &bd->BindlessShaderModuleVert);
+        check_vk_result(err);
+    }
+    if (bd->VulkanInitInfo.UseBindless && bd->BindlessShaderModuleFrag == VK_NULL_HANDLE)
+    {
+        VkShaderModuleCreateInfo frag_info = {};
+        frag_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        frag_info.codeSize = sizeof(__glsl_shader_frag_bindless_spv);
+        frag_info.pCode = (uint32_t*)__glsl_shader_frag_bindless_spv;
+        VkResult err = vkCreateShaderModule(device, &frag_info, allocator, &bd->BindlessShaderModuleFrag);
+        check_vk_result(err);
+    }
 }
 
-static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass)
+// The bindless pipeline adds a per-instance binding with the clip rectangle and texture slot of each ImDrawCmd
+static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass, bool bindless = false)
 {
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_CreateShaderModules(device, allocator);
@@ -860,18 +1678,21 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     VkPipelineShaderStageCreateInfo stage[2] = {};
     stage[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stage[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-    stage[0].module = bd->ShaderModuleVert;
+    stage[0].module = bindless ? bd->BindlessShaderModuleVert : bd->ShaderModuleVert;
     stage[0].pName = "main";
     stage[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stage[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    stage[1].module = bd->ShaderModuleFrag;
+    stage[1].module = bindless ? bd->BindlessShaderModuleFrag : bd->ShaderModuleFrag;
     stage[1].pName = "main";
 
-    VkVertexInputBindingDescription binding_desc[1] = {};
+    VkVertexInputBindingDescription binding_desc[2] = {};
     binding_desc[0].stride = sizeof(ImDrawVert);
     binding_desc[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    binding_desc[1].binding = 1;
+    binding_desc[1].stride = sizeof(ImGui_ImplVulkan_BindlessInstance);
+    binding_desc[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-    VkVertexInputAttributeDescription attribute_desc[3] = {};
+    VkVertexInputAttributeDescription attribute_desc[5] = {};
     attribute_desc[0].location = 0;
     attribute_desc[0].binding = binding_desc[0].binding;
     attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
@@ -884,12 +1705,20 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     attribute_desc[2].binding = binding_desc[0].binding;
     attribute_desc[2].format = VK_FORMAT_R8G8B8A8_UNORM;
     attribute_desc[2].offset = offsetof(ImDrawVert, col);
+    attribute_desc[3].location = 3;
+    attribute_desc[3].binding = binding_desc[1].binding;
+    attribute_desc[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attribute_desc[3].offset = offsetof(ImGui_ImplVulkan_BindlessInstance, ClipRect);
+    attribute_desc[4].location = 4;
+    attribute_desc[4].binding = binding_desc[1].binding;
+    attribute_desc[4].format = VK_FORMAT_R32_UINT;
+    attribute_desc[4].offset = offsetof(ImGui_ImplVulkan_BindlessInstance, Texture);
 
     VkPipelineVertexInputStateCreateInfo vertex_info = {};
     vertex_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertex_info.vertexBindingDescriptionCount = 1;
+    vertex_info.vertexBindingDescriptionCount = bindless ? 2 : 1;
     vertex_info.pVertexBindingDescriptions = binding_desc;
-    vertex_info.vertexAttributeDescriptionCount = 3;
+    vertex_info.vertexAttributeDescriptionCount = bindless ? 5 : 3;
     vertex_info.pVertexAttributeDescriptions = attribute_desc;
 
     VkPipelineInputAssemblyStateCreateInfo ia_info = {};
@@ -949,7 +1778,7 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     info.pDepthStencilState = &depth_info;
     info.pColorBlendState = &blend_info;
     info.pDynamicState = &dynamic_state;
-    info.layout = bd->PipelineLayout;
+    info.layout = bindless ? bd->BindlessPipelineLayout : bd->PipelineLayout;
     info.renderPass = renderPass;
     info.subpass = subpass;
 
@@ -1025,6 +1854,78 @@ bool ImGui_ImplVulkan_CreateDeviceObjects()
 
     ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, v->RenderPass, v->MSAASamples, &bd->Pipeline, v->Subpass);
 
+#ifdef IMGUI_IMPL_VULKAN_HAS_BINDLESS
+    if (v->UseBindless)
+    {
+        // One array of combined image samplers for every texture. Free slots are written by ImGui_ImplVulkan_AddTexture() while frames using other slots are in flight.
+        const uint32_t max_textures = v->BindlessMaxTextures ? v->BindlessMaxTextures : 4096;
+        if (!bd->BindlessSetLayout)
+        {
+            VkDescriptorBindingFlags binding_flags[1] = { VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT };
+            VkDescriptorSetLayoutBindingFlagsCreateInfo flags_info = {};
+            flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            flags_info.bindingCount = 1;
+            flags_info.pBindingFlags = binding_flags;
+            VkDescriptorSetLayoutBinding binding[1] = {};
+            binding[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            binding[0].descriptorCount = max_textures;
+            binding[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+            VkDescriptorSetLayoutCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            info.pNext = &flags_info;
+            info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+            info.bindingCount = 1;
+            info.pBindings = binding;
+            err = vkCreateDescriptorSetLayout(v->Device, &info, v->Allocator, &bd->BindlessSetLayout);
+            check_vk_result(err);
+        }
+
+        if (!bd->BindlessDescriptorPool)
+        {
+            VkDescriptorPoolSize pool_sizes[1] = { { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, max_textures } };
+            VkDescriptorPoolCreateInfo pool_info = {};
+            pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+            pool_info.maxSets = 1;
+            pool_info.poolSizeCount = 1;
+            pool_info.pPoolSizes = pool_sizes;
+            err = vkCreateDescriptorPool(v->Device, &pool_info, v->Allocator, &bd->BindlessDescriptorPool);
+            check_vk_result(err);
+
+            VkDescriptorSetAllocateInfo alloc_info = {};
+            alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            alloc_info.descriptorPool = bd->BindlessDescriptorPool;
+            alloc_info.descriptorSetCount = 1;
+            alloc_info.pSetLayouts = &bd->BindlessSetLayout;
+            err = vkAllocateDescriptorSets(v->Device, &alloc_info, &bd->BindlessDescriptorSet);
+            check_vk_result(err);
+            bd->BindlessTextures.clear();
+            bd->BindlessFreeSlots.clear();
+            bd->BindlessRetiredSlots.clear();
+            bd->BindlessSlots.Clear();
+        }
+
+        if (!bd->BindlessPipelineLayout)
+        {
+            // Same push constants as the classic pipeline
+            VkPushConstantRange push_constants[1] = {};
+            push_constants[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+            push_constants[0].offset = sizeof(float) * 0;
+            push_constants[0].size = sizeof(float) * 4;
+            VkPipelineLayoutCreateInfo layout_info = {};
+            layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            layout_info.setLayoutCount = 1;
+            layout_info.pSetLayouts = &bd->BindlessSetLayout;
+            layout_info.pushConstantRangeCount = 1;
+            layout_info.pPushConstantRanges = push_constants;
+            err = vkCreatePipelineLayout(v->Device, &layout_info, v->Allocator, &bd->BindlessPipelineLayout);
+            check_vk_result(err);
+        }
+
+        ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, v->RenderPass, v->MSAASamples, &bd->BindlessPipeline, v->Subpass, true);
+    }
+#endif
+
     return true;
 }
 
@@ -1033,6 +1934,7 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     ImGui_ImplVulkan_DestroyWindowRenderBuffers(v->Device, &bd->MainWindowRenderBuffers, v->Allocator);
+    ImGui_ImplVulkan_DestroyStreamingBuffer(v->Device, &bd->StreamingBuffer, v->Allocator);
     ImGui_ImplVulkan_DestroyFontsTexture();
 
     if (bd->FontCommandBuffer)    { vkFreeCommandBuffers(v->Device, bd->FontCommandPool, 1, &bd->FontCommandBuffer); bd->FontCommandBuffer = VK_NULL_HANDLE; }
@@ -1043,6 +1945,13 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     if (bd->DescriptorSetLayout)  { vkDestroyDescriptorSetLayout(v->Device, bd->DescriptorSetLayout, v->Allocator); bd->DescriptorSetLayout = VK_NULL_HANDLE; }
     if (bd->PipelineLayout)       { vkDestroyPipelineLayout(v->Device, bd->PipelineLayout, v->Allocator); bd->PipelineLayout = VK_NULL_HANDLE; }
     if (bd->Pipeline)             { vkDestroyPipeline(v->Device, bd->Pipeline, v->Allocator); bd->Pipeline = VK_NULL_HANDLE; }
+
+    if (bd->BindlessShaderModuleVert) { vkDestroyShaderModule(v->Device, bd->BindlessShaderModuleVert, v->Allocator); bd->BindlessShaderModuleVert = VK_NULL_HANDLE; }
+    if (bd->BindlessShaderModuleFrag) { vkDestroyShaderModule(v->Device, bd->BindlessShaderModuleFrag, v->Allocator); bd->BindlessShaderModuleFrag = VK_NULL_HANDLE; }
+    if (bd->BindlessDescriptorPool)   { vkDestroyDescriptorPool(v->Device, bd->BindlessDescriptorPool, v->Allocator); bd->BindlessDescriptorPool = VK_NULL_HANDLE; bd->BindlessDescriptorSet = VK_NULL_HANDLE; }
+    if (bd->BindlessSetLayout)        { vkDestroyDescriptorSetLayout(v->Device, bd->BindlessSetLayout, v->Allocator); bd->BindlessSetLayout = VK_NULL_HANDLE; }
+    if (bd->BindlessPipelineLayout)   { vkDestroyPipelineLayout(v->Device, bd->BindlessPipelineLayout, v->Allocator); bd->BindlessPipelineLayout = VK_NULL_HANDLE; }
+    if (bd->BindlessPipeline)         { vkDestroyPipeline(v->Device, bd->BindlessPipeline, v->Allocator); bd->BindlessPipeline = VK_NULL_HANDLE; }
 }
 
 bool    ImGui_ImplVulkan_LoadFunctions(PFN_vkVoidFunction(*loader_func)(const char* function_name, void* user_data), void* user_data)
@@ -1090,6 +1999,9 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
         IM_ASSERT(0 && "Can't use dynamic rendering when neither VK_VERSION_1_3 or VK_KHR_dynamic_rendering is defined.");
 #endif
     }
+#ifndef IMGUI_IMPL_VULKAN_HAS_BINDLESS
+    IM_ASSERT(!info->UseBindless && "Can't use bindless rendering when VK_VERSION_1_2 is not defined.");
+#endif
 
     ImGuiIO& io = ImGui::GetIO();
     IMGUI_CHECKVERSION();
@@ -1113,6 +2025,11 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
 
     bd->VulkanInitInfo = *info;
 
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(info->PhysicalDevice, &properties);
+    bd->NonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
+    bd->MaxDrawIndirectCount = IM_MAX(properties.limits.maxDrawIndirectCount, 1u);
+
     ImGui_ImplVulkan_CreateDeviceObjects();
 
     return true;
@@ -1154,6 +2071,40 @@ void ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count)
     bd->VulkanInitInfo.MinImageCount = min_image_count;
 }
 
+void ImGui_ImplVulkan_SetUseStreamingBuffer(bool use_streaming_buffer)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (bd->VulkanInitInfo.UseStreamingBuffer == use_streaming_buffer)
+        return;
+
+    // Buffers of the previous mode may still be in use by in-flight frames
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err = vkDeviceWaitIdle(v->Device);
+    check_vk_result(err);
+    ImGui_ImplVulkan_DestroyWindowRenderBuffers(v->Device, &bd->MainWindowRenderBuffers, v->Allocator);
+    ImGui_ImplVulkan_DestroyStreamingBuffer(v->Device, &bd->StreamingBuffer, v->Allocator);
+    v->UseStreamingBuffer = use_streaming_buffer;
+}
+
+void ImGui_ImplVulkan_SetUseStateTracking(bool use_state_tracking)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    bd->VulkanInitInfo.UseStateTracking = use_state_tracking;
+}
+
+void ImGui_ImplVulkan_SetUseBindless(bool use_bindless)
+{
+    // Resources only exist when initialized with UseBindless, textures are registered in the array even while it is off
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    bd->VulkanInitInfo.UseBindless = use_bindless && bd->BindlessPipeline != VK_NULL_HANDLE;
+}
+
+ImGui_ImplVulkan_RenderStats ImGui_ImplVulkan_GetRenderStats()
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    return bd->RenderStats;
+}
+
 // Register a texture
 // FIXME: This is experimental in the sense that we are unsure how to best design/tackle this problem, please post to https://github.com/ocornut/imgui/pull/914 if you have suggestions.
 VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image_view, VkImageLayout image_layout)
@@ -1186,6 +2137,30 @@ VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image
         write_desc[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         write_desc[0].pImageInfo = desc_image;
         vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
+
+        // Bindless: the same image in a free slot of the texture array
+        if (bd->BindlessDescriptorSet != VK_NULL_HANDLE)
+        {
+            int slot = bd->BindlessTextures.Size;
+            if (!bd->BindlessFreeSlots.empty())
+            {
+                slot = bd->BindlessFreeSlots.back();
+                bd->BindlessFreeSlots.pop_back();
+                bd->BindlessTextures[slot] = descriptor_set;
+            }
+            else
+            {
+                IM_ASSERT((uint32_t)slot < (v->BindlessMaxTextures ? v->BindlessMaxTextures : 4096) && "Too many textures, raise BindlessMaxTextures");
+                bd->BindlessTextures.push_back(descriptor_set);
+            }
+            ImGuiID key = ImGui_ImplVulkan_BindlessKey(descriptor_set);
+            if (bd->BindlessSlots.GetInt(key) == 0)
+                bd->BindlessSlots.SetInt(key, slot + 1);
+
+            write_desc[0].dstSet = bd->BindlessDescriptorSet;
+            write_desc[0].dstArrayElement = (uint32_t)slot;
+            vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
+        }
     }
     return descriptor_set;
 }
@@ -1195,16 +2170,32 @@ void ImGui_ImplVulkan_RemoveTexture(VkDescriptorSet descriptor_set)
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     vkFreeDescriptorSets(v->Device, v->DescriptorPool, 1, &descriptor_set);
+
+    // Bindless: the slot keeps its stale descriptor (the array is partially bound), frames already submitted may still sample it.
+    // It is only rewritten by ImGui_ImplVulkan_AddTexture() after ImGui_ImplVulkan_BeginDrawData() has seen those frames complete
+    int slot = (bd->BindlessDescriptorSet != VK_NULL_HANDLE) ? ImGui_ImplVulkan_BindlessSlot(descriptor_set) : -1;
+    if (slot >= 0)
+    {
+        ImGuiID key = ImGui_ImplVulkan_BindlessKey(descriptor_set);
+        if (bd->BindlessSlots.GetInt(key) == slot + 1)
+            bd->BindlessSlots.SetInt(key, 0);
+        bd->BindlessTextures[slot] = VK_NULL_HANDLE;
+        ImGui_ImplVulkan_RetiredSlot retired = { slot, bd->FrameSerial };
+        bd->BindlessRetiredSlots.push_back(retired);
+    }
 }
 
 void ImGui_ImplVulkan_DestroyFrameRenderBuffers(VkDevice device, ImGui_ImplVulkan_FrameRenderBuffers* buffers, const VkAllocationCallbacks* allocator)
 {
     if (buffers->VertexBuffer) { vkDestroyBuffer(device, buffers->VertexBuffer, allocator); buffers->VertexBuffer = VK_NULL_HANDLE; }
-    if (buffers->VertexBufferMemory) { vkFreeMemory(device, buffers->VertexBufferMemory, allocator); buffers->VertexBufferMemory = VK_NULL_HANDLE; }
+    if (buffers->VertexBufferMemory.Memory) { ImGui_ImplVulkan_FreeMemory(&buffers->VertexBufferMemory); }
     if (buffers->IndexBuffer) { vkDestroyBuffer(device, buffers->IndexBuffer, allocator); buffers->IndexBuffer = VK_NULL_HANDLE; }
-    if (buffers->IndexBufferMemory) { vkFreeMemory(device, buffers->IndexBufferMemory, allocator); buffers->IndexBufferMemory = VK_NULL_HANDLE; }
+    if (buffers->IndexBufferMemory.Memory) { ImGui_ImplVulkan_FreeMemory(&buffers->IndexBufferMemory); }
+    if (buffers->IndirectBuffer) { vkDestroyBuffer(device, buffers->IndirectBuffer, allocator); buffers->IndirectBuffer = VK_NULL_HANDLE; }
+    if (buffers->IndirectBufferMemory.Memory) { ImGui_ImplVulkan_FreeMemory(&buffers->IndirectBufferMemory); }
     buffers->VertexBufferSize = 0;
     buffers->IndexBufferSize = 0;
+    buffers->IndirectBufferSize = 0;
 }
 
 void ImGui_ImplVulkan_DestroyWindowRenderBuffers(VkDevice device, ImGui_ImplVulkan_WindowRenderBuffers* buffers, const VkAllocationCallbacks* allocator)
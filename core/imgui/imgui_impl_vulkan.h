@@ -62,6 +62,21 @@
 #if defined(VK_VERSION_1_3) || defined(VK_KHR_dynamic_rendering)
 #define IMGUI_IMPL_VULKAN_HAS_DYNAMIC_RENDERING
 #endif
+#if defined(VK_VERSION_1_2)
+#define IMGUI_IMPL_VULKAN_HAS_BINDLESS
+#endif
+
+// (Optional) Memory handed out by an external allocator, see AllocateMemoryFn in ImGui_ImplVulkan_InitInfo.
+// [Please zero-clear before use!]
+struct ImGui_ImplVulkan_MemoryAllocation
+{
+    VkDeviceMemory                  Memory;
+    VkDeviceSize                    Offset;
+    VkDeviceSize                    Size;
+    void*                           MappedData;                   // Persistent mapping of [Offset, Offset+Size), or nullptr to let the backend map it
+    VkMemoryPropertyFlags           PropertyFlags;                // Flushes are skipped for VK_MEMORY_PROPERTY_HOST_COHERENT_BIT memory
+    void*                           Handle;                       // Owned by the allocator
+};
 
 // Initialization data, for ImGui_ImplVulkan_Init()
 // - VkDescriptorPool should be created with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
@@ -96,6 +111,57 @@ struct ImGui_ImplVulkan_InitInfo
     const VkAllocationCallbacks*    Allocator;
     void                            (*CheckVkResultFn)(VkResult err);
     VkDeviceSize                    MinAllocationSize;      // Minimum allocation size. Set to 1024*1024 to satisfy zealous best practices validation layer and waste a little memory.
+
+    // (Optional) External device memory allocator
+    // When set, vertex/index buffers, the font image and its staging buffer are sub-allocated instead of each getting its own vkAllocateMemory().
+    // Host visible allocations must be aligned to nonCoherentAtomSize when they are not HOST_COHERENT.
+    bool                            (*AllocateMemoryFn)(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags properties, ImGui_ImplVulkan_MemoryAllocation* out_allocation, void* user_data);
+    void                            (*FreeMemoryFn)(ImGui_ImplVulkan_MemoryAllocation* allocation, void* user_data);
+    void*                           MemoryUserData;
+    // (Optional) Deferred release of buffers that may still be used by in-flight frames (growth of vertex/index/streaming buffers).
+    // The callback takes ownership of 'buffer' and 'allocation' and must destroy them once the GPU is done. Requires AllocateMemoryFn.
+    void                            (*ReleaseBufferFn)(VkBuffer buffer, ImGui_ImplVulkan_MemoryAllocation* allocation, void* user_data);
+
+    // (Optional) Streaming upload
+    // When set, vertices and indices of all in-flight frames live in one persistently mapped ring buffer (host coherent when available).
+    // Each frame is then a single bump allocation in the ring, with no vkMapMemory()/vkUnmapMemory() calls.
+    bool                            UseStreamingBuffer;
+    VkDeviceSize                    StreamingBufferSize;    // Initial ring size, 0 defaults to 4 MB. Grows when a frame does not fit.
+
+    // (Optional) Asynchronous texture upload
+    // When set, the font atlas pixels are handed to this callback instead of being copied with a blocking submit on 'Queue'.
+    // The callback must copy 'pixels' before returning, leave 'image' in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL and make
+    // the copy visible to 'Queue' (e.g. with a semaphore wait) before the first frame sampling it is executed.
+    bool                            (*UploadTextureFn)(VkImage image, uint32_t width, uint32_t height, const void* pixels, size_t size, void* user_data);
+    void*                           UploadUserData;
+    uint32_t                        UploadQueueFamily;      // Queue family used by UploadTextureFn. If it differs from QueueFamily, the font image is created with VK_SHARING_MODE_CONCURRENT.
+
+    // (Optional) Redundant state elimination
+    // When set, vkCmdSetScissor()/vkCmdBindDescriptorSets() are skipped when the state is already bound, and adjacent draws with the same
+    // state are merged into one vkCmdDrawIndexed(). Indices are rebased on upload when they fit ImDrawIdx, so merging also works across lists.
+    bool                            UseStateTracking;
+
+    // (Optional) Bindless rendering
+    // When set, every texture registered with ImGui_ImplVulkan_AddTexture() also gets a slot in one descriptor-indexed array.
+    // The slot and clip rectangle of each ImDrawCmd are written to a per-instance attribute, clipping is done with gl_ClipDistance,
+    // and all commands between two user callbacks are drawn with a single vkCmdDrawIndexedIndirect().
+    // Requires the Vulkan 1.2 features runtimeDescriptorArray, shaderSampledImageArrayNonUniformIndexing, descriptorBindingPartiallyBound,
+    // descriptorBindingSampledImageUpdateAfterBind and descriptorBindingUpdateUnusedWhilePending, and the core features multiDrawIndirect,
+    // drawIndirectFirstInstance and shaderClipDistance. Textures must come from ImGui_ImplVulkan_AddTexture().
+    // Its SPIR-V is hand-assembled and not yet validated (see __glsl_shader_vert_bindless_spv), so keep it opt-in.
+    bool                            UseBindless;
+    uint32_t                        BindlessMaxTextures;    // Size of the texture array, 0 defaults to 4096
+};
+
+// Command counts of a recorded frame, see ImGui_ImplVulkan_GetRenderStats()
+struct ImGui_ImplVulkan_RenderStats
+{
+    int                             DrawCommands;           // ImDrawCmd drawn, before merging
+    int                             DrawCalls;              // vkCmdDrawIndexed() or vkCmdDrawIndexedIndirect() issued
+    int                             ScissorsSet;
+    int                             ScissorsSkipped;
+    int                             DescriptorSetsBound;
+    int                             DescriptorSetsSkipped;
 };
 
 // Called by user code
@@ -103,9 +169,25 @@ IMGUI_IMPL_API bool         ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* inf
 IMGUI_IMPL_API void         ImGui_ImplVulkan_Shutdown();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_NewFrame();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline = VK_NULL_HANDLE);
+
+// Split rendering, to upload and record large draw data from several threads. ImGui_ImplVulkan_RenderDrawData() is these four calls in a row.
+// - BeginDrawData() reserves the vertex/index memory of the frame and computes the offset of every list (prefix sum). Returns false when minimized.
+// - UploadDrawLists() copies lists [list_begin, list_end). Disjoint ranges may be copied concurrently.
+// - EndUpload() flushes non coherent memory, call it once all copies are done.
+// - RecordDrawLists() sets up render state and records lists [list_begin, list_end), e.g. into a secondary command buffer begun with
+//   VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT. Disjoint ranges may be recorded concurrently into different command buffers.
+//   User callbacks are invoked on the recording thread.
+IMGUI_IMPL_API bool         ImGui_ImplVulkan_BeginDrawData(ImDrawData* draw_data, VkPipeline pipeline = VK_NULL_HANDLE);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_UploadDrawLists(ImDrawData* draw_data, int list_begin, int list_end);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_EndUpload(ImDrawData* draw_data);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_RecordDrawLists(ImDrawData* draw_data, VkCommandBuffer command_buffer, int list_begin, int list_end, ImGui_ImplVulkan_RenderStats* stats = nullptr); // Counts are added to 'stats'
 IMGUI_IMPL_API bool         ImGui_ImplVulkan_CreateFontsTexture();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_DestroyFontsTexture();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count); // To override MinImageCount after initialization (e.g. if swap chain is recreated)
+IMGUI_IMPL_API void         ImGui_ImplVulkan_SetUseStreamingBuffer(bool use_streaming_buffer); // Switch between per-frame buffers and the streaming ring buffer at runtime
+IMGUI_IMPL_API void         ImGui_ImplVulkan_SetUseStateTracking(bool use_state_tracking); // Takes effect with the next ImGui_ImplVulkan_BeginDrawData()
+IMGUI_IMPL_API void         ImGui_ImplVulkan_SetUseBindless(bool use_bindless); // Takes effect with the next ImGui_ImplVulkan_BeginDrawData(). Ignored unless initialized with UseBindless
+IMGUI_IMPL_API ImGui_ImplVulkan_RenderStats ImGui_ImplVulkan_GetRenderStats(); // Of the last ImGui_ImplVulkan_RenderDrawData()
 
 // Register a texture (VkDescriptorSet == ImTextureID)
 // FIXME: This is experimental in the sense that we are unsure how to best design/tackle this problem
@@ -21,31 +21,82 @@ namespace Engine {
 
     }
 
-    void Core::vulkanInitialize(std::vector<const char*> instanceExtensions) {
+    void Core::vulkanInitialize(std::vector<const char*> instanceExtensions, GLFWwindow* glfwWindow) {
         VkResult result;
+        const auto start = std::chrono::steady_clock::now();
 
+        //     :         
+        if (hostAllocatorEnabled) {
+            allocator = hostAllocator.callbacks();
+        }
         createInstance(instanceExtensions);
 
+        //     ,   ,   
+        if (glfwWindow != nullptr) {
+            result = glfwCreateWindowSurface(instance, glfwWindow, allocator, &surface);
+            checkVkResult(result);
+        }
+
+        //        
+        if (surface != VK_NULL_HANDLE) {
+            deviceRequirements.requiredExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+        deviceRequirements.requirePresent = surface != VK_NULL_HANDLE;
+
+        /*
+        *           API ( DirectX).
+        *          ,    ,   
+        */
+#ifdef VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME
+        deviceRequirements.optionalExtensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
+#endif
+
+        // Present wait         
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        if (surface != VK_NULL_HANDLE) {
+            deviceRequirements.optionalExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+            deviceRequirements.optionalExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        }
+#endif
+
+        //     :   ,    
+#ifdef VK_EXT_memory_budget
+        deviceRequirements.optionalExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+#endif
+
         physicalDevice = selectPhysicalDevice();
 
         selectQueueFamily();
         createLogicalDevice();
+        if (syncMode == FrameSyncMode::Timeline && !timelineSemaphores) {
+            LOG_WARNING(Vulkan, "Timeline semaphores are not supported, frame sync falls back to fences");
+            syncMode = FrameSyncMode::Fences;
+        }
+        memoryAllocator.initialize(physicalDevice, logicalDevice, allocator, memoryBudget);
+        deletionQueue.initialize(logicalDevice, allocator, &memoryAllocator);
+        if (timelineSemaphores) {
+            uploadService.initialize(logicalDevice, allocator, &memoryAllocator, &queues);
+        }
+        createPipelineCache();
         createDescriptorPool();
+
+        startupTimings.vulkanInitializeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     }
 
     void Core::callback(int level, const char* description) {
         switch (level) {
         case 0:
-            LOG_INFO(SS("Vulkan info: " << description << ".\n")); //  
+            LOG_INFO(Vulkan, "Vulkan info: {}.", description); //  
             break;
         case 1:
-            LOG_WARNING(SS("Vulkan warning: " << description << ".\n")); //  
+            LOG_WARNING(Vulkan, "Vulkan warning: {}.", description); //  
             break;
         case 2:
-            LOG_ERROR(SS("Vulkan error: " << description << ".\n")); //  
+            LOG_ERROR(Vulkan, "Vulkan error: {}.", description); //  
             break;
         case 3:
-            LOG_CRITICAL(SS("Vulkan critical error: " << description << ".\n")); //   
+            LOG_CRITICAL(Vulkan, "Vulkan critical error: {}.", description); //   
+            Log::shutdown(); //   abort,     
             break;
         default:
             break;
@@ -54,12 +105,31 @@ namespace Engine {
 
     void Core::checkVkResult(VkResult error) {
         if (error == 0) return; //  error = 0,    
-        LOG_ERROR(SS("Vulkan error: " << error));
+        LOG_ERROR(Vulkan, "Vulkan error: {}", (int)error);
         if(error < 0) {
+            Log::shutdown();
             abort(); //  error < 0,     
         }
     }
 
+    VkResult Core::submit(QueueType type, uint32_t submitCount, const VkSubmitInfo* submits, VkFence fence) {
+        return queues.submit(type, submitCount, submits, fence);
+    }
+
+    uint32_t Core::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) {
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i; //   ,     ,    
+            }
+        }
+
+        callback(3, "no suitable memory type");
+        abort();
+    }
+
     bool Core::isExtensionAvailable(const std::vector<VkExtensionProperties>& properties, const char* extension) {
         for (const auto& i : properties) {
             if (strcmp(extension, i.extensionName) == 0) {
@@ -76,36 +146,28 @@ namespace Engine {
         return false;
     }
 
-    VkPhysicalDevice Core::selectPhysicalDevice() {
-        uint32_t devicesCount; //    ()
-        VkResult result = vkEnumeratePhysicalDevices(instance, &devicesCount, nullptr); //  devicesCount   
-        checkVkResult(result); //     vkEnumeratePhysicalDevices
-
-        std::vector<VkPhysicalDevice> devices{devicesCount}; //      
-        result = vkEnumeratePhysicalDevices(instance, &devicesCount, devices.data()); 
-        checkVkResult(result);
-
-        for (const auto& device : devices) {
-            VkPhysicalDeviceProperties properties; // VkPhysicalDeviceProperties -  
-            vkGetPhysicalDeviceProperties(device, &properties); //    
-
-            if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-                return device; //      -   
-            }
-        }
+    void Core::createInstance(std::vector<const char*> instanceExtensions) {
+        VkResult result;
 
-        if (devicesCount > 0) {
-            return devices[0]; //     ,     
+        /*
+        * Vulkan 1.2   timeline ,       .
+        *  1.0   vkEnumerateInstanceVersion      apiVersion  1.0,     
+        */
+        instanceApiVersion = VK_API_VERSION_1_0;
+        auto enumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+        if (enumerateInstanceVersion != nullptr && enumerateInstanceVersion(&instanceApiVersion) != VK_SUCCESS) {
+            instanceApiVersion = VK_API_VERSION_1_0;
         }
+        instanceApiVersion = std::min<uint32_t>(instanceApiVersion, VK_API_VERSION_1_2);
 
-        return VK_NULL_HANDLE; //  0,      
-    }
-
-    void Core::createInstance(std::vector<const char*> instanceExtensions) {
-        VkResult result;
+        VkApplicationInfo applicationInfo{};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pEngineName = "Engine";
+        applicationInfo.apiVersion = instanceApiVersion;
 
         VkInstanceCreateInfo createInfo{}; // create info 
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &applicationInfo;
 
         uint32_t propertiesCount; //     
         vkEnumerateInstanceExtensionProperties(nullptr, &propertiesCount, nullptr); //  propertiesCount
@@ -169,85 +231,102 @@ namespace Engine {
     }
 
     void Core::selectQueueFamily() {
-        uint32_t familiesCount; //   
-        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, nullptr); //       familiesCount
-
-        //     
-        VkQueueFamilyProperties* queues = (VkQueueFamilyProperties*)malloc(sizeof(VkQueueFamilyProperties) * familiesCount);
-        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, queues); //   queues  
-
-        for (uint32_t i = 0; i < familiesCount; i++) {
-            if (queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-                queueFamily = i;
-                break;
-
-                /*
-                *      
-                *   =  ,     queueFamily
-                *      ,  
-                */
-            }
+        /*
+        *  : ,  ,   .
+        *    ,     
+        */
+        if (!queues.discover(physicalDevice, surface)) {
+            callback(3, "device has no suitable queue family");
+            exit(-1);
         }
 
-        free(queues); //  ,   queues, .        queueFamily
+        queueFamily = queues.get(QueueType::Graphics).family; //   ,   ImGui   
         assert(queueFamily != (uint32_t)-1);
     }
 
     void Core::createLogicalDevice() {
         VkResult result;
 
-        std::vector<const char*> deviceExtensions{"VK_KHR_swapchain"}; //      
-
-        uint32_t propertiesCount; //   
-        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &propertiesCount, nullptr); //  propertiesCount
-
-        std::vector<VkExtensionProperties> properties{propertiesCount}; //         propertiesCount
-        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &propertiesCount, properties.data()); //  properties
+        std::vector<VkDeviceQueueCreateInfo> queueInfo; // createInfo     
+        std::vector<float> priority; //  .   0.0f  1.0f
+        queues.fillCreateInfos(queueInfo, priority);
+
+        // Timeline  -  Vulkan 1.2, selectPhysicalDevice    
+        VkPhysicalDeviceVulkan12Features enabled12{};
+        enabled12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        enabled12.timelineSemaphore = timelineSemaphores ? VK_TRUE : VK_FALSE;
+
+        // Bindless  ImGui:     , selectPhysicalDevice   
+        VkPhysicalDeviceFeatures enabledFeatures = deviceRequirements.requiredFeatures;
+        if (bindlessSupported) {
+            enabled12.runtimeDescriptorArray = VK_TRUE;
+            enabled12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            enabled12.descriptorBindingPartiallyBound = VK_TRUE;
+            enabled12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            enabled12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            enabledFeatures.multiDrawIndirect = VK_TRUE;
+            enabledFeatures.drawIndirectFirstInstance = VK_TRUE;
+            enabledFeatures.shaderClipDistance = VK_TRUE;
+        }
 
-        /*
-        *           API ( DirectX).
-        *          .
-        */
-#ifdef VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME
-        if (isExtensionAvailable(properties, VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME))
-            deviceExtensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
+        void* features = timelineSemaphores || bindlessSupported ? &enabled12 : nullptr;
+
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        VkPhysicalDevicePresentIdFeaturesKHR enabledPresentId{};
+        enabledPresentId.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        enabledPresentId.presentId = VK_TRUE;
+        VkPhysicalDevicePresentWaitFeaturesKHR enabledPresentWait{};
+        enabledPresentWait.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        enabledPresentWait.presentWait = VK_TRUE;
+        if (presentWait) {
+            enabledPresentWait.pNext = features;
+            enabledPresentId.pNext = &enabledPresentWait;
+            features = &enabledPresentId;
+        }
 #endif
 
-        const float priority[]{ 1.0f }; //  .   0.1f  1.0f
-        
-        VkDeviceQueueCreateInfo queueInfo[1]{}; // createInfo   
-        queueInfo[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO; 
-        queueInfo[0].queueFamilyIndex = queueFamily; //   
-        queueInfo[0].queueCount = 1; //  
-        queueInfo[0].pQueuePriorities = priority; //   
-
         VkDeviceCreateInfo createInfo{}; // createInfo    
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        createInfo.queueCreateInfoCount = sizeof(queueInfo) / sizeof(queueInfo[0]); // queueInfo
-        createInfo.pQueueCreateInfos = queueInfo; // queueInfo
+        createInfo.pNext = features;
+        createInfo.queueCreateInfoCount = (uint32_t)queueInfo.size(); // queueInfo
+        createInfo.pQueueCreateInfos = queueInfo.data(); // queueInfo
         createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size()); //   
-        createInfo.ppEnabledExtensionNames = deviceExtensions.data(); //   
+        createInfo.ppEnabledExtensionNames = deviceExtensions.data(); //   ,   selectPhysicalDevice
+        createInfo.pEnabledFeatures = &enabledFeatures;
 
         result = vkCreateDevice(physicalDevice, &createInfo, allocator, &logicalDevice); //   
         checkVkResult(result); //    vkCreateDevice
 
-        vkGetDeviceQueue(logicalDevice, queueFamily, 0, &queue); //       queue
+        queues.resolve(logicalDevice, allocator, timelineSemaphores);
+        queue = queues.get(QueueType::Graphics).queue; //       queue
+        queues.logTopology();
+        LOG_INFO(Vulkan, "Timeline semaphores {}", timelineSemaphores ? "on" : "off");
+        LOG_INFO(Vulkan, "Bindless ImGui {}", bindlessSupported ? fmt::format("supported, up to {} textures", bindlessMaxTextures) : std::string("off"));
+
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        if (presentWait) {
+            waitForPresent = (PFN_vkWaitForPresentKHR)vkGetDeviceProcAddr(logicalDevice, "vkWaitForPresentKHR");
+            presentWait = waitForPresent != nullptr;
+        }
+#endif
+        LOG_INFO(Vulkan, "Present wait {}", presentWait ? "on" : "off");
     }
 
     /*
-    *   -  ,       
+    *   -  ,       .
+    *          ImGui_ImplVulkan_AddTexture
     */
     void Core::createDescriptorPool() {
         VkResult result;
 
         VkDescriptorPoolSize poolSize[] = {
-            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imguiMaxTextures},
         };
 
         VkDescriptorPoolCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-        createInfo.maxSets = 1;
+        createInfo.maxSets = imguiMaxTextures;
         createInfo.poolSizeCount = (uint32_t)IM_ARRAYSIZE(poolSize);
         createInfo.pPoolSizes = poolSize;
 
@@ -260,7 +339,7 @@ namespace Engine {
 
         // check for window system integration (WSI) support
         VkBool32 result;
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamily, window->Surface, &result);
+        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queues.get(QueueType::Present).family, window->Surface, &result);
         if (result != VK_TRUE) {
             callback(3, "device not support WSI");
             exit(-1);
@@ -270,18 +349,34 @@ namespace Engine {
         const VkColorSpaceKHR requestSurfaceColorSpace = VK_COLORSPACE_SRGB_NONLINEAR_KHR;
         window->SurfaceFormat = ImGui_ImplVulkanH_SelectSurfaceFormat(physicalDevice, window->Surface, requestSurfaceImageFormat, (size_t)IM_ARRAYSIZE(requestSurfaceImageFormat), requestSurfaceColorSpace);
 
-#ifdef LockFPS
-        VkPresentModeKHR presentModes[]{ VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_KHR };
-#else
-        VkPresentModeKHR presentModes[]{ VK_PRESENT_MODE_FIFO_KHR };
-#endif
-        window->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(physicalDevice, window->Surface, &presentModes[0], IM_ARRAYSIZE(presentModes));
+        //   ,       (setPresentMode)
+        uint32_t modeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, window->Surface, &modeCount, nullptr);
+        supportedPresentModes.resize(modeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, window->Surface, &modeCount, supportedPresentModes.data());
 
-        IM_ASSERT(minImageCount >= window->ImageCount);
-        ImGui_ImplVulkanH_CreateOrResizeWindow(instance, physicalDevice, logicalDevice, window, queueFamily, allocator, width, height, minImageCount);
+        window->PresentMode = ImGui_ImplVulkanH_SelectPresentMode(physicalDevice, window->Surface, presentModePreference.data(), (int)presentModePreference.size());
+        LOG_INFO(Swapchain, "Present mode: {}", presentModeName(window->PresentMode));
+
+        // ImGui     , IMMEDIATE     
+        if (minImageCount == 0) {
+            minImageCount = std::max(2, ImGui_ImplVulkanH_GetMinImageCountFromPresentMode(window->PresentMode));
+        }
+
+        createSwapchainRenderPass(window, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        recreateSwapchain(window, width, height);
+        swapChainRebuild = window->Swapchain == VK_NULL_HANDLE; //   ,     
     }
 
     void Core::cleanupVulkan() {
+        destroyFrameContexts();
+        destroyPipelineCache();
+        deletionQueue.flush(); //   vkDeviceWaitIdle,    
+        reportDeletionStats();
+        uploadService.shutdown();
+        queues.destroy();
+        reportMemoryStats();
+        memoryAllocator.shutdown();
         vkDestroyDescriptorPool(logicalDevice, descriptorPool, allocator);
 
 #ifdef APP_USE_VULKAN_DEBUG_REPORT
@@ -291,153 +386,450 @@ namespace Engine {
 
         vkDestroyDevice(logicalDevice, allocator);
         vkDestroyInstance(instance, allocator);
+
+        //        
+        if (allocator != nullptr && hostAllocator.stats().liveBytes != 0) {
+            LOG_WARNING(Memory, "Driver still holds {} bytes of host memory after vkDestroyInstance", hostAllocator.stats().liveBytes);
+        }
     }
 
     void Core::cleanupWindow() {
-        ImGui_ImplVulkanH_DestroyWindow(instance, logicalDevice, &imguiWindowData, allocator);
+        if (headless) {
+            destroyOffscreenTarget(&imguiWindowData);
+            return;
+        }
+        destroyPresentSemaphores();
+        destroySwapchain(&imguiWindowData);
     }
 
     void Core::frameRender(ImGui_ImplVulkanH_Window* window, ImDrawData* drawData) {
+        PROFILE_FUNCTION();
         VkResult result;
 
-        VkSemaphore image_acquired_semaphore = window->FrameSemaphores[window->SemaphoreIndex].ImageAcquiredSemaphore;
-        VkSemaphore render_complete_semaphore = window->FrameSemaphores[window->SemaphoreIndex].RenderCompleteSemaphore;
-
-        result = vkAcquireNextImageKHR(logicalDevice, window->Swapchain, UINT64_MAX, image_acquired_semaphore, VK_NULL_HANDLE, &window->FrameIndex);
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            swapChainRebuild = true;
-            return;
+        const auto frameStart = FrameStats::Clock::now();
+        if (imagesInFlight.size() != window->ImageCount) {
+            imagesInFlight.assign(window->ImageCount, VK_NULL_HANDLE); //   ,   
+            imagesInFlightValues.assign(window->ImageCount, 0);
         }
-        checkVkResult(result);
+        const bool timeline = syncMode == FrameSyncMode::Timeline;
 
-        ImGui_ImplVulkanH_Frame* frame = &window->Frames[window->FrameIndex];
+        /*
+        *   ,     FrameContext framesInFlight  ,
+        *   ,   : CPU   ,  GPU  
+        */
+        FrameContext& frame = frames[currentFrame];
         {
-            result = vkWaitForFences(logicalDevice, 1, &frame->Fence, VK_TRUE, UINT64_MAX);
+            PROFILE_SCOPE("wait frame");
+            if (timeline) {
+                queues.waitValue(QueueType::Graphics, frame.timelineValue);
+            }
+            else {
+                result = vkWaitForFences(logicalDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+                checkVkResult(result);
+            }
+        }
+        frame.transientOffset = 0; // GPU   ,    
+        graphicsCompleted = timeline ? queues.completedValue(QueueType::Graphics) : std::max(graphicsCompleted, frame.timelineValue);
+        deletionQueue.collect(graphicsCompleted);
+        uploadService.collect();
+
+        if (headless) {
+            frame.imageIndex = currentFrame; //     , acquire  
+            collectReadback(frame.imageIndex); //        
+        }
+        else {
+            result = vkAcquireNextImageKHR(logicalDevice, window->Swapchain, UINT64_MAX, frame.imageAcquiredSemaphore, VK_NULL_HANDLE, &frame.imageIndex);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                swapChainRebuild = true;
+                return;
+            }
+            if (result == VK_SUBOPTIMAL_KHR) {
+                result = VK_SUCCESS; //   ,      ,     
+            }
             checkVkResult(result);
+        }
+        window->FrameIndex = frame.imageIndex;
 
-            result = vkResetFences(logicalDevice, 1, &frame->Fence);
+        //         ( ,  ),   .
+        //       ,     
+        if (timeline) {
+            queues.waitValue(QueueType::Graphics, imagesInFlightValues[frame.imageIndex]); //  ,    
+        }
+        else {
+            VkFence& imageFence = imagesInFlight[frame.imageIndex];
+            if (imageFence != VK_NULL_HANDLE && imageFence != frame.fence) {
+                result = vkWaitForFences(logicalDevice, 1, &imageFence, VK_TRUE, UINT64_MAX);
+                checkVkResult(result);
+            }
+            imageFence = frame.fence;
+        }
+
+        const auto waitEnd = FrameStats::Clock::now();
+
+        if (!timeline) {
+            result = vkResetFences(logicalDevice, 1, &frame.fence); //     acquire,    
             checkVkResult(result);
         }
         {
-            result = vkResetCommandPool(logicalDevice, frame->CommandPool, 0);
+            result = vkResetCommandPool(logicalDevice, frame.commandPool, 0);
             checkVkResult(result);
 
             VkCommandBufferBeginInfo info{};
             info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
             info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
             
-            result = vkBeginCommandBuffer(frame->CommandBuffer, &info);
+            result = vkBeginCommandBuffer(frame.commandBuffer, &info);
             checkVkResult(result);
+#ifdef ENGINE_PROFILER
+            gpuProfiler.beginFrame(frame.commandBuffer, currentFrame, profiler().frameNumber()); //     ,   
+#endif
         }
         {
-            VkRenderPassBeginInfo info{};
-            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-            info.renderPass = window->RenderPass;
-            info.framebuffer = frame->Framebuffer;
-            info.renderArea.extent.width = window->Width;
-            info.renderArea.extent.height = window->Height;
-            info.clearValueCount = 1;
-            info.pClearValues = &window->ClearValue;
-            vkCmdBeginRenderPass(frame->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+            PROFILE_GPU_SCOPE(gpuProfiler, frame.commandBuffer, "frame");
+            {
+                PROFILE_GPU_SCOPE(gpuProfiler, frame.commandBuffer, "imgui");
+                recordImgui(frame, window, drawData);
+            }
+            if (headless) {
+                PROFILE_GPU_SCOPE(gpuProfiler, frame.commandBuffer, "readback");
+                recordReadback(frame.commandBuffer, frame.imageIndex);
+            }
         }
+        {
+            /*
+            *       GPU   :       .
+            *    .     acquire,  present,     
+            */
+            VkSemaphore waitSemaphores[2];
+            VkPipelineStageFlags waitStages[2];
+            uint64_t waitValues[2];
+            uint32_t waitCount = 0;
+            if (!headless) {
+                waitSemaphores[waitCount] = frame.imageAcquiredSemaphore;
+                waitStages[waitCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+                waitValues[waitCount++] = 0;
+            }
+            if (uploadService.submittedValue() > 0) {
+                waitSemaphores[waitCount] = uploadService.semaphore();
+                waitStages[waitCount] = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+                waitValues[waitCount++] = uploadService.submittedValue();
+            }
+            const uint32_t signalCount = headless ? 0 : 1;
+            const VkSemaphore* signalSemaphore = headless ? nullptr : &renderCompleteSemaphores[frame.imageIndex]; //    present 
 
-        ImGui_ImplVulkan_RenderDrawData(drawData, frame->CommandBuffer);
+            VkTimelineSemaphoreSubmitInfo timelineInfo{};
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount = waitCount;
+            timelineInfo.pWaitSemaphoreValues = waitValues;
 
-        vkCmdEndRenderPass(frame->CommandBuffer);
-        {
-            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
             VkSubmitInfo info{};
             info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            info.waitSemaphoreCount = 1;
-            info.pWaitSemaphores = &image_acquired_semaphore;
-            info.pWaitDstStageMask = &waitStage;
+            info.pNext = uploadService.submittedValue() > 0 ? &timelineInfo : nullptr;
+            info.waitSemaphoreCount = waitCount;
+            info.pWaitSemaphores = waitSemaphores;
+            info.pWaitDstStageMask = waitStages;
             info.commandBufferCount = 1;
-            info.pCommandBuffers = &frame->CommandBuffer;
-            info.signalSemaphoreCount = 1;
-            info.pSignalSemaphores = &render_complete_semaphore;
+            info.pCommandBuffers = &frame.commandBuffer;
+            info.signalSemaphoreCount = signalCount;
+            info.pSignalSemaphores = signalSemaphore;
 
-            result = vkEndCommandBuffer(frame->CommandBuffer);
-            checkVkResult(result);
-            result = vkQueueSubmit(queue, 1, &info, frame->Fence);
+            result = vkEndCommandBuffer(frame.commandBuffer);
             checkVkResult(result);
+            if (timeline) {
+                //      acquire/present,   WSI
+                frame.timelineValue = queues.submitTimeline(QueueType::Graphics, waitCount, waitSemaphores, waitValues, waitStages, 1, &frame.commandBuffer, signalCount, signalSemaphore);
+                imagesInFlightValues[frame.imageIndex] = frame.timelineValue;
+            }
+            else {
+                result = submit(QueueType::Graphics, 1, &info, frame.fence);
+                checkVkResult(result);
+                frame.timelineValue = graphicsSubmitted + 1; //  timeline    -   
+            }
+            graphicsSubmitted = frame.timelineValue;
         }
+
+        // :   ,  fence   
+        const auto frameEnd = FrameStats::Clock::now();
+        if (frameStats.lastFrame != FrameStats::Clock::time_point{}) {
+            const double frameTime = std::chrono::duration<double, std::milli>(frameStart - frameStats.lastFrame).count();
+            frameStats.frameTimeMin = frameStats.frames ? std::min(frameStats.frameTimeMin, frameTime) : frameTime;
+            frameStats.frameTimeMax = std::max(frameStats.frameTimeMax, frameTime);
+            frameStats.frameTimeSum += frameTime;
+            frameStats.fenceWaitSum += std::chrono::duration<double, std::milli>(waitEnd - frameStart).count();
+            frameStats.recordSum += std::chrono::duration<double, std::milli>(frameEnd - waitEnd).count();
+            frameStats.frames++;
+        }
+        frameStats.lastFrame = frameStart;
+        reportFrameStats();
     }
 
     void Core::framePresent(ImGui_ImplVulkanH_Window* window) {
+        PROFILE_FUNCTION();
+        if (headless) {
+            currentFrame = (currentFrame + 1) % framesInFlight; //  ,     GPU
+            return;
+        }
         if (swapChainRebuild) {
             return;
         }
 
-        VkSemaphore render_complete_semaphore = window->FrameSemaphores[window->SemaphoreIndex].RenderCompleteSemaphore;
+        FrameContext& frame = frames[currentFrame];
 
         VkPresentInfoKHR info{};
         info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
         info.waitSemaphoreCount = 1;
-        info.pWaitSemaphores = &render_complete_semaphore;
+        info.pWaitSemaphores = &renderCompleteSemaphores[frame.imageIndex];
         info.swapchainCount = 1;
         info.pSwapchains = &window->Swapchain;
-        info.pImageIndices = &window->FrameIndex;
+        info.pImageIndices = &frame.imageIndex;
+
+        // Id ,   vkWaitForPresentKHR ,    
+        PresentSample sample;
+        sample.frameValue = frame.timelineValue;
+        sample.input = inputTime;
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        VkPresentIdKHR id{};
+        id.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        id.swapchainCount = 1;
+        id.pPresentIds = &sample.presentId;
+        if (presentWait) {
+            sample.presentId = ++presentId;
+            info.pNext = &id;
+        }
+#endif
 
         VkResult result;
-        result = vkQueuePresentKHR(queue, &info);
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        result = queues.present(&info);
+        currentFrame = (currentFrame + 1) % framesInFlight; //  ,    FrameContext
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+            presentSamples.push_back(sample);
+            collectPresentLatency();
+        }
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
             swapChainRebuild = true;
             return;
         }
+        if (result == VK_SUBOPTIMAL_KHR) {
+            swapchainResize.suboptimal = true; //  ,       
+            return;
+        }
 
         checkVkResult(result);
-        window->SemaphoreIndex = (window->SemaphoreIndex + 1) % window->SemaphoreCount;
     }
 
+    /*
+    *      simulation.tickSeconds(),         .
+    *       ,       .
+    *        jobs.schedule(..., &updateJobs)  jobs.parallelFor,
+    * runSimulation  updateJobs   .     simulation.alpha()
+    */
     void Core::update(uint32_t tick) {
-        //LOG_INFO(SS("Current tick: " << tick << ".\n"));
+        //LOG_DEBUG(Core, "Current tick: {}", tick);
+        systems.run(world, jobs, tick, simulation.tickSeconds());
     }
 
     void Core::start() {
+        jobs.initialize(jobThreads);
+        simulation.configure(tickRate, maxTicksPerFrame, maxFrameTime, ticksPerFrame);
+        pacer.setTargetFps(targetFps);
+    }
+}
 
+/*
+*       --name=value
+*/
+static const char* findArgument(int argc, char** argv, const char* name) {
+    const size_t length = strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], name, length) == 0 && argv[i][length] == '=') {
+            return argv[i] + length + 1;
+        }
     }
+
+    return nullptr;
 }
 
-int main(int, char**)
+int main(int argc, char** argv)
 {
-#ifdef NDEBUG
+#if defined(NDEBUG) && defined(_WIN32)
     HWND hWnd = GetConsoleWindow();
     ShowWindow(hWnd, SW_HIDE);
 #endif // NDEBUG
 
-    static auto core = std::make_unique<Engine::Core>();
+    //  :      
+    Engine::Log::Settings logSettings;
+    if (const char* value = findArgument(argc, argv, "--log-file")) {
+        logSettings.file = value;
+    }
+    if (const char* value = findArgument(argc, argv, "--log-sync")) {
+        logSettings.async = atoi(value) == 0;
+    }
+    Engine::Log::initialize(logSettings);
+    if (const char* value = findArgument(argc, argv, "--log")) {
+        Engine::Log::configure(value); // --log=info,jobs=debug,device=warn
+    }
 
-    if (!glfwInit())
-        return 1;
+    //     ,  tools/binlog_decode
+    Engine::BinaryLog::Settings binaryLogSettings;
+    if (const char* value = findArgument(argc, argv, "--binlog")) {
+        binaryLogSettings.path = value;
+    }
+    if (const char* value = findArgument(argc, argv, "--binlog-level")) {
+        binaryLogSettings.level = spdlog::level::from_str(value);
+    }
+    if (const char* value = findArgument(argc, argv, "--flight-recorder")) {
+        binaryLogSettings.flightRecorderSeconds = std::max(0.0, atof(value)); //  N      
+    }
+    if (const char* value = findArgument(argc, argv, "--flight-recorder-file")) {
+        binaryLogSettings.flightRecorderPath = value;
+    }
+    if (!binaryLogSettings.path.empty() || binaryLogSettings.flightRecorderSeconds > 0.0) {
+        Engine::BinaryLog::initialize(binaryLogSettings);
+    }
 
-    // Create window with Vulkan context
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    GLFWwindow* window = glfwCreateWindow(1280, 720, "Vulkan Engine", nullptr, nullptr);
-    if (!glfwVulkanSupported())
-    {
-        printf("GLFW: Vulkan Not Supported\n");
-        return 1;
+    static auto core = std::make_unique<Engine::Core>();
+
+    if (const char* value = findArgument(argc, argv, "--frames-in-flight")) {
+        core->framesInFlight = (uint32_t)std::clamp(atoi(value), 1, 3); //       
     }
+    if (const char* value = findArgument(argc, argv, "--pipeline-cache")) {
+        core->pipelineCachePath = value;
+    }
+    if (const char* value = findArgument(argc, argv, "--device")) {
+        core->preferredDevice = value; //     
+    }
+    if (const char* value = findArgument(argc, argv, "--sync")) {
+        core->syncMode = strcmp(value, "fences") == 0 ? Engine::FrameSyncMode::Fences : Engine::FrameSyncMode::Timeline;
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-streaming")) {
+        core->imguiStreamingBuffer = atoi(value) != 0;
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-state-tracking")) {
+        core->imguiStateTracking = atoi(value) != 0;
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-bindless")) {
+        core->imguiBindless = atoi(value) != 0; //    ,    
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-textures")) {
+        core->imguiMaxTextures = (uint32_t)std::max(1, atoi(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-cache")) {
+        core->imguiCache.setEnabled(atoi(value) != 0);
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-cache-max-age")) {
+        core->imguiCache.setMaxAge((uint32_t)std::max(0, atoi(value))); //     version      N 
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-parallel")) {
+        core->imguiParallel = atoi(value) != 0;
+    }
+    if (const char* value = findArgument(argc, argv, "--imgui-parallel-min")) {
+        core->imguiParallelMinCommands = (uint32_t)atoi(value);
+    }
+    if (const char* value = findArgument(argc, argv, "--idle")) {
+        core->idleSkipping = atoi(value) != 0; //       
+    }
+    if (const char* value = findArgument(argc, argv, "--idle-keep-alive")) {
+        core->idleKeepAliveMs = std::max(1.0, atof(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--resize-interval")) {
+        core->resizeIntervalMs = std::max(0.0, atof(value)); // 0 -     
+    }
+    int headlessWidth = 1280, headlessHeight = 720;
+    if (const char* value = findArgument(argc, argv, "--headless")) {
+        core->headless = true; // --headless=1920x1080,  ,   
+        if (sscanf(value, "%dx%d", &headlessWidth, &headlessHeight) != 2 || headlessWidth <= 0 || headlessHeight <= 0) {
+            headlessWidth = 1280;
+            headlessHeight = 720;
+        }
+    }
+    if (const char* value = findArgument(argc, argv, "--frames")) {
+        core->frameLimit = (uint64_t)std::max(0ll, atoll(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--dump-frames")) {
+        core->frameDumpDirectory = value; //   PPM,   
+    }
+    if (const char* value = findArgument(argc, argv, "--dump-every")) {
+        core->frameDumpEvery = (uint32_t)std::max(1, atoi(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--jobs")) {
+        core->jobThreads = (uint32_t)std::max(0, atoi(value) - 1); //     
+    }
+    if (const char* value = findArgument(argc, argv, "--tick-rate")) {
+        core->tickRate = std::clamp(atof(value), 1.0, 10000.0);
+    }
+    if (const char* value = findArgument(argc, argv, "--max-ticks-per-frame")) {
+        core->maxTicksPerFrame = (uint32_t)std::max(1, atoi(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--ticks-per-frame")) {
+        core->ticksPerFrame = (uint32_t)std::max(0, atoi(value)); //  ,   
+    }
+    else if (core->headless) {
+        core->ticksPerFrame = 1; //     :   
+    }
+    if (const char* value = findArgument(argc, argv, "--present")) {
+        VkPresentModeKHR mode;
+        if (Engine::parsePresentMode(value, mode)) {
+            core->presentModePreference.insert(core->presentModePreference.begin(), mode); //   ,    
+        }
+    }
+    if (const char* value = findArgument(argc, argv, "--fps-limit")) {
+        core->targetFps = std::max(0.0, atof(value));
+    }
+    if (const char* value = findArgument(argc, argv, "--max-queued-presents")) {
+        core->maxQueuedPresents = (uint32_t)std::max(0, atoi(value)); // 1 -  ,  present wait
+    }
+    if (const char* value = findArgument(argc, argv, "--host-allocator")) {
+        core->hostAllocatorEnabled = atoi(value) != 0;
+    }
+    if (const char* value = findArgument(argc, argv, "--host-arenas")) {
+        core->hostAllocator.setArenas(atoi(value) != 0); // 0 -      malloc,  
+    }
+#ifdef ENGINE_PROFILER
+    const char* profileTrace = findArgument(argc, argv, "--profile-trace"); // Chrome trace    
+#endif
+    const char* memoryReport = findArgument(argc, argv, "--memory-report"); // JSON     
+    const char* benchmark = findArgument(argc, argv, "--bench");
+
+    PROFILE_THREAD("Main");
+    core->start();
 
+    GLFWwindow* window = nullptr;
     std::vector<const char*> extensions;
-    uint32_t extensionsCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&extensionsCount);
-    
-    for (uint32_t i = 0; i < extensionsCount; i++) {
-        extensions.push_back(glfwExtensions[i]);
-    }
-    core->vulkanInitialize(extensions);
+    if (!core->headless) {
+        if (!glfwInit())
+            return 1;
+
+        // Create window with Vulkan context
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        window = glfwCreateWindow(1280, 720, "Vulkan Engine", nullptr, nullptr);
+        if (!glfwVulkanSupported())
+        {
+            printf("GLFW: Vulkan Not Supported\n");
+            return 1;
+        }
 
-    // Create Window Surface
-    VkSurfaceKHR surface;
-    VkResult result = glfwCreateWindowSurface(core->instance, window, core->allocator, &surface);
-    core->checkVkResult(result);
+        uint32_t extensionsCount = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&extensionsCount);
+
+        for (uint32_t i = 0; i < extensionsCount; i++) {
+            extensions.push_back(glfwExtensions[i]);
+        }
+    }
+    core->window = window;
+    core->vulkanInitialize(extensions, window);
+    VkResult result;
 
     // Create Framebuffers
-    int width, height;
-    glfwGetFramebufferSize(window, &width, &height);
     ImGui_ImplVulkanH_Window* imguiWindow = &core->imguiWindowData;
-    core->createVulkanSurface(imguiWindow, surface, width, height);
+    if (core->headless) {
+        core->createOffscreenTarget(imguiWindow, headlessWidth, headlessHeight);
+    }
+    else {
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        core->createVulkanSurface(imguiWindow, core->surface, width, height);
+    }
+    core->createFrameContexts();
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
@@ -446,13 +838,23 @@ int main(int, char**)
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 
+#ifdef _WIN32
     io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\Arial.ttf", 15, NULL, io.Fonts->GetGlyphRangesCyrillic());
+#endif //      ImGui,  
     // Setup Dear ImGui style
     ImGui::StyleColorsDark();
     //ImGui::StyleColorsLight();
 
     // Setup Platform/Renderer backends
-    ImGui_ImplGlfw_InitForVulkan(window, true);
+    if (!core->headless) {
+        ImGui_ImplGlfw_InitForVulkan(window, true);
+
+        //   -      :   ,     
+        glfwSetWindowUserPointer(window, core.get());
+        glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) {
+            ((Engine::Core*)glfwGetWindowUserPointer(window))->idleForceRender = true;
+        });
+    }
     ImGui_ImplVulkan_InitInfo info{};
     info.Instance = core->instance;
     info.PhysicalDevice = core->physicalDevice;
@@ -464,37 +866,78 @@ int main(int, char**)
     info.RenderPass = imguiWindow->RenderPass;
     info.Subpass = 0;
     info.MinImageCount = core->minImageCount;
-    info.ImageCount = imguiWindow->ImageCount;
+    info.ImageCount = std::max(imguiWindow->ImageCount, core->framesInFlight); //   ImGui      
     info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
     info.Allocator = core->allocator;
     info.CheckVkResultFn = core->checkVkResult;
-    ImGui_ImplVulkan_Init(&info);
+    info.AllocateMemoryFn = Engine::Core::imguiAllocateMemory;
+    info.FreeMemoryFn = Engine::Core::imguiFreeMemory;
+    info.MemoryUserData = core.get();
+    info.ReleaseBufferFn = Engine::Core::imguiReleaseBuffer;
+    info.UseStreamingBuffer = core->imguiStreamingBuffer;
+    info.UseStateTracking = core->imguiStateTracking;
+    // Bindless SPIR-V       spirv-val,       --imgui-bindless=1
+    core->imguiBindlessCreated = core->imguiBindless && core->bindlessSupported;
+    info.UseBindless = core->imguiBindlessCreated; //    SetUseBindless
+    info.BindlessMaxTextures = std::min(core->bindlessMaxTextures, core->imguiMaxTextures);
+    if (core->uploadService.isInitialized()) {
+        info.UploadTextureFn = Engine::Core::imguiUploadTexture; //     transfer   vkQueueWaitIdle
+        info.UploadUserData = core.get();
+        info.UploadQueueFamily = core->getQueue(Engine::QueueType::Transfer).family;
+    }
+    const auto pipelineStart = std::chrono::steady_clock::now();
+    ImGui_ImplVulkan_Init(&info); //    ImGui,         
+    core->startupTimings.pipelineCreateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pipelineStart).count();
+    core->reportStartupTimings();
+    core->imguiBindless = core->imguiBindlessCreated;
+    ImGui_ImplVulkan_SetUseBindless(core->imguiBindless);
 
     bool showDemoWindow = true;
     bool showAnotherWindow = false;
     ImVec4 clearColor = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
-    uint32_t tick = 0;
+    uint64_t frameCount = 0;
+
+    if (benchmark != nullptr) {
+        core->runBenchmark(benchmark); //    
+        goto shutdown;
+    }
+
+    core->simulation.reset(Engine::SimulationClock::Clock::now()); //       
+
     //  
-    while (!glfwWindowShouldClose(window))
+    while (core->headless || !glfwWindowShouldClose(window))
     {
-        glfwPollEvents();
-
-        /*core->update(tick);
-        tick++;*/
-        //    
-        int frameWidth, frameHeight;
-        glfwGetFramebufferSize(window, &frameWidth, &frameHeight);
-        if (frameWidth > 0 && frameHeight > 0 && (core->swapChainRebuild || core->imguiWindowData.Width != frameWidth || core->imguiWindowData.Height != frameHeight))
-        {
-            ImGui_ImplVulkan_SetMinImageCount(core->minImageCount);
-            ImGui_ImplVulkanH_CreateOrResizeWindow(core->instance, core->physicalDevice, core->logicalDevice, &core->imguiWindowData, core->queueFamily, core->allocator, frameWidth, frameHeight, core->minImageCount);
-            core->imguiWindowData.FrameIndex = 0;
-            core->swapChainRebuild = false;
+        if (core->frameLimit != 0 && frameCount >= core->frameLimit)
+            break;
+        frameCount++;
+#ifdef ENGINE_PROFILER
+        Engine::profiler().newFrame();
+#endif
+        PROFILE_SCOPE("frame");
+
+        bool canDraw = true;
+        if (core->headless) {
+            io.DisplaySize = ImVec2((float)imguiWindow->Width, (float)imguiWindow->Height);
+            io.DeltaTime = (float)(core->simulation.ticksPerFrame() * core->simulation.tickSeconds()); //  :     
+        }
+        else {
+            core->pollEvents();
+            core->inputTime = std::chrono::steady_clock::now();
+
+            //   ,      
+            int frameWidth, frameHeight;
+            glfwGetFramebufferSize(window, &frameWidth, &frameHeight);
+            canDraw = core->updateSwapchain(frameWidth, frameHeight);
         }
 
+        //     ,      
+        core->runSimulation();
+        core->transforms.update(core->jobs);
 
         ImGui_ImplVulkan_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        if (!core->headless) {
+            ImGui_ImplGlfw_NewFrame();
+        }
         ImGui::NewFrame();
 
         {
@@ -518,37 +961,142 @@ int main(int, char**)
                 goto shutdown;
 
             ImGui::Text(u8": %.1f", io.Framerate);
+            ImGui::Text(u8": %llu, alpha %.2f", (unsigned long long)core->simulation.tick(), core->simulation.alpha());
+            ImGui::Text(u8": %llu, : %llu", (unsigned long long)core->world.size(), (unsigned long long)core->systems.size());
+
+            if (!core->headless) {
+                //        
+                const VkPresentModeKHR modes[] = { VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };
+                if (ImGui::BeginCombo(u8"", Engine::presentModeName(imguiWindow->PresentMode))) {
+                    for (VkPresentModeKHR mode : modes) {
+                        const bool supported = std::find(core->supportedPresentModes.begin(), core->supportedPresentModes.end(), mode) != core->supportedPresentModes.end();
+                        if (ImGui::Selectable(Engine::presentModeName(mode), mode == imguiWindow->PresentMode, supported ? 0 : ImGuiSelectableFlags_Disabled)) {
+                            core->setPresentMode(mode);
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+
+                float fpsLimit = (float)core->targetFps;
+                if (ImGui::InputFloat(u8" ", &fpsLimit, 10.0f, 30.0f, "%.0f", ImGuiInputTextFlags_EnterReturnsTrue)) {
+                    core->targetFps = std::max(0.0f, fpsLimit);
+                    core->pacer.setTargetFps(core->targetFps);
+                }
+
+                ImGui::Text(u8" : %.1f ,  %.1f  (%s)", core->lastLatency.average(), core->lastLatency.maxMs, core->presentWait ? "present wait" : u8"  GPU");
+
+                //     : ,      ,    
+                ImGui::Checkbox(u8" ", &core->idleSkipping);
+            }
+
+#ifdef ENGINE_PROFILER
+            ImGui::Checkbox(u8"", &core->showProfiler);
+            ImGui::SameLine();
+#endif
+            ImGui::Checkbox(u8"", &core->showMemory);
+            ImGui::SameLine();
+            ImGui::Checkbox(u8"  ImGui", &core->imguiParallel);
+            if (ImGui::Checkbox(u8"  ", &core->imguiStateTracking)) {
+                ImGui_ImplVulkan_SetUseStateTracking(core->imguiStateTracking);
+            }
+            if (core->imguiBindlessCreated) {
+                ImGui::SameLine();
+                if (ImGui::Checkbox("Bindless", &core->imguiBindless)) {
+                    ImGui_ImplVulkan_SetUseBindless(core->imguiBindless);
+                }
+            }
+            ImGui::Text(u8"ImGui: %d , %d , scissor %d ( %d),  %d ( %d)",
+                core->imguiRenderStats.DrawCommands, core->imguiRenderStats.DrawCalls, core->imguiRenderStats.ScissorsSet, core->imguiRenderStats.ScissorsSkipped,
+                core->imguiRenderStats.DescriptorSetsBound, core->imguiRenderStats.DescriptorSetsSkipped);
+
+            bool imguiCache = core->imguiCache.enabled();
+            if (ImGui::Checkbox(u8" ", &imguiCache)) {
+                core->imguiCache.setEnabled(imguiCache);
+            }
+            if (imguiCache) {
+                const Engine::ImGuiCacheStats stats = core->imguiCache.stats();
+                ImGui::SameLine();
+                ImGui::Text(u8" %llu,   %llu, %.1f ", (unsigned long long)stats.recorded, (unsigned long long)stats.replayed, stats.cachedBytes / 1024.0);
+            }
+
+            //      
+            if (ImGui::CollapsingHeader(u8"")) {
+                const char* levels[] = { "trace", "debug", "info", "warn", "error", "critical", "off" };
+                for (size_t i = 0; i < (size_t)Engine::LogChannel::Count; i++) {
+                    const Engine::LogChannel channel = (Engine::LogChannel)i;
+                    int level = (int)Engine::Log::level(channel);
+                    if (ImGui::Combo(Engine::logChannelName(channel), &level, levels, IM_ARRAYSIZE(levels))) {
+                        Engine::Log::setLevel(channel, (spdlog::level::level_enum)level);
+                    }
+                }
+                ImGui::Text(u8"  : %llu", (unsigned long long)Engine::Log::dropped());
+
+                if (Engine::BinaryLog::isRunning()) {
+                    const Engine::BinaryLog::Stats stats = Engine::BinaryLog::stats();
+                    ImGui::Text(u8" : %llu ,  %llu,  %.1f ,  %.1f ", (unsigned long long)stats.events, (unsigned long long)stats.dropped, stats.bytesWritten / 1048576.0, stats.flightRecorderBytes / 1048576.0);
+                    if (ImGui::Button(u8" ")) {
+                        Engine::BinaryLog::dumpFlightRecorder();
+                    }
+                }
+            }
 
             ImGui::End();
         }
+        if (core->showProfiler) {
+            Engine::profiler().drawWindow(&core->showProfiler);
+        }
+        if (core->showMemory) {
+            core->drawMemoryWindow(&core->showMemory);
+        }
 
-        ImGui::Render();
+        {
+            PROFILE_SCOPE("ImGui::Render");
+            ImGui::Render();
+        }
         ImDrawData* draw_data = ImGui::GetDrawData();
         const bool is_minimized = (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f);
-        if (!is_minimized)
+        if (!is_minimized && canDraw)
         {
             imguiWindow->ClearValue.color.float32[0] = clearColor.x * clearColor.w;
             imguiWindow->ClearValue.color.float32[1] = clearColor.y * clearColor.w;
             imguiWindow->ClearValue.color.float32[2] = clearColor.z * clearColor.w;
             imguiWindow->ClearValue.color.float32[3] = clearColor.w;
-            core->frameRender(imguiWindow, draw_data);
-            core->framePresent(imguiWindow);
+            if (core->headless || core->frameChanged(imguiWindow, draw_data)) {
+                core->frameRender(imguiWindow, draw_data);
+                core->framePresent(imguiWindow);
+            }
         }
     }
 
 shutdown:
     result = vkDeviceWaitIdle(core->logicalDevice);
     core->checkVkResult(result);
+#ifdef ENGINE_PROFILER
+    if (profileTrace != nullptr) {
+        Engine::profiler().newFrame(); //   
+        Engine::profiler().writeChromeTrace(profileTrace);
+    }
+#endif
+    if (memoryReport != nullptr) {
+        core->writeMemoryReport(memoryReport); //    ImGui:     
+    }
 
     ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    if (!core->headless) {
+        ImGui_ImplGlfw_Shutdown();
+    }
     ImGui::DestroyContext();
 
     core->cleanupWindow();
     core->cleanupVulkan();
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (!core->headless) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+    core->jobs.shutdown();
+    Engine::BinaryLog::shutdown();
+    Engine::Log::shutdown();
 
     return 0;
 }
@@ -0,0 +1,1314 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+/*
+*  ,   --bench=<>   .
+*    printf,          
+*/
+
+namespace Engine {
+    /*
+    *    ImGui:   4 ,
+    *   65536    - 16  
+    */
+    static void buildDrawLists(std::vector<ImDrawList*>& lists, ImDrawData& drawData, int vertexCount, float width, float height) {
+        const int verticesPerList = 60000;
+
+        drawData.Clear();
+        drawData.Valid = true;
+        drawData.DisplayPos = ImVec2(0.0f, 0.0f);
+        drawData.DisplaySize = ImVec2(width, height);
+        drawData.FramebufferScale = ImVec2(1.0f, 1.0f);
+
+        for (int listIndex = 0; listIndex * verticesPerList < vertexCount; listIndex++) {
+            if ((int)lists.size() <= listIndex) {
+                lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+            }
+
+            ImDrawList* list = lists[listIndex];
+            list->_ResetForNewFrame();
+            list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(width, height));
+            list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+            const int rects = std::min(verticesPerList, vertexCount - listIndex * verticesPerList) / 4;
+            list->PrimReserve(rects * 6, rects * 4);
+            for (int i = 0; i < rects; i++) {
+                const float x = (float)(i % 256) * 4.0f;
+                const float y = (float)(i / 256 % 256) * 2.0f;
+                list->PrimRect(ImVec2(x, y), ImVec2(x + 3.0f, y + 1.0f), IM_COL32(255, 255, 255, 8));
+            }
+
+            list->PopTextureID();
+            list->PopClipRect();
+            drawData.AddDrawList(list);
+        }
+    }
+
+    /*
+    *  :    ,     ,     
+    */
+    static void buildWindowDrawLists(std::vector<ImDrawList*>& lists, ImDrawData& drawData, int windowCount, int commandsPerWindow, float width, float height) {
+        drawData.Clear();
+        drawData.Valid = true;
+        drawData.DisplayPos = ImVec2(0.0f, 0.0f);
+        drawData.DisplaySize = ImVec2(width, height);
+        drawData.FramebufferScale = ImVec2(1.0f, 1.0f);
+
+        for (int windowIndex = 0; windowIndex < windowCount; windowIndex++) {
+            if ((int)lists.size() <= windowIndex) {
+                lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+            }
+
+            ImDrawList* list = lists[windowIndex];
+            list->_ResetForNewFrame();
+            list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+            const float x = (float)(windowIndex % 20) * (width / 20.0f);
+            const float y = (float)(windowIndex / 20 % 20) * (height / 20.0f);
+            for (int i = 0; i < commandsPerWindow; i++) {
+                const float offset = (float)(i % 16);
+                list->PushClipRect(ImVec2(x + offset, y), ImVec2(x + offset + 40.0f, y + 30.0f));
+                for (int rect = 0; rect < 4; rect++) {
+                    list->AddRectFilled(ImVec2(x + rect * 8.0f, y + offset), ImVec2(x + rect * 8.0f + 6.0f, y + offset + 4.0f), IM_COL32(255, 255, 255, 32));
+                }
+                list->PopClipRect();
+            }
+            list->PopTextureID();
+            drawData.AddDrawList(list);
+        }
+    }
+
+    /*
+    *  :          ,     .
+    *     ,       
+    */
+    static void buildThumbnailDrawLists(std::vector<ImDrawList*>& lists, ImDrawData& drawData, const std::vector<VkDescriptorSet>& textures, int windowCount, int thumbnailsPerWindow, float width, float height) {
+        const float cell = 24.0f;
+
+        drawData.Clear();
+        drawData.Valid = true;
+        drawData.DisplayPos = ImVec2(0.0f, 0.0f);
+        drawData.DisplaySize = ImVec2(width, height);
+        drawData.FramebufferScale = ImVec2(1.0f, 1.0f);
+
+        const int columns = std::max(1, (int)(width / (cell * 16.0f)));
+        const int rows = std::max(1, (int)(height / (cell * 16.0f))); //    ,    
+        for (int windowIndex = 0; windowIndex < windowCount; windowIndex++) {
+            if ((int)lists.size() <= windowIndex) {
+                lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+            }
+
+            ImDrawList* list = lists[windowIndex];
+            list->_ResetForNewFrame();
+            const float x = (float)(windowIndex % columns) * cell * 16.0f;
+            const float y = (float)(windowIndex / columns % rows) * cell * 16.0f;
+            list->PushClipRect(ImVec2(x, y), ImVec2(x + cell * 16.0f, y + cell * 16.0f));
+            list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+            for (int i = 0; i < thumbnailsPerWindow; i++) {
+                const ImVec2 min(x + (float)(i % 16) * cell, y + (float)(i / 16 % 16) * cell);
+                const ImVec2 max(min.x + cell - 2.0f, min.y + cell - 2.0f);
+                list->PushClipRect(min, max, true);
+                list->AddImage((ImTextureID)textures[(windowIndex * thumbnailsPerWindow + i) % textures.size()], min, ImVec2(max.x, max.y - 6.0f));
+                list->AddRectFilled(ImVec2(min.x, max.y - 5.0f), max, IM_COL32(255, 255, 255, 96)); // 
+                list->PopClipRect();
+            }
+            list->PopTextureID();
+            list->PopClipRect();
+            drawData.AddDrawList(list);
+        }
+    }
+
+    /*
+    *   ImGui:   (map/memcpy/flush/unmap     )
+    *      .   CPU  ImGui_ImplVulkan_RenderDrawData,
+    *    GPU,      fence
+    */
+    void Core::benchmarkImguiUpload() {
+        const int vertexCounts[] = { 10000, 100000, 1000000 };
+        const int iterations = 200;
+
+        ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        std::vector<ImDrawList*> lists;
+        ImDrawData drawData;
+
+        printf("imgui-upload: %d frames per case, %u frames in flight\n", iterations, framesInFlight);
+        printf("%10s %14s %14s %10s\n", "vertices", "legacy ms", "streaming ms", "speedup");
+
+        for (int vertexCount : vertexCounts) {
+            buildDrawLists(lists, drawData, vertexCount, (float)window->Width, (float)window->Height);
+
+            double averageMs[2] = {};
+            for (int mode = 0; mode < 2; mode++) {
+                ImGui_ImplVulkan_SetUseStreamingBuffer(mode == 1);
+
+                double totalMs = 0.0;
+                for (int i = 0; i < iterations + 1; i++) {
+                    FrameContext& frame = frames[currentFrame];
+                    VkResult result = vkWaitForFences(logicalDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+                    checkVkResult(result);
+                    result = vkResetFences(logicalDevice, 1, &frame.fence);
+                    checkVkResult(result);
+                    result = vkResetCommandPool(logicalDevice, frame.commandPool, 0);
+                    checkVkResult(result);
+
+                    VkCommandBufferBeginInfo beginInfo{};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                    result = vkBeginCommandBuffer(frame.commandBuffer, &beginInfo);
+                    checkVkResult(result);
+
+                    VkRenderPassBeginInfo passInfo{};
+                    passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                    passInfo.renderPass = window->RenderPass;
+                    passInfo.framebuffer = window->Frames[0].Framebuffer;
+                    passInfo.renderArea.extent.width = window->Width;
+                    passInfo.renderArea.extent.height = window->Height;
+                    passInfo.clearValueCount = 1;
+                    passInfo.pClearValues = &window->ClearValue;
+                    vkCmdBeginRenderPass(frame.commandBuffer, &passInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+                    const auto start = std::chrono::steady_clock::now();
+                    ImGui_ImplVulkan_RenderDrawData(&drawData, frame.commandBuffer);
+                    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    if (i > 0) {
+                        totalMs += ms; //    ,   
+                    }
+
+                    vkCmdEndRenderPass(frame.commandBuffer);
+                    result = vkEndCommandBuffer(frame.commandBuffer);
+                    checkVkResult(result);
+
+                    VkSubmitInfo submitInfo{};
+                    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                    submitInfo.commandBufferCount = 1;
+                    submitInfo.pCommandBuffers = &frame.commandBuffer;
+                    result = submit(QueueType::Graphics, 1, &submitInfo, frame.fence);
+                    checkVkResult(result);
+
+                    currentFrame = (currentFrame + 1) % framesInFlight;
+                }
+
+                averageMs[mode] = totalMs / iterations;
+            }
+
+            printf("%10d %14.3f %14.3f %9.2fx\n", drawData.TotalVtxCount, averageMs[0], averageMs[1], averageMs[0] / averageMs[1]);
+        }
+
+        VkResult result = vkDeviceWaitIdle(logicalDevice);
+        checkVkResult(result);
+        for (ImDrawList* list : lists) {
+            IM_DELETE(list);
+        }
+    }
+
+    /*
+    *    ImGui:              .
+    *   CPU    (recordImgui),    GPU
+    */
+    void Core::benchmarkImguiParallel() {
+        const int windowCounts[] = { 50, 200, 800 };
+        const int commandsPerWindow = 100;
+        const int iterations = 200;
+
+        ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        std::vector<ImDrawList*> lists;
+        ImDrawData drawData;
+        const bool parallel = imguiParallel;
+        const uint32_t minCommands = imguiParallelMinCommands;
+        imguiParallelMinCommands = 0;
+
+        printf("imgui-parallel: %d frames per case, %d commands per window, %u threads\n", iterations, commandsPerWindow, jobs.threadCount());
+        printf("%10s %10s %14s %14s %10s\n", "windows", "commands", "serial ms", "parallel ms", "speedup");
+
+        for (int windowCount : windowCounts) {
+            buildWindowDrawLists(lists, drawData, windowCount, commandsPerWindow, (float)window->Width, (float)window->Height);
+            int commandCount = 0;
+            for (int i = 0; i < drawData.CmdListsCount; i++) {
+                commandCount += drawData.CmdLists[i]->CmdBuffer.Size;
+            }
+
+            double averageMs[2] = {};
+            for (int mode = 0; mode < 2; mode++) {
+                imguiParallel = mode == 1;
+
+                double totalMs = 0.0;
+                for (int i = 0; i < iterations + 1; i++) {
+                    FrameContext& frame = frames[currentFrame];
+                    VkResult result = vkWaitForFences(logicalDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+                    checkVkResult(result);
+                    result = vkResetFences(logicalDevice, 1, &frame.fence);
+                    checkVkResult(result);
+                    result = vkResetCommandPool(logicalDevice, frame.commandPool, 0);
+                    checkVkResult(result);
+
+                    VkCommandBufferBeginInfo beginInfo{};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                    result = vkBeginCommandBuffer(frame.commandBuffer, &beginInfo);
+                    checkVkResult(result);
+
+                    frame.imageIndex = 0;
+                    const auto start = std::chrono::steady_clock::now();
+                    recordImgui(frame, window, &drawData);
+                    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    if (i > 0) {
+                        totalMs += ms; //      ,   
+                    }
+
+                    result = vkEndCommandBuffer(frame.commandBuffer);
+                    checkVkResult(result);
+
+                    VkSubmitInfo submitInfo{};
+                    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                    submitInfo.commandBufferCount = 1;
+                    submitInfo.pCommandBuffers = &frame.commandBuffer;
+                    result = submit(QueueType::Graphics, 1, &submitInfo, frame.fence);
+                    checkVkResult(result);
+
+                    currentFrame = (currentFrame + 1) % framesInFlight;
+                }
+
+                averageMs[mode] = totalMs / iterations;
+            }
+
+            printf("%10d %10d %14.3f %14.3f %9.2fx\n", windowCount, commandCount, averageMs[0], averageMs[1], averageMs[0] / averageMs[1]);
+        }
+
+        imguiParallel = parallel;
+        imguiParallelMinCommands = minCommands;
+        VkResult result = vkDeviceWaitIdle(logicalDevice);
+        checkVkResult(result);
+        for (ImDrawList* list : lists) {
+            IM_DELETE(list);
+        }
+    }
+
+    /*
+    *     :  ,      bindless,
+    *        vkCmdDrawIndexedIndirect.   CPU  
+    */
+    void Core::benchmarkImguiThumbnails() {
+        const int windowCount = 16;
+        const int thumbnailsPerWindow = 256;
+        const uint32_t imageSize = 16;
+        const int iterations = 200;
+
+        if (!uploadService.isInitialized()) {
+            printf("imgui-thumbnails needs the upload service, skipped\n");
+            return;
+        }
+
+        //   ,     (   )    bindless 
+        uint32_t textureCount = std::min<uint32_t>(512, imguiMaxTextures - 1);
+        if (imguiBindlessCreated) {
+            textureCount = std::min(textureCount, std::min(bindlessMaxTextures, imguiMaxTextures) - 1);
+        }
+        if (textureCount == 0) {
+            printf("imgui-thumbnails needs --imgui-textures above 1, skipped\n");
+            return;
+        }
+
+        struct Thumbnail {
+            VkImage image = VK_NULL_HANDLE;
+            VkImageView view = VK_NULL_HANDLE;
+            MemoryAllocation memory;
+        };
+        std::vector<Thumbnail> thumbnails(textureCount);
+        std::vector<VkDescriptorSet> textures(textureCount);
+        std::vector<uint32_t> pixels(imageSize * imageSize);
+
+        VkResult result;
+        VkSampler sampler;
+        {
+            VkSamplerCreateInfo info{};
+            info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+            info.magFilter = VK_FILTER_LINEAR;
+            info.minFilter = VK_FILTER_LINEAR;
+            info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+            info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+            info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+            info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+            info.maxLod = 1.0f;
+            result = vkCreateSampler(logicalDevice, &info, allocator, &sampler);
+            checkVkResult(result);
+        }
+
+        //  transfer ,  :   ,    
+        const uint32_t families[2] = { queueFamily, uploadService.queueFamily() };
+        for (uint32_t i = 0; i < textureCount; i++) {
+            Thumbnail& thumbnail = thumbnails[i];
+            {
+                VkImageCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                info.imageType = VK_IMAGE_TYPE_2D;
+                info.format = VK_FORMAT_R8G8B8A8_UNORM;
+                info.extent = { imageSize, imageSize, 1 };
+                info.mipLevels = 1;
+                info.arrayLayers = 1;
+                info.samples = VK_SAMPLE_COUNT_1_BIT;
+                info.tiling = VK_IMAGE_TILING_OPTIMAL;
+                info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+                info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                if (families[0] != families[1]) {
+                    info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+                    info.queueFamilyIndexCount = 2;
+                    info.pQueueFamilyIndices = families;
+                }
+                info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                result = vkCreateImage(logicalDevice, &info, allocator, &thumbnail.image);
+                checkVkResult(result);
+
+                VkMemoryRequirements requirements;
+                vkGetImageMemoryRequirements(logicalDevice, thumbnail.image, &requirements);
+                if (!memoryAllocator.allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, thumbnail.memory)) {
+                    callback(3, "can't allocate thumbnail image");
+                    abort();
+                }
+                result = vkBindImageMemory(logicalDevice, thumbnail.image, thumbnail.memory.memory, thumbnail.memory.offset);
+                checkVkResult(result);
+            }
+            {
+                VkImageViewCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                info.image = thumbnail.image;
+                info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                info.format = VK_FORMAT_R8G8B8A8_UNORM;
+                info.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+                result = vkCreateImageView(logicalDevice, &info, allocator, &thumbnail.view);
+                checkVkResult(result);
+            }
+
+            //   ,      
+            const uint32_t color = IM_COL32((i * 37) & 255, (i * 91) & 255, (i * 53) & 255, 255);
+            for (uint32_t p = 0; p < imageSize * imageSize; p++) {
+                pixels[p] = ((p % imageSize) / 4 + (p / imageSize) / 4) % 2 ? color : IM_COL32_WHITE;
+            }
+            uploadService.uploadImage(thumbnail.image, imageSize, imageSize, pixels.data(), pixels.size() * sizeof(uint32_t));
+            textures[i] = ImGui_ImplVulkan_AddTexture(sampler, thumbnail.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        uploadService.waitIdle(); //      
+
+        ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        std::vector<ImDrawList*> lists;
+        ImDrawData drawData;
+        buildThumbnailDrawLists(lists, drawData, textures, windowCount, thumbnailsPerWindow, (float)window->Width, (float)window->Height);
+
+        struct Mode {
+            const char* name;
+            bool stateTracking;
+            bool bindless;
+        };
+        const Mode modes[] = {
+            { "classic", false, false },
+            { "tracked", true, false },
+            { "bindless", true, true },
+        };
+        const bool parallel = imguiParallel;
+        const bool stateTracking = imguiStateTracking;
+        const bool bindless = imguiBindless;
+        imguiParallel = false; //   ,   
+
+        printf("imgui-thumbnails: %d frames per mode, %d thumbnails, %u textures\n", iterations, windowCount * thumbnailsPerWindow, textureCount);
+        printf("%10s %10s %10s %10s %10s %12s\n", "mode", "commands", "draws", "scissors", "sets", "record ms");
+
+        for (const Mode& mode : modes) {
+            if (mode.bindless && !imguiBindlessCreated) {
+                printf("%10s skipped, needs --imgui-bindless=1 and a device with descriptor indexing and multi draw indirect\n", mode.name);
+                continue;
+            }
+            ImGui_ImplVulkan_SetUseStateTracking(mode.stateTracking);
+            ImGui_ImplVulkan_SetUseBindless(mode.bindless);
+
+            double totalMs = 0.0;
+            for (int i = 0; i < iterations + 1; i++) {
+                FrameContext& frame = frames[currentFrame];
+                result = vkWaitForFences(logicalDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+                checkVkResult(result);
+                result = vkResetFences(logicalDevice, 1, &frame.fence);
+                checkVkResult(result);
+                result = vkResetCommandPool(logicalDevice, frame.commandPool, 0);
+                checkVkResult(result);
+
+                VkCommandBufferBeginInfo beginInfo{};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                result = vkBeginCommandBuffer(frame.commandBuffer, &beginInfo);
+                checkVkResult(result);
+
+                frame.imageIndex = 0;
+                const auto start = std::chrono::steady_clock::now();
+                recordImgui(frame, window, &drawData);
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (i > 0) {
+                    totalMs += ms; //    ,   
+                }
+
+                result = vkEndCommandBuffer(frame.commandBuffer);
+                checkVkResult(result);
+
+                VkSubmitInfo submitInfo{};
+                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers = &frame.commandBuffer;
+                result = submit(QueueType::Graphics, 1, &submitInfo, frame.fence);
+                checkVkResult(result);
+
+                currentFrame = (currentFrame + 1) % framesInFlight;
+            }
+
+            const ImGui_ImplVulkan_RenderStats& stats = imguiRenderStats;
+            printf("%10s %10d %10d %10d %10d %12.3f\n", mode.name, stats.DrawCommands, stats.DrawCalls, stats.ScissorsSet, stats.DescriptorSetsBound, totalMs / iterations);
+        }
+
+        imguiParallel = parallel;
+        imguiStateTracking = stateTracking;
+        imguiBindless = bindless;
+        ImGui_ImplVulkan_SetUseStateTracking(imguiStateTracking);
+        ImGui_ImplVulkan_SetUseBindless(imguiBindless);
+
+        result = vkDeviceWaitIdle(logicalDevice);
+        checkVkResult(result);
+        for (ImDrawList* list : lists) {
+            IM_DELETE(list);
+        }
+        for (uint32_t i = 0; i < textureCount; i++) {
+            ImGui_ImplVulkan_RemoveTexture(textures[i]);
+            vkDestroyImageView(logicalDevice, thumbnails[i].view, allocator);
+            vkDestroyImage(logicalDevice, thumbnails[i].image, allocator);
+            memoryAllocator.free(thumbnails[i].memory);
+        }
+        vkDestroySampler(logicalDevice, sampler, allocator);
+    }
+
+    /*
+    *   ImGui: 200    , ,   ,    .
+    *   CPU  ImGui  NewFrame  Render,     .   ,    
+    */
+    void Core::benchmarkImguiCache() {
+        const int windowCount = 200;
+        const int rowsPerWindow = 12;
+        const int iterations = 300;
+
+        std::vector<float> values(windowCount, 0.5f);
+        std::vector<bool> flags(windowCount, false);
+        const bool enabled = imguiCache.enabled();
+        ImGuiIO& io = ImGui::GetIO();
+
+        printf("imgui-cache: %d frames per mode, %d windows, one changes per frame\n", iterations, windowCount);
+        printf("%8s %12s %10s %10s %12s\n", "cache", "frame ms", "recorded", "replayed", "cached KiB");
+
+        double averageMs[2] = {};
+        for (int mode = 0; mode < 2; mode++) {
+            imguiCache.setEnabled(mode == 1);
+            imguiCache.resetStats();
+
+            double totalMs = 0.0;
+            ImGuiCacheStats warmup{};
+            for (int i = 0; i < iterations + 1; i++) {
+                const auto start = std::chrono::steady_clock::now();
+                io.DisplaySize = ImVec2((float)imguiWindowData.Width, (float)imguiWindowData.Height);
+                io.DeltaTime = 1.0f / 60.0f;
+                io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+                ImGui::NewFrame();
+
+                for (int w = 0; w < windowCount; w++) {
+                    char name[32];
+                    snprintf(name, sizeof(name), "Panel %d", w);
+                    ImGui::SetNextWindowPos(ImVec2((float)(w % 20) * 60.0f, (float)(w / 20) * 70.0f), ImGuiCond_Always);
+                    ImGui::SetNextWindowSize(ImVec2(220.0f, 160.0f), ImGuiCond_Always);
+
+                    //      windowCount , version    
+                    const uint64_t version = (uint64_t)((i + windowCount - w) / windowCount);
+                    if (imguiCache.begin(name, version, nullptr, ImGuiWindowFlags_NoSavedSettings)) {
+                        ImGui::Text("Panel %d, revision %llu", w, (unsigned long long)version);
+                        for (int row = 0; row < rowsPerWindow; row++) {
+                            ImGui::PushID(row);
+                            ImGui::SliderFloat("value", &values[w], 0.0f, 1.0f);
+                            bool flag = flags[w];
+                            ImGui::Checkbox("enabled", &flag);
+                            ImGui::SameLine();
+                            ImGui::Button("Apply");
+                            ImGui::ProgressBar(values[w] * (float)(version % 4 + 1) / 4.0f);
+                            ImGui::PopID();
+                        }
+                    }
+                    imguiCache.end();
+                }
+
+                ImGui::Render();
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (i > 0) {
+                    totalMs += ms; //    ,   
+                }
+                else {
+                    warmup = imguiCache.stats();
+                }
+            }
+
+            averageMs[mode] = totalMs / iterations;
+            const ImGuiCacheStats stats = imguiCache.stats();
+            printf("%8s %12.3f %10.1f %10.1f %12.1f\n", mode == 1 ? "on" : "off", averageMs[mode], (double)(stats.recorded - warmup.recorded) / iterations,
+                (double)(stats.replayed - warmup.replayed) / iterations, stats.cachedBytes / 1024.0);
+        }
+        printf("speedup %.2fx\n", averageMs[0] / averageMs[1]);
+
+        imguiCache.setEnabled(enabled);
+    }
+
+    /*
+    *   :        ,    .
+    *    (vkDeviceWaitIdle     ),   oldSwapchain
+    *        .   -   
+    */
+    void Core::benchmarkResizeStorm() {
+        struct Mode {
+            const char* name;
+            bool waitIdle;
+            double intervalMs;
+        };
+        const Mode modes[] = {
+            { "wait-idle", true, 0.0 },
+            { "handoff", false, 0.0 },
+            { "coalesced", false, resizeIntervalMs },
+        };
+        const int iterations = 300;
+        const double savedInterval = resizeIntervalMs;
+
+        int baseWidth, baseHeight;
+        glfwGetWindowSize(window, &baseWidth, &baseHeight);
+
+        printf("resize-storm: %d frames per mode, %u frames in flight, base %dx%d\n", iterations, framesInFlight, baseWidth, baseHeight);
+        printf("%10s %10s %10s %10s %12s %10s\n", "mode", "avg ms", "p99 ms", "worst ms", "recreations", "coalesced");
+
+        for (const Mode& mode : modes) {
+            resizeIntervalMs = mode.intervalMs;
+            const SwapchainStats before = swapchainStats;
+            std::vector<double> frameTimes;
+            frameTimes.reserve(iterations);
+
+            for (int i = 0; i < iterations; i++) {
+                //        ,     
+                const int width = baseWidth - 200 + (i % 50) * 8;
+                const int height = baseHeight - 120 + (i % 30) * 8;
+                glfwSetWindowSize(window, width, height);
+
+                const auto start = std::chrono::steady_clock::now();
+                glfwPollEvents();
+
+                int frameWidth, frameHeight;
+                glfwGetFramebufferSize(window, &frameWidth, &frameHeight);
+                if (mode.waitIdle && (frameWidth != imguiWindowData.Width || frameHeight != imguiWindowData.Height)) {
+                    VkResult result = vkDeviceWaitIdle(logicalDevice); //     ImGui_ImplVulkanH_CreateOrResizeWindow
+                    checkVkResult(result);
+                }
+                const bool canDraw = updateSwapchain(frameWidth, frameHeight);
+
+                ImGui_ImplVulkan_NewFrame();
+                ImGui_ImplGlfw_NewFrame();
+                ImGui::NewFrame();
+                //  ,     
+                ImGui::Begin("resize-storm");
+                ImGui::Text("%s: %dx%d, frame %d", mode.name, frameWidth, frameHeight, i);
+                ImGui::ProgressBar((float)(i + 1) / iterations);
+                ImGui::End();
+                ImGui::Render();
+                if (canDraw) {
+                    frameRender(&imguiWindowData, ImGui::GetDrawData());
+                    framePresent(&imguiWindowData);
+                }
+
+                frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            std::sort(frameTimes.begin(), frameTimes.end());
+            double sum = 0.0;
+            for (double time : frameTimes) {
+                sum += time;
+            }
+            const double p99 = frameTimes[(size_t)((frameTimes.size() - 1) * 0.99)];
+
+            printf("%10s %10.3f %10.3f %10.3f %12llu %10llu\n", mode.name, sum / frameTimes.size(), p99, frameTimes.back(),
+                (unsigned long long)(swapchainStats.recreations - before.recreations), (unsigned long long)(swapchainStats.coalescedEvents - before.coalescedEvents));
+        }
+
+        resizeIntervalMs = savedInterval;
+        glfwSetWindowSize(window, baseWidth, baseHeight);
+        VkResult result = vkDeviceWaitIdle(logicalDevice);
+        checkVkResult(result);
+    }
+
+    /*
+    *   :        parallelFor    ,
+    *      (schedule,   wait),     
+    */
+    void Core::benchmarkJobs() {
+        const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+        const uint32_t itemCount = 1 << 20;
+        const uint32_t tinyJobs = 100000;
+        const int runs = 10;
+
+        std::vector<glm::vec4> points(itemCount);
+        std::vector<float> results(itemCount);
+        for (uint32_t i = 0; i < itemCount; i++) {
+            points[i] = glm::vec4((float)(i % 1024), (float)(i / 1024), 1.0f, 1.0f);
+        }
+
+        std::vector<uint32_t> threadCounts;
+        for (uint32_t threads = 1; threads < cores; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(cores);
+
+        printf("jobs: %u items, median of %d runs, %u hardware threads\n", itemCount, runs, cores);
+        printf("%8s %12s %10s %11s %14s\n", "threads", "median ms", "speedup", "efficiency", "tiny jobs/ms");
+
+        double baseMs = 0.0;
+        for (uint32_t threads : threadCounts) {
+            jobs.shutdown();
+            jobs.initialize(threads - 1);
+
+            std::vector<double> times;
+            for (int run = 0; run < runs + 1; run++) {
+                const auto start = std::chrono::steady_clock::now();
+                jobs.parallelFor(itemCount, 0, [&](uint32_t begin, uint32_t end) {
+                    glm::mat4 transform(0.5f);
+                    transform[3] = glm::vec4(0.5f, 0.25f, 0.125f, 1.0f);
+                    for (uint32_t i = begin; i < end; i++) {
+                        glm::vec4 point = points[i];
+                        for (int k = 0; k < 16; k++) {
+                            point = transform * point;
+                        }
+                        results[i] = point.x + point.y + point.z;
+                    }
+                });
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (run > 0) {
+                    times.push_back(ms); //       ,   
+                }
+            }
+            std::sort(times.begin(), times.end());
+            const double medianMs = times[times.size() / 2];
+            if (threads == 1) {
+                baseMs = medianMs;
+            }
+
+            JobCounter counter;
+            std::atomic<uint32_t> executed{ 0 };
+            const auto tinyStart = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < tinyJobs; i++) {
+                jobs.schedule([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            jobs.wait(counter);
+            const double tinyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tinyStart).count();
+
+            const double speedup = baseMs / medianMs;
+            printf("%8u %12.3f %9.2fx %10.0f%% %14.0f\n", threads, medianMs, speedup, speedup / threads * 100.0, tinyJobs / tinyMs);
+        }
+
+        jobs.shutdown();
+        jobs.initialize(jobThreads);
+    }
+
+    /*
+    *    :     ,       .
+    *          
+    */
+    void Core::benchmarkProfiler() {
+#ifdef ENGINE_PROFILER
+        const uint32_t zones = 1000; //   newFrame,   
+        const int frames = 2000;
+        const uint32_t zonesPerFrame = 200;
+        const double frameMs = 1000.0 / 60.0;
+
+        Profiler& instance = profiler();
+        auto measure = [&]() {
+            const auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; frame++) {
+                for (uint32_t i = 0; i < zones; i++) {
+                    PROFILE_SCOPE("bench zone");
+                }
+                instance.newFrame();
+            }
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ((double)frames * zones);
+        };
+
+        instance.setEnabled(false);
+        const double disabledNs = measure();
+        instance.setEnabled(true);
+        const double enabledNs = measure();
+
+        //    ,     
+        const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+        std::atomic<uint64_t> recorded{ 0 };
+        const auto parallelStart = std::chrono::steady_clock::now();
+        jobs.parallelFor(threads, 1, [&](uint32_t, uint32_t) {
+            for (uint32_t i = 0; i < zones * 10; i++) {
+                PROFILE_SCOPE("bench zone");
+            }
+            recorded.fetch_add(zones * 10, std::memory_order_relaxed);
+        });
+        instance.newFrame();
+        const double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - parallelStart).count();
+
+        printf("profiler: %u zones per frame, %d frames\n", zones, frames);
+        printf("%-24s %10.1f ns\n", "zone, disabled at runtime", disabledNs);
+        printf("%-24s %10.1f ns\n", "zone, enabled", enabledNs);
+        printf("%-24s %10.3f %%\n", "overhead at 200 zones", enabledNs * zonesPerFrame / (frameMs * 1e6) * 100.0);
+        printf("%-24s %10.0f zones/ms (%u threads, %llu dropped)\n", "parallel", recorded.load() / parallelMs, threads, (unsigned long long)instance.droppedZones());
+#else
+        printf("profiler: built without ENGINE_PROFILER, zones compile to nothing\n");
+#endif
+    }
+
+    //     : stringstream   ,     
+#define LEGACY_SS(x) ( ((std::stringstream&)(std::stringstream() << x )).str())
+
+    /*
+    *    spdlog/bench/async_bench.cpp:        (SS   spdlog)
+    *    (  fmt  async_logger).      
+    *       .  -   
+    */
+    void Core::benchmarkLogging() {
+        const int messages = 100000;
+        const int filteredCalls = 10000000;
+        const uint32_t threadCounts[] = { 1, 4 };
+        const char* path = "log_bench.log";
+
+        printf("logging: %d messages per case into %s\n", messages, path);
+        printf("%-22s %8s %14s %10s\n", "path", "threads", "caller ns/msg", "total ms");
+
+        for (uint32_t threads : threadCounts) {
+            for (int mode = 0; mode < 3; mode++) {
+                const bool legacy = mode == 0;
+                const bool async = mode == 2;
+
+                auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path, true);
+                std::shared_ptr<spdlog::details::thread_pool> pool;
+                std::shared_ptr<spdlog::logger> logger;
+                if (async) {
+                    pool = std::make_shared<spdlog::details::thread_pool>(messages, 1); //    ,     
+                    logger = std::make_shared<spdlog::async_logger>("bench", sink, pool, spdlog::async_overflow_policy::block);
+                }
+                else {
+                    logger = std::make_shared<spdlog::logger>("bench", sink);
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                std::vector<std::thread> workers;
+                std::atomic<int64_t> callerNs{ 0 };
+                for (uint32_t t = 0; t < threads; t++) {
+                    workers.emplace_back([&, t]() {
+                        const auto threadStart = std::chrono::steady_clock::now();
+                        for (int i = (int)t; i < messages; i += (int)threads) {
+                            if (legacy) {
+                                logger->info(LEGACY_SS("frame " << i << " took " << 16.6 << " ms on thread " << t));
+                            }
+                            else {
+                                logger->info(FMT_STRING("frame {} took {} ms on thread {}"), i, 16.6, t);
+                            }
+                        }
+                        callerNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - threadStart).count());
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+
+                //     
+                logger->flush();
+                logger.reset();
+                pool.reset();
+                const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                const char* name = legacy ? "SS + sync spdlog" : async ? "fmt + async_logger" : "fmt + sync spdlog";
+                printf("%-22s %8u %14.0f %10.2f\n", name, threads, (double)callerNs.load() / messages, totalMs);
+            }
+        }
+
+        //  :      ,     
+        auto quiet = std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::basic_file_sink_mt>(path, true));
+        quiet->set_level(spdlog::level::warn);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < filteredCalls / 100; i++) {
+            quiet->debug(LEGACY_SS("frame " << i << " took " << 16.6 << " ms"));
+        }
+        const double legacyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (filteredCalls / 100);
+
+        const spdlog::level::level_enum level = Log::level(LogChannel::Frames);
+        Log::setLevel(LogChannel::Frames, spdlog::level::warn);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < filteredCalls; i++) {
+            LOG_DEBUG(Frames, "frame {} took {} ms", i, 16.6);
+        }
+        const double channelNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / filteredCalls;
+        Log::setLevel(LogChannel::Frames, level);
+
+        printf("%-22s %8s %14.1f\n", "SS, filtered", "1", legacyNs);
+        printf("%-22s %8s %14.1f\n", "LOG_DEBUG, filtered", "1", channelNs);
+
+        quiet.reset();
+        remove(path);
+    }
+#undef LEGACY_SS
+
+    /*
+    *  :     ,   .
+    *   -    ,     
+    */
+    void Core::benchmarkBinaryLog() {
+        if (BinaryLog::isRunning()) {
+            printf("binlog: binary log is already running, start without --binlog and --flight-recorder\n");
+            return;
+        }
+
+        const int events = 4000000;
+        const uint32_t threadCounts[] = { 1, 4, std::max(1u, std::thread::hardware_concurrency()) };
+        const char* path = "binlog_bench.blog";
+
+        const spdlog::level::level_enum level = Log::level(LogChannel::Jobs);
+        Log::setLevel(LogChannel::Jobs, spdlog::level::off);
+
+        printf("binlog: %d events per case into %s\n", events, path);
+        printf("%8s %14s %14s %10s %10s %10s\n", "threads", "caller ns/evt", "Mevents/s", "total ms", "dropped", "MB");
+        for (uint32_t threads : threadCounts) {
+            BinaryLog::Settings settings;
+            settings.path = path;
+            settings.threadBufferSize = 4u << 20;
+            if (!BinaryLog::initialize(settings)) {
+                break;
+            }
+            const BinaryLog::Stats before = BinaryLog::stats();
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            std::atomic<int64_t> callerNs{ 0 };
+            for (uint32_t t = 0; t < threads; t++) {
+                workers.emplace_back([&, t]() {
+                    const auto threadStart = std::chrono::steady_clock::now();
+                    for (int i = (int)t; i < events; i += (int)threads) {
+                        LOG_DEBUG(Jobs, "job {} finished in {:.3f} ms on thread {}", i, 0.25, t);
+                    }
+                    callerNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - threadStart).count());
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            const double produceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            BinaryLog::shutdown(); //    
+            const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            const BinaryLog::Stats after = BinaryLog::stats();
+
+            printf("%8u %14.1f %14.2f %10.2f %10llu %10.1f\n", threads, (double)callerNs.load() / events, events / produceMs / 1000.0, totalMs,
+                (unsigned long long)(after.dropped - before.dropped), after.bytesWritten / 1048576.0);
+        }
+
+        Log::setLevel(LogChannel::Jobs, level);
+        remove(path);
+    }
+
+    namespace {
+        struct BenchPosition { glm::vec3 value; };
+        struct BenchVelocity { glm::vec3 value; };
+        struct BenchHealth { float value; };
+        struct BenchBurning { float timeLeft; };
+
+        //    "   ",  ,    
+        struct BenchObject {
+            glm::vec3 position;
+            glm::vec3 velocity;
+            float health;
+            bool burning;
+            char name[32];
+            glm::mat4 transform;
+        };
+
+        template<typename F>
+        double medianMs(int runs, F&& function) {
+            std::vector<double> times;
+            for (int run = 0; run < runs + 1; run++) {
+                const auto start = std::chrono::steady_clock::now();
+                function();
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (run > 0) {
+                    times.push_back(ms); //    
+                }
+            }
+            std::sort(times.begin(), times.end());
+            return times[times.size() / 2];
+        }
+    }
+
+    /*
+    *  :  1M+       ,
+    *     (   )     
+    */
+    void Core::benchmarkWorld() {
+        const uint32_t entityCounts[] = { 1u << 20, 4u << 20 };
+        const uint32_t churnCount = 100000;
+        const int runs = 10;
+        const float dt = 1.0f / 60.0f;
+
+        printf("ecs: median of %d runs, %u threads\n", runs, jobs.threadCount());
+        printf("%10s %10s %12s %12s %12s %12s\n", "entities", "create ms", "aos ms", "each ms", "parallel ms", "ns/entity");
+        for (uint32_t count : entityCounts) {
+            std::vector<BenchObject> objects(count);
+            for (uint32_t i = 0; i < count; i++) {
+                objects[i].position = glm::vec3((float)i, 0.0f, 0.0f);
+                objects[i].velocity = glm::vec3(1.0f, 2.0f, 3.0f);
+                objects[i].health = 100.0f;
+            }
+
+            World bench;
+            const auto createStart = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < count; i++) {
+                if (i % 4 == 0) {
+                    bench.create(BenchPosition{ glm::vec3((float)i, 0.0f, 0.0f) }, BenchVelocity{ glm::vec3(1.0f, 2.0f, 3.0f) }, BenchHealth{ 100.0f });
+                }
+                else {
+                    bench.create(BenchPosition{ glm::vec3((float)i, 0.0f, 0.0f) }, BenchVelocity{ glm::vec3(1.0f, 2.0f, 3.0f) });
+                }
+            }
+            const double createMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - createStart).count();
+
+            const double aosMs = medianMs(runs, [&]() {
+                for (BenchObject& object : objects) {
+                    object.position += object.velocity * dt;
+                }
+            });
+            const double eachMs = medianMs(runs, [&]() {
+                bench.each<BenchPosition, const BenchVelocity>([dt](BenchPosition& position, const BenchVelocity& velocity) {
+                    position.value += velocity.value * dt;
+                });
+            });
+            const double parallelMs = medianMs(runs, [&]() {
+                bench.parallelEach<BenchPosition, const BenchVelocity>(jobs, [dt](BenchPosition& position, const BenchVelocity& velocity) {
+                    position.value += velocity.value * dt;
+                });
+            });
+
+            printf("%10u %10.1f %12.3f %12.3f %12.3f %12.3f\n", count, createMs, aosMs, eachMs, parallelMs, eachMs * 1e6 / count);
+        }
+
+        //         ,     
+        World churn;
+        std::vector<Entity> entities;
+        for (uint32_t i = 0; i < churnCount; i++) {
+            entities.push_back(churn.create(BenchPosition{}, BenchVelocity{}, BenchHealth{ 100.0f }));
+        }
+
+        const double directMs = medianMs(runs, [&]() {
+            for (Entity entity : entities) {
+                churn.add(entity, BenchBurning{ 1.0f });
+            }
+            for (Entity entity : entities) {
+                churn.remove<BenchBurning>(entity);
+            }
+        });
+        const double deferredMs = medianMs(runs, [&]() {
+            churn.parallelEach<const BenchHealth>(jobs, [&churn](Entity entity, const BenchHealth&) {
+                churn.commands().add(entity, BenchBurning{ 1.0f });
+            });
+            churn.flush();
+            churn.parallelEach<const BenchBurning>(jobs, [&churn](Entity entity, const BenchBurning&) {
+                churn.commands().remove<BenchBurning>(entity);
+            });
+            churn.flush();
+        });
+        const WorldStats stats = churn.stats();
+
+        printf("\nchurn: %u entities add + remove a component, %llu archetypes, %llu chunks\n", churnCount, (unsigned long long)stats.archetypes, (unsigned long long)stats.chunks);
+        printf("%10s %12s %14s\n", "mode", "median ms", "changes/ms");
+        printf("%10s %12.3f %14.0f\n", "direct", directMs, churnCount * 2 / directMs);
+        printf("%10s %12.3f %14.0f\n", "commands", deferredMs, churnCount * 2 / deferredMs);
+    }
+
+    /*
+    *  : 1024   8     (~600k ).
+    *   ,    (    ),    ,   
+    */
+    void Core::benchmarkTransforms() {
+        const uint32_t roots = 1024;
+        const uint32_t fanout = 8;
+        const uint32_t depth = 3;
+        const int runs = 20;
+
+        TransformHierarchy hierarchy;
+        std::vector<TransformHandle> rootHandles;
+        std::vector<TransformHandle> allHandles;
+        for (uint32_t r = 0; r < roots; r++) {
+            std::vector<TransformHandle> level{ hierarchy.create() };
+            rootHandles.push_back(level[0]);
+            allHandles.push_back(level[0]);
+            for (uint32_t d = 0; d < depth; d++) {
+                std::vector<TransformHandle> next;
+                for (TransformHandle parent : level) {
+                    for (uint32_t c = 0; c < fanout; c++) {
+                        const TransformHandle child = hierarchy.create(parent);
+                        hierarchy.setLocal(child, glm::vec3((float)c, 1.0f, 0.0f), glm::angleAxis(0.1f * c, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f));
+                        next.push_back(child);
+                        allHandles.push_back(child);
+                    }
+                }
+                level = std::move(next);
+            }
+        }
+        hierarchy.update(jobs);
+
+        printf("transforms: %zu nodes, depth %u, median of %d runs, %u threads\n", hierarchy.size(), hierarchy.depth(), runs, jobs.threadCount());
+        printf("%8s %12s %12s %12s %12s %14s\n", "kernel", "all ms", "roots ms", "10%% ms", "clean ms", "ns/transform");
+
+        float time = 0.0f;
+        for (TransformKernel kernel : { TransformKernel::Scalar, TransformKernel::Sse, TransformKernel::Avx }) {
+            if (!isTransformKernelSupported(kernel)) {
+                printf("%8s %12s\n", transformKernelName(kernel), "n/a");
+                continue;
+            }
+            hierarchy.setKernel(kernel);
+
+            //   ,   update
+            auto measure = [&](auto&& change) {
+                std::vector<double> times;
+                for (int run = 0; run < runs + 1; run++) {
+                    time += 0.01f;
+                    change();
+                    const auto start = std::chrono::steady_clock::now();
+                    hierarchy.update(jobs);
+                    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    if (run > 0) {
+                        times.push_back(ms);
+                    }
+                }
+                std::sort(times.begin(), times.end());
+                return times[times.size() / 2];
+            };
+
+            const double allMs = measure([&]() {
+                for (TransformHandle handle : allHandles) {
+                    hierarchy.setRotation(handle, glm::angleAxis(time, glm::vec3(0.0f, 0.0f, 1.0f)));
+                }
+            });
+            const double rootsMs = measure([&]() {
+                for (TransformHandle handle : rootHandles) {
+                    hierarchy.setPosition(handle, glm::vec3(time, 0.0f, 0.0f));
+                }
+            });
+            const double tenthMs = measure([&]() {
+                for (size_t i = 0; i < rootHandles.size(); i += 10) {
+                    hierarchy.setPosition(rootHandles[i], glm::vec3(0.0f, time, 0.0f));
+                }
+            });
+            const double cleanMs = measure([]() {});
+
+            printf("%8s %12.3f %12.3f %12.3f %12.3f %14.2f\n", transformKernelName(kernel), allMs, rootsMs, tenthMs, cleanMs, allMs * 1e6 / hierarchy.size());
+        }
+        hierarchy.setKernel(bestTransformKernel());
+    }
+
+    /*
+    *   :      ,
+    *     COMMAND  malloc   
+    */
+    void Core::benchmarkHostMemory() {
+        const uint32_t objectCount = 10000;
+
+        if (allocator != nullptr) {
+            printf("host-memory: driver host allocations per object, %u objects\n", objectCount);
+            printf("%14s %12s %12s %12s %14s\n", "object", "allocations", "bytes live", "command", "create+destroy us");
+
+            auto measure = [&](const char* name, auto create, auto destroy) {
+                const HostMemoryStats before = hostAllocator.stats();
+                const auto start = std::chrono::steady_clock::now();
+                for (uint32_t i = 0; i < objectCount; i++) {
+                    destroy(create());
+                }
+                const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                const HostMemoryStats after = hostAllocator.stats();
+
+                uint64_t allocations = 0;
+                for (uint32_t scope = 0; scope < HostScopeCount; scope++) {
+                    allocations += after.scopes[scope].allocations - before.scopes[scope].allocations;
+                }
+                const uint64_t command = after.scopes[VK_SYSTEM_ALLOCATION_SCOPE_COMMAND].allocations - before.scopes[VK_SYSTEM_ALLOCATION_SCOPE_COMMAND].allocations;
+
+                //    :   
+                const uint64_t liveBefore = hostAllocator.stats().liveBytes;
+                auto object = create();
+                const uint64_t liveBytes = hostAllocator.stats().liveBytes - liveBefore;
+                destroy(object);
+
+                printf("%14s %12.2f %12llu %12.2f %14.3f\n", name, (double)allocations / objectCount, (unsigned long long)liveBytes, (double)command / objectCount, us / objectCount);
+            };
+
+            measure("fence", [&]() {
+                VkFenceCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                VkFence fence;
+                checkVkResult(vkCreateFence(logicalDevice, &info, allocator, &fence));
+                return fence;
+            }, [&](VkFence fence) { vkDestroyFence(logicalDevice, fence, allocator); });
+
+            measure("semaphore", [&]() {
+                VkSemaphoreCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                VkSemaphore semaphore;
+                checkVkResult(vkCreateSemaphore(logicalDevice, &info, allocator, &semaphore));
+                return semaphore;
+            }, [&](VkSemaphore semaphore) { vkDestroySemaphore(logicalDevice, semaphore, allocator); });
+
+            measure("sampler", [&]() {
+                VkSamplerCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+                info.magFilter = VK_FILTER_LINEAR;
+                info.minFilter = VK_FILTER_LINEAR;
+                info.maxLod = 1.0f;
+                VkSampler sampler;
+                checkVkResult(vkCreateSampler(logicalDevice, &info, allocator, &sampler));
+                return sampler;
+            }, [&](VkSampler sampler) { vkDestroySampler(logicalDevice, sampler, allocator); });
+
+            measure("buffer", [&]() {
+                VkBufferCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                info.size = 65536;
+                info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+                info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                VkBuffer buffer;
+                checkVkResult(vkCreateBuffer(logicalDevice, &info, allocator, &buffer));
+                return buffer;
+            }, [&](VkBuffer buffer) { vkDestroyBuffer(logicalDevice, buffer, allocator); });
+
+            measure("command pool", [&]() {
+                VkCommandPoolCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                info.queueFamilyIndex = queueFamily;
+                VkCommandPool pool;
+                checkVkResult(vkCreateCommandPool(logicalDevice, &info, allocator, &pool));
+                return pool;
+            }, [&](VkCommandPool pool) { vkDestroyCommandPool(logicalDevice, pool, allocator); });
+        }
+        else {
+            printf("host-memory: driver allocator in use (--host-allocator=0), per object counts skipped\n");
+        }
+
+        //  :     ,   
+        const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+        const uint32_t calls = 200000;
+        const size_t sizes[] = { 48, 256, 96, 1024, 64, 2048 };
+
+        auto run = [&](const VkAllocationCallbacks* callbacks) {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (uint32_t t = 0; t < threads; t++) {
+                workers.emplace_back([&]() {
+                    void* blocks[IM_ARRAYSIZE(sizes)];
+                    for (uint32_t call = 0; call < calls; call++) {
+                        for (size_t i = 0; i < IM_ARRAYSIZE(sizes); i++) {
+                            blocks[i] = callbacks ? callbacks->pfnAllocation(callbacks->pUserData, sizes[i], 16, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND) : malloc(sizes[i]);
+                            memset(blocks[i], (int)call, 16);
+                        }
+                        for (size_t i = IM_ARRAYSIZE(sizes); i-- > 0;) {
+                            if (callbacks) {
+                                callbacks->pfnFree(callbacks->pUserData, blocks[i]);
+                            }
+                            else {
+                                free(blocks[i]);
+                            }
+                        }
+                    }
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ((double)calls * threads * IM_ARRAYSIZE(sizes));
+        };
+
+        HostAllocator counted;
+        counted.setArenas(false);
+        HostAllocator arenas;
+
+        printf("host-memory: command scope pattern, %u threads x %u calls x %zu blocks\n", threads, calls, (size_t)IM_ARRAYSIZE(sizes));
+        printf("%24s %12s\n", "allocator", "ns/block");
+        printf("%24s %12.1f\n", "malloc", run(nullptr));
+        printf("%24s %12.1f\n", "counted malloc", run(counted.callbacks()));
+        printf("%24s %12.1f\n", "counted thread arenas", run(arenas.callbacks()));
+    }
+
+    bool Core::runBenchmark(const std::string& name) {
+        //       ImGui,       TexID
+        ImGui_ImplVulkan_NewFrame();
+        if (headless) {
+            ImGui::GetIO().DisplaySize = ImVec2((float)imguiWindowData.Width, (float)imguiWindowData.Height);
+        }
+        else {
+            ImGui_ImplGlfw_NewFrame();
+        }
+        ImGui::NewFrame();
+        ImGui::EndFrame();
+        if (uploadService.isInitialized()) {
+            uploadService.waitIdle(); //      
+        }
+
+        if (name == "imgui-upload") {
+            benchmarkImguiUpload();
+            return true;
+        }
+        if (name == "imgui-parallel") {
+            benchmarkImguiParallel();
+            return true;
+        }
+        if (name == "imgui-thumbnails") {
+            benchmarkImguiThumbnails();
+            return true;
+        }
+        if (name == "imgui-cache") {
+            benchmarkImguiCache();
+            return true;
+        }
+        if (name == "jobs") {
+            benchmarkJobs();
+            return true;
+        }
+        if (name == "logging") {
+            benchmarkLogging();
+            return true;
+        }
+        if (name == "ecs") {
+            benchmarkWorld();
+            return true;
+        }
+        if (name == "transforms") {
+            benchmarkTransforms();
+            return true;
+        }
+        if (name == "host-memory") {
+            benchmarkHostMemory();
+            return true;
+        }
+        if (name == "binlog") {
+            benchmarkBinaryLog();
+            return true;
+        }
+        if (name == "profiler") {
+            benchmarkProfiler();
+            return true;
+        }
+        if (name == "resize-storm") {
+            if (headless) {
+                printf("resize-storm needs a window, skipped in headless mode\n");
+                return false;
+            }
+            benchmarkResizeStorm();
+            return true;
+        }
+
+        printf("Unknown benchmark '%s'\n", name.c_str());
+        return false;
+    }
+}
@@ -0,0 +1,484 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <csignal>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Engine {
+    std::atomic<int> BinaryLog::s_level{ spdlog::level::off }; //  initialize ,    
+
+    namespace {
+        struct ThreadRing {
+            std::unique_ptr<uint8_t[]> data;
+            size_t capacity = 0;
+            std::atomic<uint64_t> write{ 0 };
+            std::atomic<uint64_t> read{ 0 };
+            std::atomic<uint64_t> events{ 0 };
+            std::atomic<uint64_t> dropped{ 0 };
+            uint64_t pending = 0; //    begin  commit,   -
+            uint16_t index = 0;
+        };
+
+        struct FlightChunk {
+            int64_t time;
+            std::vector<uint8_t> block; //  Events 
+        };
+
+        struct BinaryLogState {
+            BinaryLog::Settings settings;
+            int64_t epoch = 0; // steady_clock, 
+            int64_t wallClock = 0;
+
+            std::mutex formatsLock;
+            std::vector<std::vector<uint8_t>> formats; // FormatRecord  ,  - id
+
+            std::mutex threadsLock; //   
+            std::vector<std::unique_ptr<ThreadRing>> threads;
+
+            //  drainLock:  , shutdown  crash
+            std::mutex drainLock;
+            FILE* file = nullptr;
+            std::vector<uint8_t> pending; //     
+            size_t formatsWritten = 0;
+            int64_t lastWrite = 0;
+            std::deque<FlightChunk> flight;
+            std::atomic<size_t> flightBytes{ 0 };
+            std::atomic<uint64_t> bytesWritten{ 0 };
+
+            std::thread writer;
+            std::mutex wakeLock;
+            std::condition_variable wake;
+            std::atomic<bool> wakeRequested{ false };
+            bool stop = false;
+            bool running = false;
+            std::atomic<bool> crashed{ false };
+        };
+
+        BinaryLogState& state() {
+            static BinaryLogState instance;
+            return instance;
+        }
+
+        thread_local ThreadRing* t_binaryRing = nullptr;
+
+        const int crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+        void (*previousHandlers[sizeof(crashSignals) / sizeof(crashSignals[0])])(int) = {};
+
+        int64_t steadyNow() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void appendBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+            const uint8_t* bytes = (const uint8_t*)data;
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        void appendBlock(std::vector<uint8_t>& out, BinaryLogFormat::BlockType type, const std::vector<std::vector<uint8_t>>& records, size_t first) {
+            BinaryLogFormat::BlockHeader header = { type, 0 };
+            const size_t headerOffset = out.size();
+            appendBytes(out, &header, sizeof(header));
+            for (size_t i = first; i < records.size(); i++) {
+                appendBytes(out, records[i].data(), records[i].size());
+            }
+            header.size = (uint32_t)(out.size() - headerOffset - sizeof(header));
+            memcpy(out.data() + headerOffset, &header, sizeof(header));
+        }
+
+        /*
+        *        Events.    ,   
+        */
+        void drain(BinaryLogState& log) {
+            const int64_t now = steadyNow() - log.epoch;
+            log.wakeRequested.store(false, std::memory_order_relaxed);
+
+            //   :   id  
+            {
+                std::lock_guard<std::mutex> guard(log.formatsLock);
+                if (log.file != nullptr && log.formatsWritten < log.formats.size()) {
+                    appendBlock(log.pending, BinaryLogFormat::Formats, log.formats, log.formatsWritten);
+                }
+                log.formatsWritten = log.formats.size();
+            }
+
+            std::vector<ThreadRing*> rings;
+            {
+                std::lock_guard<std::mutex> guard(log.threadsLock);
+                for (auto& ring : log.threads) {
+                    rings.push_back(ring.get());
+                }
+            }
+
+            size_t used = 0;
+            for (ThreadRing* ring : rings) {
+                used += (size_t)(ring->write.load(std::memory_order_relaxed) - ring->read.load(std::memory_order_relaxed));
+            }
+            std::vector<uint8_t> block;
+            block.reserve(sizeof(BinaryLogFormat::BlockHeader) + used);
+            block.resize(sizeof(BinaryLogFormat::BlockHeader));
+
+            for (ThreadRing* ring : rings) {
+                uint64_t read = ring->read.load(std::memory_order_relaxed);
+                const uint64_t write = ring->write.load(std::memory_order_acquire);
+
+                //     Padding   ,     ,   
+                while (read < write) {
+                    const size_t start = (size_t)(read % ring->capacity);
+                    size_t offset = start;
+                    while (read < write && offset < ring->capacity) {
+                        uint32_t format;
+                        memcpy(&format, ring->data.get() + offset, sizeof(format));
+                        if (format == BinaryLogFormat::Padding) {
+                            break;
+                        }
+
+                        BinaryLogFormat::EventHeader header;
+                        memcpy(&header, ring->data.get() + offset, sizeof(header));
+                        const size_t size = BinaryLogFormat::align(sizeof(header) + header.size);
+                        offset += size;
+                        read += size;
+                    }
+                    appendBytes(block, ring->data.get() + start, offset - start);
+
+                    if (read < write) {
+                        read += ring->capacity - offset; // Padding:    
+                    }
+                }
+                ring->read.store(read, std::memory_order_release);
+            }
+
+            if (block.size() == sizeof(BinaryLogFormat::BlockHeader)) {
+                return;
+            }
+
+            const BinaryLogFormat::BlockHeader header = { BinaryLogFormat::Events, (uint32_t)(block.size() - sizeof(BinaryLogFormat::BlockHeader)) };
+            memcpy(block.data(), &header, sizeof(header));
+            if (log.file != nullptr) {
+                appendBytes(log.pending, block.data(), block.size());
+            }
+
+            if (log.settings.flightRecorderSeconds > 0.0) {
+                size_t bytes = log.flightBytes.load(std::memory_order_relaxed) + block.size();
+                log.flight.push_back({ now, std::move(block) });
+
+                //    N ,      
+                const int64_t oldest = now - (int64_t)(log.settings.flightRecorderSeconds * 1e9);
+                while (log.flight.size() > 1 && (log.flight.front().time < oldest || bytes > log.settings.flightRecorderLimit)) {
+                    bytes -= log.flight.front().block.size();
+                    log.flight.pop_front();
+                }
+                log.flightBytes.store(bytes, std::memory_order_relaxed);
+            }
+        }
+
+        void writePending(BinaryLogState& log, bool force) {
+            if (log.file == nullptr || log.pending.empty()) {
+                return;
+            }
+
+            //     : writeSize    ,     
+            const int64_t now = steadyNow();
+            if (!force && log.pending.size() < log.settings.writeSize && now - log.lastWrite < 1000000000) {
+                return;
+            }
+
+            const size_t written = fwrite(log.pending.data(), 1, log.pending.size(), log.file);
+            log.bytesWritten.fetch_add(written, std::memory_order_relaxed);
+            log.pending.clear();
+            log.lastWrite = now;
+        }
+
+        bool writeFlightRecorder(BinaryLogState& log) {
+            if (log.settings.flightRecorderSeconds <= 0.0) {
+                return false;
+            }
+
+            FILE* file = fopen(log.settings.flightRecorderPath.c_str(), "wb");
+            if (file == nullptr) {
+                return false;
+            }
+
+            BinaryLogFormat::FileHeader header;
+            memcpy(header.magic, BinaryLogFormat::Magic, sizeof(header.magic));
+            header.wallClock = log.wallClock;
+            fwrite(&header, sizeof(header), 1, file);
+
+            std::vector<uint8_t> formats;
+            {
+                std::lock_guard<std::mutex> guard(log.formatsLock);
+                appendBlock(formats, BinaryLogFormat::Formats, log.formats, 0);
+            }
+            fwrite(formats.data(), 1, formats.size(), file);
+            for (const FlightChunk& chunk : log.flight) {
+                fwrite(chunk.block.data(), 1, chunk.block.size(), file);
+            }
+            fclose(file);
+            return true;
+        }
+
+        void writerThread() {
+            PROFILE_THREAD("Binary log");
+            BinaryLogState& log = state();
+            std::unique_lock<std::mutex> lock(log.wakeLock);
+            while (!log.stop) {
+                log.wake.wait_for(lock, std::chrono::milliseconds(log.settings.flushIntervalMs));
+                lock.unlock();
+                {
+                    std::lock_guard<std::mutex> guard(log.drainLock);
+                    drain(log);
+                    writePending(log, false);
+                }
+                lock.lock();
+            }
+        }
+
+        /*
+        *        (, fwrite),    ,
+        *    ,      
+        */
+        void onCrashSignal(int signal) {
+            BinaryLog::crash();
+            std::signal(signal, SIG_DFL);
+            std::raise(signal);
+        }
+    }
+
+    bool BinaryLog::initialize(const Settings& settings) {
+        BinaryLogState& log = state();
+        if (log.running) {
+            LOG_WARNING(Core, "Binary log is already running");
+            return false;
+        }
+
+        FILE* file = nullptr;
+        if (!settings.path.empty()) {
+            file = fopen(settings.path.c_str(), "wb");
+            if (file == nullptr) {
+                LOG_ERROR(Core, "Can't open binary log '{}'", settings.path);
+                return false;
+            }
+            setvbuf(file, nullptr, _IONBF, 0); //    ,  stdio   
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(log.drainLock);
+            log.settings = settings;
+            log.settings.threadBufferSize = BinaryLogFormat::align(std::max<size_t>(settings.threadBufferSize, 64u << 10));
+            log.settings.flushIntervalMs = std::max<uint32_t>(settings.flushIntervalMs, 1);
+            log.epoch = steadyNow();
+            log.wallClock = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            log.file = file;
+            log.pending.clear();
+            log.pending.reserve(settings.writeSize + (1u << 20));
+            log.formatsWritten = 0; //      
+            log.lastWrite = log.epoch;
+            log.flight.clear();
+            log.flightBytes.store(0, std::memory_order_relaxed);
+            log.bytesWritten.store(0, std::memory_order_relaxed);
+            log.crashed.store(false, std::memory_order_relaxed);
+
+            if (file != nullptr) {
+                BinaryLogFormat::FileHeader header;
+                memcpy(header.magic, BinaryLogFormat::Magic, sizeof(header.magic));
+                header.wallClock = log.wallClock;
+                appendBytes(log.pending, &header, sizeof(header));
+            }
+        }
+
+        //    :        
+        {
+            std::lock_guard<std::mutex> guard(log.threadsLock);
+            for (auto& ring : log.threads) {
+                ring->read.store(ring->write.load(std::memory_order_acquire), std::memory_order_release);
+            }
+        }
+
+        log.stop = false;
+        log.running = true;
+        log.writer = std::thread(writerThread);
+
+        for (size_t i = 0; i < sizeof(crashSignals) / sizeof(crashSignals[0]); i++) {
+            previousHandlers[i] = std::signal(crashSignals[i], onCrashSignal);
+        }
+
+        s_level.store(settings.level, std::memory_order_relaxed);
+        LOG_INFO(Core, "Binary log: {}, flight recorder {} s", settings.path.empty() ? "no file" : settings.path, settings.flightRecorderSeconds);
+        return true;
+    }
+
+    void BinaryLog::shutdown() {
+        BinaryLogState& log = state();
+        if (!log.running) {
+            return;
+        }
+
+        s_level.store(spdlog::level::off, std::memory_order_relaxed);
+        for (size_t i = 0; i < sizeof(crashSignals) / sizeof(crashSignals[0]); i++) {
+            std::signal(crashSignals[i], previousHandlers[i] != SIG_ERR ? previousHandlers[i] : SIG_DFL);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(log.wakeLock);
+            log.stop = true;
+        }
+        log.wake.notify_one();
+        log.writer.join();
+
+        std::lock_guard<std::mutex> guard(log.drainLock);
+        drain(log);
+        writePending(log, true);
+        if (log.file != nullptr) {
+            fclose(log.file);
+            log.file = nullptr;
+        }
+        log.flight.clear();
+        log.flightBytes.store(0, std::memory_order_relaxed);
+        log.running = false;
+    }
+
+    bool BinaryLog::isRunning() {
+        return state().running;
+    }
+
+    void BinaryLog::setLevel(int level) {
+        if (state().running) {
+            s_level.store(level, std::memory_order_relaxed);
+        }
+    }
+
+    BinaryLog::Stats BinaryLog::stats() {
+        BinaryLogState& log = state();
+        Stats stats;
+        {
+            std::lock_guard<std::mutex> guard(log.threadsLock);
+            for (auto& ring : log.threads) {
+                stats.events += ring->events.load(std::memory_order_relaxed);
+                stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+        }
+        stats.bytesWritten = log.bytesWritten.load(std::memory_order_relaxed);
+        stats.flightRecorderBytes = log.flightBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    bool BinaryLog::dumpFlightRecorder() {
+        BinaryLogState& log = state();
+        std::lock_guard<std::mutex> guard(log.drainLock);
+        drain(log);
+        return writeFlightRecorder(log);
+    }
+
+    void BinaryLog::crash() {
+        BinaryLogState& log = state();
+        if (!log.running || log.crashed.exchange(true)) {
+            return;
+        }
+
+        //      .    -   ,   
+        std::unique_lock<std::mutex> lock(log.drainLock, std::defer_lock);
+        for (int attempt = 0; !lock.try_lock(); attempt++) {
+            if (attempt == 100) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        drain(log);
+        writePending(log, true);
+        if (log.file != nullptr) {
+            fflush(log.file);
+        }
+        if (writeFlightRecorder(log)) {
+            fprintf(stderr, "Flight recorder written to '%s'\n", log.settings.flightRecorderPath.c_str());
+        }
+    }
+
+    uint32_t BinaryLog::registerFormat(uint8_t channel, int level, const char* format, const char* types, const char* file, uint32_t line) {
+        const std::string_view channelName = logChannelName((LogChannel)channel);
+        const std::string_view formatText = format;
+        const std::string_view typesText = types;
+        const std::string_view fileText = file;
+
+        BinaryLogState& log = state();
+        std::lock_guard<std::mutex> guard(log.formatsLock);
+
+        BinaryLogFormat::FormatRecord record;
+        record.id = (uint32_t)log.formats.size();
+        record.level = level;
+        record.line = line;
+        record.channelLength = (uint16_t)channelName.size();
+        record.formatLength = (uint16_t)std::min<size_t>(formatText.size(), UINT16_MAX);
+        record.typesLength = (uint16_t)typesText.size();
+        record.fileLength = (uint16_t)std::min<size_t>(fileText.size(), UINT16_MAX);
+
+        std::vector<uint8_t> bytes;
+        appendBytes(bytes, &record, sizeof(record));
+        appendBytes(bytes, channelName.data(), record.channelLength);
+        appendBytes(bytes, formatText.data(), record.formatLength);
+        appendBytes(bytes, typesText.data(), record.typesLength);
+        appendBytes(bytes, fileText.data(), record.fileLength);
+        log.formats.push_back(std::move(bytes));
+        return record.id;
+    }
+
+    uint8_t* BinaryLog::begin(uint32_t format, size_t size) {
+        ThreadRing* ring = t_binaryRing;
+        if (ring == nullptr) {
+            //     :    ,    
+            BinaryLogState& log = state();
+            std::lock_guard<std::mutex> guard(log.threadsLock);
+            if (log.threads.size() >= UINT16_MAX) {
+                return nullptr;
+            }
+            log.threads.emplace_back(new ThreadRing());
+            ring = log.threads.back().get();
+            ring->capacity = log.settings.threadBufferSize;
+            ring->data.reset(new uint8_t[ring->capacity]);
+            ring->index = (uint16_t)(log.threads.size() - 1);
+            t_binaryRing = ring;
+        }
+
+        //      :   Padding,     
+        const size_t need = BinaryLogFormat::align(sizeof(BinaryLogFormat::EventHeader) + size);
+        uint64_t write = ring->write.load(std::memory_order_relaxed);
+        const uint64_t read = ring->read.load(std::memory_order_acquire);
+        size_t offset = (size_t)(write % ring->capacity);
+        const size_t tail = ring->capacity - offset;
+        const size_t total = need + (tail < need ? tail : 0);
+        if (size > UINT16_MAX || need > ring->capacity / 4 || ring->capacity - (size_t)(write - read) < total) {
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        if (tail < need) {
+            const uint32_t padding = BinaryLogFormat::Padding;
+            memcpy(ring->data.get() + offset, &padding, sizeof(padding));
+            write += tail;
+            offset = 0;
+        }
+
+        BinaryLogFormat::EventHeader header;
+        header.format = format;
+        header.thread = ring->index;
+        header.size = (uint16_t)size;
+        header.time = steadyNow() - state().epoch;
+        memcpy(ring->data.get() + offset, &header, sizeof(header));
+        ring->pending = write + need;
+        return ring->data.get() + offset + sizeof(header);
+    }
+
+    void BinaryLog::commit() {
+        ThreadRing* ring = t_binaryRing;
+        ring->write.store(ring->pending, std::memory_order_release);
+        ring->events.store(ring->events.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        //    -   ,   
+        if (ring->pending - ring->read.load(std::memory_order_relaxed) > ring->capacity / 2) {
+            BinaryLogState& log = state();
+            if (!log.wakeRequested.exchange(true, std::memory_order_relaxed)) {
+                log.wake.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    void DeletionQueue::initialize(VkDevice device, const VkAllocationCallbacks* allocator, DeviceAllocator* memoryAllocator) {
+        m_device = device;
+        m_allocator = allocator;
+        m_memoryAllocator = memoryAllocator;
+        m_stats = DeletionStats{};
+    }
+
+    void DeletionQueue::retire(const RetiredResource& resource) {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        m_pending.push_back(resource);
+        if (m_pending.size() > 1 && m_pending.back().value < m_pending[m_pending.size() - 2].value) {
+            m_pending.back().value = m_pending[m_pending.size() - 2].value; //   ,    
+        }
+
+        m_stats.pendingCount++;
+        m_stats.pendingBytes += resource.bytes;
+        m_stats.peakPendingBytes = std::max(m_stats.peakPendingBytes, m_stats.pendingBytes);
+    }
+
+    void DeletionQueue::retireBuffer(VkBuffer buffer, const MemoryAllocation& memory, uint64_t value) {
+        RetiredResource resource;
+        resource.type = RetiredType::Buffer;
+        resource.handle = (uint64_t)buffer;
+        resource.memory = memory;
+        resource.bytes = memory.size;
+        resource.value = value;
+        retire(resource);
+    }
+
+    void DeletionQueue::retireImage(VkImage image, const MemoryAllocation& memory, uint64_t value) {
+        RetiredResource resource;
+        resource.type = RetiredType::Image;
+        resource.handle = (uint64_t)image;
+        resource.memory = memory;
+        resource.bytes = memory.size;
+        resource.value = value;
+        retire(resource);
+    }
+
+    void DeletionQueue::retireHandle(RetiredType type, uint64_t handle, uint64_t value) {
+        RetiredResource resource;
+        resource.type = type;
+        resource.handle = handle;
+        resource.value = value;
+        retire(resource);
+    }
+
+    void DeletionQueue::retireDescriptorSet(VkDescriptorPool pool, VkDescriptorSet set, uint64_t value) {
+        RetiredResource resource;
+        resource.type = RetiredType::DescriptorSet;
+        resource.handle = (uint64_t)set;
+        resource.pool = pool;
+        resource.value = value;
+        retire(resource);
+    }
+
+    void DeletionQueue::destroy(RetiredResource& resource) {
+        switch (resource.type) {
+        case RetiredType::Buffer: vkDestroyBuffer(m_device, (VkBuffer)resource.handle, m_allocator); break;
+        case RetiredType::Image: vkDestroyImage(m_device, (VkImage)resource.handle, m_allocator); break;
+        case RetiredType::ImageView: vkDestroyImageView(m_device, (VkImageView)resource.handle, m_allocator); break;
+        case RetiredType::Sampler: vkDestroySampler(m_device, (VkSampler)resource.handle, m_allocator); break;
+        case RetiredType::Pipeline: vkDestroyPipeline(m_device, (VkPipeline)resource.handle, m_allocator); break;
+        case RetiredType::PipelineLayout: vkDestroyPipelineLayout(m_device, (VkPipelineLayout)resource.handle, m_allocator); break;
+        case RetiredType::DescriptorSet: {
+            VkDescriptorSet set = (VkDescriptorSet)resource.handle;
+            vkFreeDescriptorSets(m_device, resource.pool, 1, &set);
+            break;
+        }
+        case RetiredType::Framebuffer: vkDestroyFramebuffer(m_device, (VkFramebuffer)resource.handle, m_allocator); break;
+        case RetiredType::RenderPass: vkDestroyRenderPass(m_device, (VkRenderPass)resource.handle, m_allocator); break;
+        case RetiredType::Swapchain: vkDestroySwapchainKHR(m_device, (VkSwapchainKHR)resource.handle, m_allocator); break;
+        case RetiredType::Semaphore: vkDestroySemaphore(m_device, (VkSemaphore)resource.handle, m_allocator); break;
+        case RetiredType::DeviceMemory: vkFreeMemory(m_device, (VkDeviceMemory)resource.handle, m_allocator); break;
+        case RetiredType::Memory: break;
+        }
+
+        //    ,    
+        if (resource.memory.memory != VK_NULL_HANDLE) {
+            m_memoryAllocator->free(resource.memory);
+        }
+    }
+
+    void DeletionQueue::collect(uint64_t completedValue) {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        while (!m_pending.empty() && m_pending.front().value <= completedValue) {
+            RetiredResource& resource = m_pending.front();
+            destroy(resource);
+
+            m_stats.pendingCount--;
+            m_stats.pendingBytes -= resource.bytes;
+            m_stats.destroyedCount++;
+            m_stats.destroyedBytes += resource.bytes;
+            m_pending.pop_front();
+        }
+    }
+
+    void DeletionQueue::flush() {
+        collect(UINT64_MAX);
+    }
+
+    DeletionStats DeletionQueue::stats() {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_stats;
+    }
+
+    /*
+    * ,     ,    
+    */
+    uint64_t Core::retireValue() const {
+        return graphicsSubmitted + 1;
+    }
+
+    void Core::imguiReleaseBuffer(VkBuffer buffer, ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData) {
+        Core* core = (Core*)userData;
+        MemoryAllocation* handle = (MemoryAllocation*)allocation->Handle;
+        const uint64_t value = core->retireValue();
+
+        if (handle != nullptr) {
+            core->deletionQueue.retireBuffer(buffer, *handle, value);
+            delete handle;
+        }
+        else {
+            //     DeviceAllocator,    VkDeviceMemory  
+            if (buffer != VK_NULL_HANDLE) {
+                core->deletionQueue.retireHandle(RetiredType::Buffer, (uint64_t)buffer, value);
+            }
+            if (allocation->Memory != VK_NULL_HANDLE) {
+                core->deletionQueue.retireHandle(RetiredType::DeviceMemory, (uint64_t)allocation->Memory, value);
+            }
+        }
+        *allocation = ImGui_ImplVulkan_MemoryAllocation{};
+    }
+
+    void Core::reportDeletionStats() {
+        const DeletionStats stats = deletionQueue.stats();
+        LOG_INFO(Memory, "Deferred destroy: {} pending ({} KiB, peak {} KiB), {} destroyed ({} KiB)", stats.pendingCount, stats.pendingBytes >> 10,
+            stats.peakPendingBytes >> 10, stats.destroyedCount, stats.destroyedBytes >> 10);
+    }
+}
@@ -0,0 +1,277 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    //   VkPhysicalDeviceFeatures   ,     
+    static const char* featureNames[] = {
+        "robustBufferAccess", "fullDrawIndexUint32", "imageCubeArray", "independentBlend", "geometryShader",
+        "tessellationShader", "sampleRateShading", "dualSrcBlend", "logicOp", "multiDrawIndirect",
+        "drawIndirectFirstInstance", "depthClamp", "depthBiasClamp", "fillModeNonSolid", "depthBounds",
+        "wideLines", "largePoints", "alphaToOne", "multiViewport", "samplerAnisotropy",
+        "textureCompressionETC2", "textureCompressionASTC_LDR", "textureCompressionBC", "occlusionQueryPrecise", "pipelineStatisticsQuery",
+        "vertexPipelineStoresAndAtomics", "fragmentStoresAndAtomics", "shaderTessellationAndGeometryPointSize", "shaderImageGatherExtended", "shaderStorageImageExtendedFormats",
+        "shaderStorageImageMultisample", "shaderStorageImageReadWithoutFormat", "shaderStorageImageWriteWithoutFormat", "shaderUniformBufferArrayDynamicIndexing", "shaderSampledImageArrayDynamicIndexing",
+        "shaderStorageBufferArrayDynamicIndexing", "shaderStorageImageArrayDynamicIndexing", "shaderClipDistance", "shaderCullDistance", "shaderFloat64",
+        "shaderInt64", "shaderInt16", "shaderResourceResidency", "shaderResourceMinLod", "sparseBinding",
+        "sparseResidencyBuffer", "sparseResidencyImage2D", "sparseResidencyImage3D", "sparseResidency2Samples", "sparseResidency4Samples",
+        "sparseResidency8Samples", "sparseResidency16Samples", "sparseResidencyAliased", "variableMultisampleRate", "inheritedQueries",
+    };
+    static_assert(sizeof(featureNames) / sizeof(featureNames[0]) == sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32), "featureNames must match VkPhysicalDeviceFeatures");
+
+    static const char* deviceTypeName(VkPhysicalDeviceType type) {
+        switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+        default: return "other";
+        }
+    }
+
+    DeviceCandidate evaluateDevice(VkPhysicalDevice device, VkSurfaceKHR surface, const DeviceRequirements& requirements, uint32_t instanceApiVersion) {
+        DeviceCandidate candidate;
+        candidate.device = device;
+        vkGetPhysicalDeviceProperties(device, &candidate.properties);
+        const VkPhysicalDeviceProperties& properties = candidate.properties;
+
+        //  1.2   1.1 -   1.1:   1.2   
+        const uint32_t apiVersion = std::min(properties.apiVersion, instanceApiVersion);
+        candidate.apiVersion = apiVersion;
+        if (apiVersion < requirements.minApiVersion) {
+            candidate.rejections.push_back(fmt::format("Vulkan {}.{} is too old", VK_API_VERSION_MAJOR(apiVersion), VK_API_VERSION_MINOR(apiVersion)));
+        }
+
+        // 
+        uint32_t extensionsCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionsCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionsCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionsCount, extensions.data());
+        auto hasExtension = [&extensions](const char* name) {
+            for (const auto& extension : extensions) {
+                if (strcmp(extension.extensionName, name) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (const char* name : requirements.requiredExtensions) {
+            if (hasExtension(name)) {
+                candidate.extensions.push_back(name);
+            }
+            else {
+                candidate.rejections.push_back(fmt::format("missing extension {}", name));
+            }
+        }
+        for (const char* name : requirements.optionalExtensions) {
+            if (hasExtension(name)) {
+                candidate.extensions.push_back(name);
+                candidate.score += 50;
+            }
+        }
+
+        // : VkPhysicalDeviceFeatures -   VkBool32
+        VkPhysicalDeviceFeatures features;
+        vkGetPhysicalDeviceFeatures(device, &features);
+        const VkBool32* supported = (const VkBool32*)&features;
+        const VkBool32* required = (const VkBool32*)&requirements.requiredFeatures;
+        for (size_t i = 0; i < sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32); i++) {
+            if (required[i] && !supported[i]) {
+                candidate.rejections.push_back(fmt::format("missing feature {}", featureNames[i]));
+            }
+        }
+
+        //    1.1/1.2    *2 
+        if (apiVersion >= VK_API_VERSION_1_2) {
+            VkPhysicalDeviceVulkan12Features features12{};
+            features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &features12;
+            vkGetPhysicalDeviceFeatures2(device, &features2);
+            candidate.timelineSemaphore = features12.timelineSemaphore == VK_TRUE;
+
+            // Bindless:     ,    ,     firstInstance
+            candidate.bindless = features12.runtimeDescriptorArray && features12.shaderSampledImageArrayNonUniformIndexing &&
+                features12.descriptorBindingPartiallyBound && features12.descriptorBindingSampledImageUpdateAfterBind &&
+                features12.descriptorBindingUpdateUnusedWhilePending &&
+                features.multiDrawIndirect && features.drawIndirectFirstInstance && features.shaderClipDistance;
+            if (candidate.bindless) {
+                VkPhysicalDeviceVulkan12Properties properties12{};
+                properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+                VkPhysicalDeviceProperties2 properties2{};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties12;
+                vkGetPhysicalDeviceProperties2(device, &properties2);
+                candidate.maxBindlessTextures = std::min({ properties12.maxDescriptorSetUpdateAfterBindSampledImages, properties12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                    properties12.maxPerStageDescriptorUpdateAfterBindSamplers, properties12.maxDescriptorSetUpdateAfterBindSamplers });
+                candidate.bindless = candidate.maxBindlessTextures > 0;
+            }
+        }
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        // Present wait:    .      
+        if (apiVersion >= VK_API_VERSION_1_1 && hasExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME) && hasExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+            VkPhysicalDevicePresentWaitFeaturesKHR presentWait{};
+            presentWait.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+            VkPhysicalDevicePresentIdFeaturesKHR presentId{};
+            presentId.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+            presentId.pNext = &presentWait;
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &presentId;
+            vkGetPhysicalDeviceFeatures2(device, &features2);
+            candidate.presentWait = presentId.presentId == VK_TRUE && presentWait.presentWait == VK_TRUE;
+        }
+#endif
+        if (requirements.requireTimelineSemaphore && !candidate.timelineSemaphore) {
+            candidate.rejections.push_back("missing feature timelineSemaphore");
+        }
+        if (apiVersion >= VK_API_VERSION_1_1) {
+            VkPhysicalDeviceSubgroupProperties subgroup{};
+            subgroup.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &subgroup;
+            vkGetPhysicalDeviceProperties2(device, &properties2);
+            candidate.subgroupSize = subgroup.subgroupSize;
+        }
+
+        // 
+        if (properties.limits.maxImageDimension2D < requirements.minImageDimension2D) {
+            candidate.rejections.push_back(fmt::format("maxImageDimension2D {} < {}", properties.limits.maxImageDimension2D, requirements.minImageDimension2D));
+        }
+        if (properties.limits.maxBoundDescriptorSets < requirements.minBoundDescriptorSets) {
+            candidate.rejections.push_back(fmt::format("maxBoundDescriptorSets {} < {}", properties.limits.maxBoundDescriptorSets, requirements.minBoundDescriptorSets));
+        }
+
+        // :   device local  (   lavapipe   )
+        VkPhysicalDeviceMemoryProperties memory;
+        vkGetPhysicalDeviceMemoryProperties(device, &memory);
+        for (uint32_t i = 0; i < memory.memoryHeapCount; i++) {
+            if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                candidate.deviceLocalMemory = std::max(candidate.deviceLocalMemory, memory.memoryHeaps[i].size);
+            }
+        }
+        if (candidate.deviceLocalMemory < requirements.minDeviceLocalMemory) {
+            candidate.rejections.push_back(fmt::format("device local memory {} MiB < {} MiB", candidate.deviceLocalMemory >> 20, requirements.minDeviceLocalMemory >> 20));
+        }
+
+        // 
+        uint32_t familiesCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familiesCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familiesCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familiesCount, families.data());
+
+        bool graphics = false, present = false;
+        for (uint32_t i = 0; i < familiesCount; i++) {
+            const VkQueueFlags flags = families[i].queueFlags;
+            if (flags & VK_QUEUE_GRAPHICS_BIT) {
+                graphics = true;
+                candidate.timestamps = candidate.timestamps || families[i].timestampValidBits > 0;
+
+                VkBool32 canPresent = VK_FALSE;
+                if (surface != VK_NULL_HANDLE) {
+                    vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &canPresent);
+                }
+                present = present || canPresent == VK_TRUE;
+            }
+            candidate.dedicatedCompute = candidate.dedicatedCompute || ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT));
+            candidate.dedicatedTransfer = candidate.dedicatedTransfer || ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)));
+        }
+        if (!graphics) {
+            candidate.rejections.push_back("no graphics queue");
+        }
+        if (requirements.requirePresent && !present) {
+            candidate.rejections.push_back("graphics queue can't present to the surface");
+        }
+
+        /*
+        * :    ,     .
+        *  ICD (lavapipe)   ,    
+        */
+        switch (properties.deviceType) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: candidate.score += 100000; break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: candidate.score += 50000; break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: candidate.score += 20000; break;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: candidate.score += 1000; break;
+        default: break;
+        }
+        candidate.score += (int64_t)(candidate.deviceLocalMemory >> 24); // +1   16 MiB
+        candidate.score += candidate.dedicatedCompute ? 300 : 0;
+        candidate.score += candidate.dedicatedTransfer ? 300 : 0;
+        candidate.score += candidate.timestamps ? 200 : 0;
+        candidate.score += candidate.timelineSemaphore ? 200 : 0;
+        candidate.score += candidate.bindless ? 100 : 0;
+        candidate.score += candidate.subgroupSize * 2;
+        candidate.score += VK_API_VERSION_MINOR(apiVersion) * 10;
+
+        return candidate;
+    }
+
+    /*
+    *   :      deviceRequirements,
+    *    ,    --device=<   >
+    */
+    VkPhysicalDevice Core::selectPhysicalDevice() {
+        uint32_t devicesCount; //    ()
+        VkResult result = vkEnumeratePhysicalDevices(instance, &devicesCount, nullptr); //  devicesCount   
+        checkVkResult(result); //     vkEnumeratePhysicalDevices
+
+        std::vector<VkPhysicalDevice> devices{devicesCount}; //      
+        result = vkEnumeratePhysicalDevices(instance, &devicesCount, devices.data());
+        checkVkResult(result);
+
+        const DeviceCandidate* best = nullptr;
+        const DeviceCandidate* preferred = nullptr;
+        std::vector<DeviceCandidate> candidates;
+        candidates.reserve(devicesCount);
+
+        for (uint32_t i = 0; i < devicesCount; i++) {
+            candidates.push_back(evaluateDevice(devices[i], surface, deviceRequirements, instanceApiVersion));
+            const DeviceCandidate& candidate = candidates.back();
+
+            LOG_INFO(Device, "GPU {}: {} ({}, Vulkan {}.{}, {} MiB, subgroup {}{}) score {}", i, candidate.properties.deviceName, deviceTypeName(candidate.properties.deviceType),
+                VK_API_VERSION_MAJOR(candidate.properties.apiVersion), VK_API_VERSION_MINOR(candidate.properties.apiVersion), candidate.deviceLocalMemory >> 20,
+                candidate.subgroupSize, candidate.timestamps ? ", timestamps" : "", candidate.score);
+            for (const auto& reason : candidate.rejections) {
+                LOG_WARNING(Device, "GPU {} rejected: {}", i, reason);
+            }
+
+            if (!candidate.suitable()) {
+                continue;
+            }
+            if (best == nullptr || candidate.score > best->score) {
+                best = &candidate;
+            }
+
+            //  :     
+            if (!preferredDevice.empty() && preferred == nullptr
+                && (preferredDevice == std::to_string(i) || strstr(candidate.properties.deviceName, preferredDevice.c_str()) != nullptr)) {
+                preferred = &candidate;
+            }
+        }
+
+        if (!preferredDevice.empty() && preferred == nullptr) {
+            LOG_WARNING(Device, "Requested GPU '{}' is not available or not suitable, using the best one", preferredDevice);
+        }
+        const DeviceCandidate* selected = preferred != nullptr ? preferred : best;
+        if (selected == nullptr) {
+            callback(3, "no suitable physical device");
+            exit(-1);
+        }
+
+        LOG_INFO(Device, "Selected GPU: {} ({})", selected->properties.deviceName, selected == preferred ? "requested" : "best score");
+        deviceExtensions = selected->extensions;
+        timelineSemaphores = selected->timelineSemaphore;
+        bindlessSupported = selected->bindless;
+        bindlessMaxTextures = selected->maxBindlessTextures;
+
+        // Present wait ,       (      )
+        auto enabled = [this](const char* name) {
+            return std::find_if(deviceExtensions.begin(), deviceExtensions.end(), [name](const char* extension) { return strcmp(extension, name) == 0; }) != deviceExtensions.end();
+        };
+        presentWait = selected->presentWait && enabled("VK_KHR_present_id") && enabled("VK_KHR_present_wait");
+        memoryBudget = enabled("VK_EXT_memory_budget") && selected->apiVersion >= VK_API_VERSION_1_1; //    vkGetPhysicalDeviceMemoryProperties2
+        return selected->device;
+    }
+}
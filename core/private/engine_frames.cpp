@@ -0,0 +1,320 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <algorithm>
+
+namespace Engine {
+    void Core::createFrameContexts() {
+        VkResult result;
+
+        if (framesInFlight < 1) {
+            framesInFlight = 1; //      
+        }
+
+        frames.resize(framesInFlight);
+        currentFrame = 0;
+
+        for (auto& frame : frames) {
+            {
+                VkCommandPoolCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; //    ,   
+                info.queueFamilyIndex = queueFamily;
+                result = vkCreateCommandPool(logicalDevice, &info, allocator, &frame.commandPool);
+                checkVkResult(result);
+            }
+            {
+                VkCommandBufferAllocateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                info.commandPool = frame.commandPool;
+                info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                info.commandBufferCount = 1;
+                result = vkAllocateCommandBuffers(logicalDevice, &info, &frame.commandBuffer);
+                checkVkResult(result);
+            }
+            {
+                VkFenceCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                info.flags = VK_FENCE_CREATE_SIGNALED_BIT; //     
+                result = vkCreateFence(logicalDevice, &info, allocator, &frame.fence);
+                checkVkResult(result);
+            }
+            {
+                VkSemaphoreCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                result = vkCreateSemaphore(logicalDevice, &info, allocator, &frame.imageAcquiredSemaphore);
+                checkVkResult(result);
+            }
+
+            //  : host visible ,        
+            if (transientBufferSize > 0) {
+                VkBufferCreateInfo bufferInfo{};
+                bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = transientBufferSize;
+                bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                result = vkCreateBuffer(logicalDevice, &bufferInfo, allocator, &frame.transientBuffer);
+                checkVkResult(result);
+
+                VkMemoryRequirements requirements;
+                vkGetBufferMemoryRequirements(logicalDevice, frame.transientBuffer, &requirements);
+
+                //       ,    
+                if (!memoryAllocator.allocate(requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0, frame.transientMemory)) {
+                    callback(3, "can't allocate transient frame buffer");
+                    abort();
+                }
+                result = vkBindBufferMemory(logicalDevice, frame.transientBuffer, frame.transientMemory.memory, frame.transientMemory.offset);
+                checkVkResult(result);
+                frame.transientMapped = frame.transientMemory.mapped;
+
+                frame.transientSize = transientBufferSize;
+                frame.transientOffset = 0;
+            }
+        }
+
+#ifdef ENGINE_PROFILER
+        gpuProfiler.initialize(physicalDevice, logicalDevice, queueFamily, framesInFlight, allocator);
+#endif
+
+        frameStats.reset(FrameStats::Clock::now());
+        LOG_INFO(Frames, "Frames in flight: {}, sync {}", framesInFlight, syncMode == FrameSyncMode::Timeline ? "timeline" : "fences");
+    }
+
+    void Core::destroyFrameContexts() {
+        gpuProfiler.destroy();
+
+        for (auto& frame : frames) {
+            vkDestroyBuffer(logicalDevice, frame.transientBuffer, allocator);
+            memoryAllocator.free(frame.transientMemory);
+
+            vkDestroySemaphore(logicalDevice, frame.imageAcquiredSemaphore, allocator);
+            vkDestroyFence(logicalDevice, frame.fence, allocator);
+            vkFreeCommandBuffers(logicalDevice, frame.commandPool, 1, &frame.commandBuffer);
+            vkDestroyCommandPool(logicalDevice, frame.commandPool, allocator);
+            for (VkCommandPool pool : frame.secondaryPools) {
+                vkDestroyCommandPool(logicalDevice, pool, allocator); //    
+            }
+        }
+
+        frames.clear();
+        imagesInFlight.clear();
+        imagesInFlightValues.clear();
+    }
+
+    /*
+    * ,   present,    ,     .
+    * Fence     ,   ,  present   ;
+    *          acquire
+    */
+    void Core::createPresentSemaphores(uint32_t imageCount) {
+        destroyPresentSemaphores();
+
+        VkSemaphoreCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        renderCompleteSemaphores.resize(imageCount, VK_NULL_HANDLE);
+        for (auto& semaphore : renderCompleteSemaphores) {
+            VkResult result = vkCreateSemaphore(logicalDevice, &info, allocator, &semaphore);
+            checkVkResult(result);
+        }
+    }
+
+    void Core::destroyPresentSemaphores() {
+        for (auto semaphore : renderCompleteSemaphores) {
+            vkDestroySemaphore(logicalDevice, semaphore, allocator);
+        }
+        renderCompleteSemaphores.clear();
+    }
+
+    /*
+    *      .
+    *         ( framesInFlight )
+    */
+    void* Core::allocateTransient(VkDeviceSize size, VkDeviceSize alignment, VkBuffer* buffer, VkDeviceSize* offset) {
+        FrameContext& frame = frames[currentFrame];
+
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        VkDeviceSize aligned = (frame.transientOffset + alignment - 1) / alignment * alignment;
+        if (frame.transientMapped == nullptr || aligned + size > frame.transientSize) {
+            return nullptr; //    ,     
+        }
+
+        frame.transientOffset = aligned + size;
+        *buffer = frame.transientBuffer;
+        *offset = aligned;
+        return frame.transientMapped + aligned;
+    }
+
+    /*
+    *   ImGui.    (imguiParallel    imguiParallelMinCommands )
+    *     ,          :
+    *         ,       .
+    *    GPU,      .
+    *        imguiRenderStats
+    */
+    void Core::recordImgui(FrameContext& frame, ImGui_ImplVulkanH_Window* window, ImDrawData* drawData) {
+        PROFILE_FUNCTION();
+        const auto start = FrameStats::Clock::now();
+
+        VkRenderPassBeginInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        info.renderPass = window->RenderPass;
+        info.framebuffer = window->Frames[frame.imageIndex].Framebuffer;
+        info.renderArea.extent.width = window->Width;
+        info.renderArea.extent.height = window->Height;
+        info.clearValueCount = 1;
+        info.pClearValues = &window->ClearValue;
+
+        int commandCount = 0;
+        for (int i = 0; i < drawData->CmdListsCount; i++) {
+            commandCount += drawData->CmdLists[i]->CmdBuffer.Size;
+        }
+        const uint32_t chunkCount = std::min<uint32_t>({ jobs.threadCount(), (uint32_t)drawData->CmdListsCount, (uint32_t)commandCount / 256 + 1 });
+        if (!imguiParallel || commandCount < (int)imguiParallelMinCommands || chunkCount < 2) {
+            vkCmdBeginRenderPass(frame.commandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+            ImGui_ImplVulkan_RenderDrawData(drawData, frame.commandBuffer);
+            vkCmdEndRenderPass(frame.commandBuffer);
+            frameStats.imguiSum += std::chrono::duration<double, std::milli>(FrameStats::Clock::now() - start).count();
+            accumulateImguiStats(ImGui_ImplVulkan_GetRenderStats());
+            return;
+        }
+
+        vkCmdBeginRenderPass(frame.commandBuffer, &info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        if (!ImGui_ImplVulkan_BeginDrawData(drawData)) {
+            vkCmdEndRenderPass(frame.commandBuffer); //  ,   
+            return;
+        }
+        {
+            PROFILE_SCOPE("imgui upload");
+            jobs.parallelFor((uint32_t)drawData->CmdListsCount, 0, [drawData](uint32_t begin, uint32_t end) {
+                ImGui_ImplVulkan_UploadDrawLists(drawData, (int)begin, (int)end);
+            });
+            ImGui_ImplVulkan_EndUpload(drawData);
+        }
+
+        //  : ,     
+        std::vector<int> bounds(1, 0);
+        int accumulated = 0;
+        for (int i = 0; i < drawData->CmdListsCount && bounds.size() < chunkCount; i++) {
+            accumulated += drawData->CmdLists[i]->CmdBuffer.Size;
+            if ((uint64_t)accumulated * chunkCount >= (uint64_t)commandCount * bounds.size()) {
+                bounds.push_back(i + 1);
+            }
+        }
+        if (bounds.back() != drawData->CmdListsCount) {
+            bounds.push_back(drawData->CmdListsCount);
+        }
+        const uint32_t chunks = (uint32_t)bounds.size() - 1;
+
+        //     ,      
+        VkResult result;
+        while (frame.secondaryPools.size() < chunks) {
+            VkCommandPool pool;
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = queueFamily;
+            result = vkCreateCommandPool(logicalDevice, &poolInfo, allocator, &pool);
+            checkVkResult(result);
+
+            VkCommandBuffer buffer;
+            VkCommandBufferAllocateInfo bufferInfo{};
+            bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            bufferInfo.commandPool = pool;
+            bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            bufferInfo.commandBufferCount = 1;
+            result = vkAllocateCommandBuffers(logicalDevice, &bufferInfo, &buffer);
+            checkVkResult(result);
+
+            frame.secondaryPools.push_back(pool);
+            frame.secondaryBuffers.push_back(buffer);
+        }
+
+        std::vector<ImGui_ImplVulkan_RenderStats> chunkStats(chunks, ImGui_ImplVulkan_RenderStats{});
+        {
+            PROFILE_SCOPE("imgui record");
+            jobs.parallelFor(chunks, 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t chunk = begin; chunk < end; chunk++) {
+                    VkResult result = vkResetCommandPool(logicalDevice, frame.secondaryPools[chunk], 0);
+                    checkVkResult(result);
+
+                    VkCommandBufferInheritanceInfo inheritance{};
+                    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+                    inheritance.renderPass = info.renderPass;
+                    inheritance.subpass = 0;
+                    inheritance.framebuffer = info.framebuffer;
+
+                    VkCommandBufferBeginInfo beginInfo{};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+                    beginInfo.pInheritanceInfo = &inheritance;
+                    VkCommandBuffer buffer = frame.secondaryBuffers[chunk];
+                    result = vkBeginCommandBuffer(buffer, &beginInfo);
+                    checkVkResult(result);
+
+                    ImGui_ImplVulkan_RecordDrawLists(drawData, buffer, bounds[chunk], bounds[chunk + 1], &chunkStats[chunk]);
+
+                    result = vkEndCommandBuffer(buffer);
+                    checkVkResult(result);
+                }
+            });
+        }
+
+        vkCmdExecuteCommands(frame.commandBuffer, chunks, frame.secondaryBuffers.data());
+        vkCmdEndRenderPass(frame.commandBuffer);
+
+        frameStats.imguiSum += std::chrono::duration<double, std::milli>(FrameStats::Clock::now() - start).count();
+        frameStats.imguiParallelFrames++;
+        frameStats.imguiSecondaryBuffers += chunks;
+
+        ImGui_ImplVulkan_RenderStats stats{};
+        for (const ImGui_ImplVulkan_RenderStats& chunk : chunkStats) {
+            stats.DrawCommands += chunk.DrawCommands;
+            stats.DrawCalls += chunk.DrawCalls;
+            stats.ScissorsSet += chunk.ScissorsSet;
+            stats.ScissorsSkipped += chunk.ScissorsSkipped;
+            stats.DescriptorSetsBound += chunk.DescriptorSetsBound;
+            stats.DescriptorSetsSkipped += chunk.DescriptorSetsSkipped;
+        }
+        accumulateImguiStats(stats);
+    }
+
+    void Core::accumulateImguiStats(const ImGui_ImplVulkan_RenderStats& stats) {
+        imguiRenderStats = stats;
+        frameStats.imguiCommands += stats.DrawCommands;
+        frameStats.imguiDrawCalls += stats.DrawCalls;
+        frameStats.imguiStateChanges += stats.ScissorsSet + stats.DescriptorSetsBound;
+        frameStats.imguiStateSkipped += stats.ScissorsSkipped + stats.DescriptorSetsSkipped;
+    }
+
+    void Core::reportFrameStats() {
+        const auto now = FrameStats::Clock::now();
+        if (std::chrono::duration<double>(now - frameStats.lastReport).count() < 5.0 || frameStats.frames == 0) {
+            return; //      
+        }
+
+        LOG_INFO(Frames, "Frame stats ({} in flight): avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms, fence wait {:.3f} ms, record {:.3f} ms, imgui {:.3f} ms",
+            framesInFlight, frameStats.averageFrameTime(), frameStats.frameTimeMin, frameStats.frameTimeMax, frameStats.averageFenceWait(), frameStats.averageRecord(), frameStats.averageImgui());
+        LOG_DEBUG(Frames, "ImGui per frame: {:.1f} commands, {:.1f} draw calls, {:.1f} state changes, {:.1f} skipped",
+            (double)frameStats.imguiCommands / frameStats.frames, (double)frameStats.imguiDrawCalls / frameStats.frames,
+            (double)frameStats.imguiStateChanges / frameStats.frames, (double)frameStats.imguiStateSkipped / frameStats.frames);
+        if (frameStats.imguiParallelFrames > 0) {
+            LOG_DEBUG(Frames, "ImGui parallel: {} of {} frames, {:.1f} secondary buffers per frame",
+                frameStats.imguiParallelFrames, frameStats.frames, (double)frameStats.imguiSecondaryBuffers / frameStats.imguiParallelFrames);
+        }
+
+        frameStats.reset(now);
+        reportMemoryStats();
+        reportDeletionStats();
+        reportSwapchainStats();
+        queues.reportStats();
+        jobs.reportStats();
+        reportSimulationStats();
+        world.reportStats();
+        transforms.reportStats();
+        reportPacingStats();
+    }
+}
@@ -0,0 +1,257 @@
+#include "../core/public/engine_host_memory.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Engine {
+    namespace {
+        std::atomic<uint64_t> nextAllocatorId{ 1 };
+
+        void updatePeak(std::atomic<uint64_t>& peak, uint64_t value) {
+            uint64_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        //     :  lock ,    fetch_add
+        void increment(std::atomic<uint64_t>& counter) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        uint8_t* alignUp(uint8_t* pointer, size_t alignment) {
+            return (uint8_t*)(((uintptr_t)pointer + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        }
+    }
+
+    //     ,   16   
+    struct HostAllocator::Header {
+        void* base; //  malloc, nullptr -   
+        ThreadState* arena;
+        uint64_t size;
+        uint32_t scope;
+        uint32_t padding;
+    };
+
+    const char* allocationScopeName(uint32_t scope) {
+        static const char* names[HostScopeCount] = { "command", "object", "cache", "device", "instance" };
+        return scope < HostScopeCount ? names[scope] : "unknown";
+    }
+
+    HostAllocator::HostAllocator() : m_id(nextAllocatorId.fetch_add(1)) {
+        m_callbacks.pUserData = this;
+        m_callbacks.pfnAllocation = allocation;
+        m_callbacks.pfnReallocation = reallocation;
+        m_callbacks.pfnFree = free;
+        m_callbacks.pfnInternalAllocation = internalAllocation;
+        m_callbacks.pfnInternalFree = internalFree;
+    }
+
+    HostAllocator::~HostAllocator() {
+        for (auto& thread : m_threads) {
+            delete[] thread->arena;
+        }
+    }
+
+    void* VKAPI_CALL HostAllocator::allocation(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        return ((HostAllocator*)userData)->allocate(size, alignment, (uint32_t)scope);
+    }
+
+    /*
+    *  ,    :       
+    */
+    void* VKAPI_CALL HostAllocator::reallocation(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        HostAllocator* allocator = (HostAllocator*)userData;
+        if (original == nullptr) {
+            return allocator->allocate(size, alignment, (uint32_t)scope);
+        }
+        if (size == 0) {
+            allocator->release(original);
+            return nullptr;
+        }
+
+        void* memory = allocator->allocate(size, alignment, (uint32_t)scope);
+        if (memory == nullptr) {
+            return nullptr;
+        }
+
+        const Header* header = (const Header*)original - 1;
+        memcpy(memory, original, std::min<size_t>(size, (size_t)header->size));
+        increment(allocator->threadState()->reallocations[((const Header*)memory - 1)->scope]);
+        allocator->release(original);
+        return memory;
+    }
+
+    void VKAPI_CALL HostAllocator::free(void* userData, void* memory) {
+        ((HostAllocator*)userData)->release(memory);
+    }
+
+    void VKAPI_CALL HostAllocator::internalAllocation(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+        (void)type; //   - VK_INTERNAL_ALLOCATION_TYPE_EXECUTABLE,    
+        HostAllocator* allocator = (HostAllocator*)userData;
+        ScopeCounters& counters = allocator->m_scopes[std::min<uint32_t>((uint32_t)scope, HostScopeCount - 1)];
+        updatePeak(counters.internalPeakBytes, counters.internalBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    }
+
+    void VKAPI_CALL HostAllocator::internalFree(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+        (void)type;
+        HostAllocator* allocator = (HostAllocator*)userData;
+        allocator->m_scopes[std::min<uint32_t>((uint32_t)scope, HostScopeCount - 1)].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void* HostAllocator::allocate(size_t size, size_t alignment, uint32_t scope) {
+        static_assert(sizeof(Header) % 16 == 0, "header keeps blocks aligned");
+        scope = std::min<uint32_t>(scope, HostScopeCount - 1);
+        alignment = std::max<size_t>(alignment, 16);
+        ThreadState* state = threadState();
+
+        if (m_arenasEnabled && scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND && size <= ArenaMaxAllocation) {
+            if (state->arena == nullptr) {
+                state->arena = new uint8_t[ArenaSize];
+            }
+
+            //     (,  ) -  
+            if (state->arenaLive.load(std::memory_order_acquire) == 0) {
+                state->arenaOffset = 0;
+            }
+
+            uint8_t* memory = alignUp(state->arena + state->arenaOffset + sizeof(Header), alignment);
+            if (memory + size <= state->arena + ArenaSize) {
+                state->arenaOffset = (size_t)(memory + size - state->arena);
+                state->arenaLive.fetch_add(1, std::memory_order_relaxed);
+
+                Header* header = (Header*)memory - 1;
+                *header = Header{ nullptr, state, size, scope, 0 };
+                increment(state->arenaAllocations);
+                increment(state->allocations[scope]);
+                track(scope, size);
+                return memory;
+            }
+            increment(state->arenaFallbacks);
+        }
+
+        uint8_t* base = (uint8_t*)malloc(size + alignment + sizeof(Header));
+        if (base == nullptr) {
+            return nullptr; //   VK_ERROR_OUT_OF_HOST_MEMORY
+        }
+
+        uint8_t* memory = alignUp(base + sizeof(Header), alignment);
+        Header* header = (Header*)memory - 1;
+        *header = Header{ base, nullptr, size, scope, 0 };
+        increment(state->allocations[scope]);
+        track(scope, size);
+        return memory;
+    }
+
+    void HostAllocator::release(void* memory) {
+        if (memory == nullptr) {
+            return;
+        }
+
+        const Header header = *((const Header*)memory - 1);
+        increment(threadState()->frees[header.scope]);
+        untrack(header.scope, header.size);
+        if (header.arena != nullptr) {
+            header.arena->arenaLive.fetch_sub(1, std::memory_order_release);
+        }
+        else {
+            std::free(header.base);
+        }
+    }
+
+    HostAllocator::ThreadState* HostAllocator::threadState() {
+        struct CachedState {
+            uint64_t allocator = 0;
+            ThreadState* state = nullptr;
+        };
+        thread_local CachedState t_cached;
+        if (t_cached.allocator == m_id) {
+            return t_cached.state;
+        }
+
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        const std::thread::id thread = std::this_thread::get_id();
+        ThreadState* state = nullptr;
+        for (auto& existing : m_threads) {
+            if (existing->thread == thread) {
+                state = existing.get();
+                break;
+            }
+        }
+        if (state == nullptr) {
+            m_threads.push_back(std::make_unique<ThreadState>());
+            state = m_threads.back().get();
+            state->thread = thread;
+        }
+
+        t_cached = { m_id, state };
+        return state;
+    }
+
+    void HostAllocator::track(uint32_t scope, uint64_t size) {
+        ScopeCounters& counters = m_scopes[scope];
+        updatePeak(counters.peakBytes, counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+        updatePeak(m_peakBytes, m_liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    }
+
+    void HostAllocator::untrack(uint32_t scope, uint64_t size) {
+        m_scopes[scope].liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        m_liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    HostMemoryStats HostAllocator::stats() const {
+        HostMemoryStats result;
+        for (uint32_t i = 0; i < HostScopeCount; i++) {
+            const ScopeCounters& counters = m_scopes[i];
+            HostScopeStats& scope = result.scopes[i];
+            scope.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+            scope.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+            scope.internalBytes = counters.internalBytes.load(std::memory_order_relaxed);
+            scope.internalPeakBytes = counters.internalPeakBytes.load(std::memory_order_relaxed);
+        }
+        result.liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+        result.peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        for (const auto& thread : m_threads) {
+            for (uint32_t i = 0; i < HostScopeCount; i++) {
+                result.scopes[i].allocations += thread->allocations[i].load(std::memory_order_relaxed);
+                result.scopes[i].reallocations += thread->reallocations[i].load(std::memory_order_relaxed);
+                result.scopes[i].frees += thread->frees[i].load(std::memory_order_relaxed);
+            }
+            result.arenaAllocations += thread->arenaAllocations.load(std::memory_order_relaxed);
+            result.arenaFallbacks += thread->arenaFallbacks.load(std::memory_order_relaxed);
+            if (thread->arena != nullptr) {
+                result.arenas++;
+                result.arenaBytes += ArenaSize;
+            }
+        }
+
+        //     ,      
+        for (HostScopeStats& scope : result.scopes) {
+            scope.liveAllocations = scope.allocations > scope.frees ? scope.allocations - scope.frees : 0;
+        }
+        return result;
+    }
+
+    void HostAllocator::reportStats() {
+        const HostMemoryStats stats = this->stats();
+        uint64_t allocations = 0;
+        uint64_t live = 0;
+        for (const HostScopeStats& scope : stats.scopes) {
+            allocations += scope.allocations;
+            live += scope.liveAllocations;
+        }
+
+        LOG_INFO(Memory, "Host memory: {} allocations live, {} KiB, peak {} KiB, {} calls total, {} from {} thread arenas, {} arena fallbacks",
+            live, stats.liveBytes >> 10, stats.peakBytes >> 10, allocations, stats.arenaAllocations, stats.arenas, stats.arenaFallbacks);
+        for (uint32_t i = 0; i < HostScopeCount; i++) {
+            const HostScopeStats& scope = stats.scopes[i];
+            if (scope.allocations != 0 || scope.internalPeakBytes != 0) {
+                LOG_DEBUG(Memory, "  {}: {} live, {} KiB, peak {} KiB, {} allocations, {} reallocations, {} frees, internal {} KiB",
+                    allocationScopeName(i), scope.liveAllocations, scope.liveBytes >> 10, scope.peakBytes >> 10, scope.allocations, scope.reallocations, scope.frees, scope.internalBytes >> 10);
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include "../core/public/engine_imgui_cache.hpp"
+#include "../core/public/engine_profiler.hpp"
+
+#include "../core/imgui/imgui_internal.h"
+
+#include <cstring>
+
+namespace Engine {
+    bool ImGuiWindowCache::Key::operator==(const Key& other) const {
+        return position.x == other.position.x && position.y == other.position.y && size.x == other.size.x && size.y == other.size.y &&
+            scroll.x == other.scroll.x && scroll.y == other.scroll.y && displaySize.x == other.displaySize.x && displaySize.y == other.displaySize.y &&
+            fontSize == other.fontSize && flags == other.flags && version == other.version && focused == other.focused &&
+            prefixVertices == other.prefixVertices && prefixIndices == other.prefixIndices && prefixCommands == other.prefixCommands &&
+            memcmp(&prefixHeader, &other.prefixHeader, sizeof(ImDrawCmdHeader)) == 0;
+    }
+
+    /*
+    *   :   ,  ,     ,          .
+    *            :  , 
+    *       
+    */
+    static bool isCalm(ImGuiWindow* window) {
+        ImGuiContext& g = *GImGui;
+        if (g.HoveredWindow == window || g.MovingWindow == window || g.ActiveIdWindow == window) {
+            return false;
+        }
+        for (const ImGuiPopupData& popup : g.OpenPopupStack) {
+            if (popup.Window == nullptr || popup.Window->RootWindowPopupTree == window) {
+                return false; //    ,    
+            }
+        }
+        if (g.NavWindow == window) {
+            for (const ImGuiInputEvent& event : g.InputEventsTrail) {
+                if (event.Type == ImGuiInputEventType_Key || event.Type == ImGuiInputEventType_Text) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool ImGuiWindowCache::begin(const char* name, uint64_t version, bool* open, ImGuiWindowFlags flags) {
+        const bool visible = ImGui::Begin(name, open, flags);
+        Scope scope;
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if (!m_enabled || !visible || window->BeginCount > 1 || (window->Flags & ImGuiWindowFlags_ChildWindow)) {
+            m_stats.uncacheable += m_enabled && visible ? 1 : 0;
+            m_stack.push_back(scope);
+            return visible;
+        }
+
+        const ImDrawList* list = window->DrawList;
+        Key& key = scope.key;
+        key.position = window->Pos;
+        key.size = window->Size;
+        key.scroll = window->Scroll;
+        key.displaySize = ImGui::GetIO().DisplaySize;
+        key.fontSize = ImGui::GetFontSize();
+        key.flags = window->Flags;
+        key.version = version;
+        key.focused = GImGui->NavWindow == window;
+        key.prefixVertices = list->VtxBuffer.Size;
+        key.prefixIndices = list->IdxBuffer.Size;
+        key.prefixCommands = list->CmdBuffer.Size;
+        key.prefixHeader = list->_CmdHeader;
+
+        Entry& entry = m_entries[window->ID];
+        const bool calm = isCalm(window);
+        const bool fresh = m_maxAge == 0 || ImGui::GetFrameCount() - entry.recordedFrame < (int)m_maxAge;
+        if (calm && entry.valid && fresh && entry.key == key) {
+            replay(entry);
+            m_stack.push_back(scope);
+            return false;
+        }
+
+        //    ,       
+        entry.valid = false;
+        scope.recording = calm ? &entry : nullptr;
+        m_stack.push_back(scope);
+        return true;
+    }
+
+    void ImGuiWindowCache::end() {
+        IM_ASSERT(!m_stack.empty() && "ImGuiWindowCache::end() without begin()");
+        const Scope scope = m_stack.back();
+        m_stack.pop_back();
+        if (scope.recording != nullptr) {
+            record(*scope.recording, scope.key);
+        }
+        ImGui::End();
+    }
+
+    /*
+    *     : ,   Begin,     ,
+    *         
+    */
+    void ImGuiWindowCache::replay(Entry& entry) {
+        PROFILE_FUNCTION();
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        ImDrawList* list = window->DrawList;
+        const Key& key = entry.key;
+
+        list->VtxBuffer.resize(key.prefixVertices + (int)entry.vertices.size());
+        list->IdxBuffer.resize(key.prefixIndices + (int)entry.indices.size());
+        list->CmdBuffer.resize(key.prefixCommands - 1 + (int)entry.commands.size());
+        memcpy(list->VtxBuffer.Data + key.prefixVertices, entry.vertices.data(), entry.vertices.size() * sizeof(ImDrawVert));
+        memcpy(list->IdxBuffer.Data + key.prefixIndices, entry.indices.data(), entry.indices.size() * sizeof(ImDrawIdx));
+        memcpy(list->CmdBuffer.Data + key.prefixCommands - 1, entry.commands.data(), entry.commands.size() * sizeof(ImDrawCmd));
+        list->_VtxCurrentIdx = entry.vertexCurrentIndex;
+        list->_VtxWritePtr = list->VtxBuffer.Data + list->VtxBuffer.Size;
+        list->_IdxWritePtr = list->IdxBuffer.Data + list->IdxBuffer.Size;
+        list->_CmdHeader = entry.header;
+
+        //   Begin   ,   ,   
+        window->DC.CursorPos = entry.cursorPosition;
+        window->DC.CursorMaxPos = entry.cursorMaxPosition;
+        window->DC.IdealMaxPos = entry.idealMaxPosition;
+        window->DC.NavLayersActiveMaskNext = entry.navLayers;
+
+        m_stats.replayed++;
+        m_stats.replayedVertices += entry.vertices.size();
+    }
+
+    void ImGuiWindowCache::record(Entry& entry, const Key& key) {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        const ImDrawList* list = window->DrawList;
+        m_stats.recorded++;
+
+        //            end
+        if (window->DC.ChildWindows.Size > 0 || window->DC.CurrentColumns != nullptr || list->_Splitter._Count > 1 || key.prefixCommands == 0 ||
+            list->VtxBuffer.Size < key.prefixVertices || list->IdxBuffer.Size < key.prefixIndices || list->CmdBuffer.Size < key.prefixCommands) {
+            m_stats.uncacheable++;
+            return;
+        }
+
+        entry.key = key;
+        entry.vertices.assign(list->VtxBuffer.Data + key.prefixVertices, list->VtxBuffer.Data + list->VtxBuffer.Size);
+        entry.indices.assign(list->IdxBuffer.Data + key.prefixIndices, list->IdxBuffer.Data + list->IdxBuffer.Size);
+        entry.commands.assign(list->CmdBuffer.Data + key.prefixCommands - 1, list->CmdBuffer.Data + list->CmdBuffer.Size);
+        entry.vertexCurrentIndex = list->_VtxCurrentIdx;
+        entry.header = list->_CmdHeader;
+        entry.cursorPosition = window->DC.CursorPos;
+        entry.cursorMaxPosition = window->DC.CursorMaxPos;
+        entry.idealMaxPosition = window->DC.IdealMaxPos;
+        entry.navLayers = window->DC.NavLayersActiveMaskNext;
+        entry.recordedFrame = ImGui::GetFrameCount();
+        entry.valid = true;
+    }
+
+    void ImGuiWindowCache::invalidate(const char* name) {
+        auto found = m_entries.find(ImHashStr(name));
+        if (found != m_entries.end()) {
+            found->second.valid = false;
+        }
+    }
+
+    void ImGuiWindowCache::invalidateAll() {
+        m_entries.clear();
+    }
+
+    void ImGuiWindowCache::setEnabled(bool enabled) {
+        m_enabled = enabled;
+        if (!enabled) {
+            m_entries.clear(); //    
+        }
+    }
+
+    ImGuiCacheStats ImGuiWindowCache::stats() const {
+        ImGuiCacheStats result = m_stats;
+        result.cachedBytes = 0;
+        for (const auto& entry : m_entries) {
+            result.cachedBytes += entry.second.vertices.size() * sizeof(ImDrawVert) + entry.second.indices.size() * sizeof(ImDrawIdx) +
+                entry.second.commands.size() * sizeof(ImDrawCmd);
+        }
+        return result;
+    }
+
+    void ImGuiWindowCache::resetStats() {
+        m_stats = ImGuiCacheStats{};
+    }
+}
@@ -0,0 +1,315 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    static thread_local uint32_t t_queueIndex = 0; //   ,      0
+
+    void JobSystem::initialize(uint32_t workerCount) {
+        if (workerCount == UINT32_MAX) {
+            const uint32_t cores = std::thread::hardware_concurrency();
+            workerCount = cores > 1 ? cores - 1 : 0; //     
+        }
+
+        m_queueCount = workerCount + 1;
+        m_queues.reset(new WorkQueue[m_queueCount]);
+        m_mainThread = std::this_thread::get_id();
+        t_queueIndex = 0;
+        m_running.store(true);
+
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 1; i <= workerCount; i++) {
+            m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+
+        LOG_INFO(Jobs, "Jobs: {} worker threads + main thread", workerCount);
+    }
+
+    void JobSystem::shutdown() {
+        if (m_queueCount == 0) {
+            return;
+        }
+
+        m_running.store(false);
+        {
+            std::lock_guard<std::mutex> guard(m_sleepLock);
+            m_wake.notify_all();
+        }
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+
+        //    ,      
+        Job job;
+        while (findJob(0, job) || popMainThread(job)) {
+            execute(job);
+        }
+
+        m_queues.reset();
+        m_queueCount = 0;
+        m_queued.store(0);
+    }
+
+    void JobSystem::schedule(JobFunction function, JobCounter* counter) {
+        if (counter != nullptr) {
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job job{ std::move(function), counter };
+        if (m_queueCount == 0) {
+            execute(job); //     
+            return;
+        }
+
+        WorkQueue& queue = m_queues[t_queueIndex < m_queueCount ? t_queueIndex : 0];
+        {
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.jobs.push_back(std::move(job));
+        }
+        m_queued.fetch_add(1);
+        wake();
+    }
+
+    void JobSystem::scheduleMainThread(JobFunction function, JobCounter* counter) {
+        if (counter != nullptr) {
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> guard(m_mainLock);
+        m_mainJobs.push_back(Job{ std::move(function), counter });
+    }
+
+    void JobSystem::wake() {
+        if (m_sleeping.load() == 0) {
+            return; //        
+        }
+
+        std::lock_guard<std::mutex> guard(m_sleepLock); //       ,   
+        m_wake.notify_one();
+    }
+
+    void JobSystem::execute(Job& job) {
+        {
+            PROFILE_SCOPE("job");
+            job.function();
+        }
+        if (job.counter != nullptr) {
+            job.counter->pending.fetch_sub(1, std::memory_order_release);
+        }
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*
+    *     ,     ,   
+    */
+    bool JobSystem::findJob(uint32_t index, Job& job) {
+        {
+            WorkQueue& own = m_queues[index];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                m_queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        for (uint32_t offset = 1; offset < m_queueCount; offset++) {
+            WorkQueue& victim = m_queues[(index + offset) % m_queueCount];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                m_queued.fetch_sub(1);
+                m_stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::popMainThread(Job& job) {
+        std::lock_guard<std::mutex> guard(m_mainLock);
+        if (m_mainJobs.empty()) {
+            return false;
+        }
+
+        job = std::move(m_mainJobs.front());
+        m_mainJobs.pop_front();
+        m_mainExecuted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void JobSystem::workerLoop(uint32_t index) {
+        t_queueIndex = index;
+        PROFILE_THREAD(fmt::format("Worker {}", index).c_str());
+
+        while (m_running.load()) {
+            Job job;
+            if (findJob(index, job)) {
+                execute(job);
+                continue;
+            }
+
+            //    ,      
+            bool queued = false;
+            for (int spin = 0; spin < 64 && !queued; spin++) {
+                std::this_thread::yield();
+                queued = m_queued.load() > 0;
+            }
+            if (queued) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepLock);
+            m_sleeping.fetch_add(1);
+            m_wake.wait(lock, [this] { return m_queued.load() > 0 || !m_running.load(); });
+            m_sleeping.fetch_sub(1);
+        }
+    }
+
+    /*
+    *   :    ,    ,     
+    */
+    void JobSystem::wait(JobCounter& counter) {
+        const bool mainThread = std::this_thread::get_id() == m_mainThread;
+
+        while (!counter.done()) {
+            Job job;
+            if (mainThread && popMainThread(job)) {
+                execute(job);
+            }
+            else if (m_queueCount != 0 && findJob(t_queueIndex < m_queueCount ? t_queueIndex : 0, job)) {
+                execute(job);
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::runMainThreadJobs() {
+        size_t count;
+        {
+            std::lock_guard<std::mutex> guard(m_mainLock);
+            count = m_mainJobs.size(); // ,    ,   
+        }
+
+        Job job;
+        while (count-- > 0 && popMainThread(job)) {
+            execute(job);
+        }
+    }
+
+    void JobSystem::parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t begin, uint32_t end)>& function) {
+        if (count == 0) {
+            return;
+        }
+        if (grain == 0) {
+            grain = std::max(1u, count / (std::max(1u, m_queueCount) * 4));
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += grain) {
+            const uint32_t end = std::min(count, begin + grain);
+            schedule([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+        wait(counter);
+    }
+
+    JobStats JobSystem::stats() {
+        JobStats stats;
+        stats.executed = m_executed.load();
+        stats.stolen = m_stolen.load();
+        stats.mainThread = m_mainExecuted.load();
+        return stats;
+    }
+
+    void JobSystem::reportStats() {
+        const uint64_t executed = m_executed.exchange(0);
+        const uint64_t stolen = m_stolen.exchange(0);
+        const uint64_t mainThread = m_mainExecuted.exchange(0);
+        if (executed == 0) {
+            return;
+        }
+
+        LOG_INFO(Jobs, "Jobs ({} threads): {} executed, {} stolen, {} main thread only", m_queueCount, executed, stolen, mainThread);
+    }
+
+    uint32_t JobGraph::add(JobFunction function, bool mainThread) {
+        m_nodes.emplace_back();
+        m_nodes.back().function = std::move(function);
+        m_nodes.back().mainThread = mainThread;
+        return (uint32_t)(m_nodes.size() - 1);
+    }
+
+    void JobGraph::depend(uint32_t node, uint32_t dependency) {
+        m_nodes[dependency].successors.push_back(node);
+        m_nodes[node].dependencies++;
+    }
+
+    void JobGraph::clear() {
+        m_nodes.clear();
+    }
+
+    void JobGraph::submit(JobSystem& jobs, uint32_t index) {
+        JobFunction job = [this, &jobs, index]() {
+            Node& node = m_nodes[index];
+            node.function();
+
+            //       ,      
+            for (uint32_t successor : node.successors) {
+                if (m_nodes[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    submit(jobs, successor);
+                }
+            }
+        };
+
+        if (m_nodes[index].mainThread) {
+            jobs.scheduleMainThread(std::move(job), &m_counter);
+        }
+        else {
+            jobs.schedule(std::move(job), &m_counter);
+        }
+    }
+
+    /*
+    *      .  mainThread ,   run    
+    */
+    bool JobGraph::run(JobSystem& jobs) {
+        //    ( ):      ,  wait  
+        std::vector<uint32_t> degree(m_nodes.size());
+        std::vector<uint32_t> ready;
+        for (uint32_t i = 0; i < m_nodes.size(); i++) {
+            degree[i] = m_nodes[i].dependencies;
+            if (degree[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+        size_t visited = 0;
+        while (visited < ready.size()) {
+            for (uint32_t successor : m_nodes[ready[visited++]].successors) {
+                if (--degree[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+        if (visited != m_nodes.size()) {
+            LOG_ERROR(Jobs, "Job graph has a dependency cycle, {} nodes can't run", m_nodes.size() - visited);
+            return false;
+        }
+
+        for (Node& node : m_nodes) {
+            node.remaining.store(node.dependencies, std::memory_order_relaxed);
+        }
+        for (uint32_t i = 0; i < m_nodes.size(); i++) {
+            if (m_nodes[i].dependencies == 0) {
+                submit(jobs, i);
+            }
+        }
+
+        jobs.wait(m_counter);
+        return true;
+    }
+}
@@ -0,0 +1,125 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace Engine {
+    std::atomic<int> Log::s_levels[(size_t)LogChannel::Count];
+    std::shared_ptr<spdlog::logger> Log::s_loggers[(size_t)LogChannel::Count];
+    std::shared_ptr<spdlog::details::thread_pool> Log::s_threadPool;
+
+    static const char* channelNames[] = { "core", "vulkan", "device", "memory", "frames", "swapchain", "upload", "jobs", "profiler", "world" };
+    static_assert(sizeof(channelNames) / sizeof(channelNames[0]) == (size_t)LogChannel::Count, "channelNames must match LogChannel");
+
+    const char* logChannelName(LogChannel channel) {
+        return (size_t)channel < (size_t)LogChannel::Count ? channelNames[(size_t)channel] : "?";
+    }
+
+    void Log::initialize(const Settings& settings) {
+        std::vector<spdlog::sink_ptr> sinks;
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        if (!settings.file.empty()) {
+            try {
+                sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.file, true));
+            }
+            catch (const spdlog::spdlog_ex& error) {
+                fprintf(stderr, "Can't open log file '%s': %s\n", settings.file.c_str(), error.what());
+            }
+        }
+
+        //  ,    spdlog: shutdown         spdlog
+        if (settings.async) {
+            s_threadPool = std::make_shared<spdlog::details::thread_pool>(std::max<size_t>(settings.queueSize, 64), 1);
+        }
+
+        for (size_t i = 0; i < (size_t)LogChannel::Count; i++) {
+            std::shared_ptr<spdlog::logger> logger;
+            if (s_threadPool) {
+                logger = std::make_shared<spdlog::async_logger>(channelNames[i], sinks.begin(), sinks.end(), s_threadPool, spdlog::async_overflow_policy::overrun_oldest);
+            }
+            else {
+                logger = std::make_shared<spdlog::logger>(channelNames[i], sinks.begin(), sinks.end());
+            }
+            logger->set_pattern("[%H:%M:%S.%e] [%n] [%^%l%$] %v");
+            logger->set_level(spdlog::level::trace); //     ,   
+            logger->flush_on(spdlog::level::err);
+            s_loggers[i] = logger;
+        }
+
+        //    ,       
+#ifdef NDEBUG
+        setLevel(spdlog::level::warn);
+#else
+        setLevel(spdlog::level::info);
+#endif
+    }
+
+    void Log::shutdown() {
+        for (auto& logger : s_loggers) {
+            if (logger) {
+                logger->flush();
+            }
+            logger.reset();
+        }
+
+        //         
+        s_threadPool.reset();
+    }
+
+    void Log::setLevel(LogChannel channel, spdlog::level::level_enum level) {
+        s_levels[(size_t)channel].store((int)level, std::memory_order_relaxed);
+    }
+
+    void Log::setLevel(spdlog::level::level_enum level) {
+        for (size_t i = 0; i < (size_t)LogChannel::Count; i++) {
+            setLevel((LogChannel)i, level);
+        }
+    }
+
+    static bool parseLevel(const std::string& name, spdlog::level::level_enum& level) {
+        level = spdlog::level::from_str(name);
+        return level != spdlog::level::off || name == "off"; // from_str  off   
+    }
+
+    bool Log::configure(const std::string& spec) {
+        bool valid = true;
+        size_t begin = 0;
+        while (begin <= spec.size()) {
+            size_t end = spec.find(',', begin);
+            end = end == std::string::npos ? spec.size() : end;
+            const std::string item = spec.substr(begin, end - begin);
+            begin = end + 1;
+            if (item.empty()) {
+                continue;
+            }
+
+            const size_t equals = item.find('=');
+            spdlog::level::level_enum level;
+            if (equals == std::string::npos) {
+                if (parseLevel(item, level)) {
+                    setLevel(level);
+                    continue;
+                }
+            }
+            else if (parseLevel(item.substr(equals + 1), level)) {
+                const std::string name = item.substr(0, equals);
+                const char* const* channel = std::find_if(std::begin(channelNames), std::end(channelNames), [&name](const char* channel) { return name == channel; });
+                if (channel != std::end(channelNames)) {
+                    setLevel((LogChannel)(channel - std::begin(channelNames)), level);
+                    continue;
+                }
+            }
+
+            LOG_WARNING(Core, "Unknown log setting '{}'", item);
+            valid = false;
+        }
+
+        return valid;
+    }
+
+    uint64_t Log::dropped() {
+        return s_threadPool ? s_threadPool->overrun_counter() : 0;
+    }
+}
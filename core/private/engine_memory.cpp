@@ -0,0 +1,610 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    static uint32_t log2Ceil(VkDeviceSize value) {
+        uint32_t order = 0;
+        while (((VkDeviceSize)1 << order) < value) {
+            order++;
+        }
+
+        return order;
+    }
+
+    static uint32_t log2Floor(VkDeviceSize value) {
+        uint32_t order = 0;
+        while (((VkDeviceSize)2 << order) <= value) {
+            order++;
+        }
+
+        return order;
+    }
+
+    void DeviceAllocator::initialize(VkPhysicalDevice physicalDevice, VkDevice device, const VkAllocationCallbacks* allocator, bool budgetExtension, VkDeviceSize blockSize) {
+        m_physicalDevice = physicalDevice;
+        m_device = device;
+        m_allocator = allocator;
+        m_budgetExtension = budgetExtension;
+        m_blockSize = blockSize;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+        /*
+        *    bufferImageGranularity  nonCoherentAtomSize:
+        * buddy     ,       
+        *    ,  flush    
+        */
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        m_minAllocation = std::max<VkDeviceSize>({ 256, properties.limits.bufferImageGranularity, properties.limits.nonCoherentAtomSize });
+        m_minOrder = log2Ceil(m_minAllocation);
+        m_minAllocation = (VkDeviceSize)1 << m_minOrder;
+
+        m_pools.resize(m_memoryProperties.memoryTypeCount);
+        for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+            //      ,    ( BAR 256 )    
+            const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[i].heapIndex].size;
+            m_pools[i].blockOrder = std::max(m_minOrder, log2Floor(std::min(m_blockSize, std::max<VkDeviceSize>(heapSize / 8, 1))));
+        }
+    }
+
+    void DeviceAllocator::shutdown() {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        if (m_allocationCount != 0) {
+            LOG_WARNING(Memory, "Device allocator shutdown with {} live allocations", m_allocationCount);
+        }
+
+        for (auto& pool : m_pools) {
+            for (auto& block : pool.blocks) {
+                if (block.memory != VK_NULL_HANDLE) {
+                    vkFreeMemory(m_device, block.memory, m_allocator); //     
+                }
+            }
+        }
+
+        m_pools.clear();
+        m_movable.clear();
+        m_device = VK_NULL_HANDLE;
+    }
+
+    uint32_t DeviceAllocator::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) const {
+        //       ,   
+        for (VkMemoryPropertyFlags flags : { required | preferred, required }) {
+            for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+                if ((typeBits & (1u << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+                    return i;
+                }
+            }
+        }
+
+        return UINT32_MAX;
+    }
+
+    uint32_t DeviceAllocator::orderFor(VkDeviceSize size) const {
+        return std::max(m_minOrder, log2Ceil(size));
+    }
+
+    uint32_t DeviceAllocator::createBlock(uint32_t memoryType) {
+        MemoryPool& pool = m_pools[memoryType];
+
+        VkMemoryAllocateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        info.allocationSize = (VkDeviceSize)1 << pool.blockOrder;
+        info.memoryTypeIndex = memoryType;
+
+        Block block;
+        if (vkAllocateMemory(m_device, &info, m_allocator, &block.memory) != VK_SUCCESS) {
+            return UINT32_MAX; //  ,    
+        }
+
+        if (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            VkResult result = vkMapMemory(m_device, block.memory, 0, VK_WHOLE_SIZE, 0, (void**)&block.mapped);
+            Core::checkVkResult(result);
+        }
+
+        block.freeLists.resize(pool.blockOrder + 1);
+        block.freeLists[pool.blockOrder].insert(0);
+
+        //   ,   ,      
+        for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+            if (pool.blocks[i].memory == VK_NULL_HANDLE) {
+                pool.blocks[i] = std::move(block);
+                return i;
+            }
+        }
+
+        pool.blocks.push_back(std::move(block));
+        return (uint32_t)pool.blocks.size() - 1;
+    }
+
+    bool DeviceAllocator::allocateFromBlock(uint32_t memoryType, uint32_t blockIndex, uint32_t order, MemoryAllocation& allocation) {
+        MemoryPool& pool = m_pools[memoryType];
+        Block& block = pool.blocks[blockIndex];
+        if (block.memory == VK_NULL_HANDLE) {
+            return false;
+        }
+
+        //     
+        uint32_t current = order;
+        while (current <= pool.blockOrder && block.freeLists[current].empty()) {
+            current++;
+        }
+        if (current > pool.blockOrder) {
+            return false;
+        }
+
+        const VkDeviceSize offset = *block.freeLists[current].begin();
+        block.freeLists[current].erase(block.freeLists[current].begin());
+
+        //   ,      ;     
+        while (current > order) {
+            current--;
+            block.freeLists[current].insert(offset + ((VkDeviceSize)1 << current));
+        }
+
+        block.used += (VkDeviceSize)1 << order;
+
+        allocation.memory = block.memory;
+        allocation.offset = offset;
+        allocation.size = (VkDeviceSize)1 << order;
+        allocation.mapped = block.mapped ? block.mapped + offset : nullptr;
+        allocation.propertyFlags = m_memoryProperties.memoryTypes[memoryType].propertyFlags;
+        allocation.memoryType = memoryType;
+        allocation.block = blockIndex;
+        allocation.order = order;
+        return true;
+    }
+
+    bool DeviceAllocator::allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, MemoryAllocation& allocation) {
+        const auto start = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        const uint32_t memoryType = findMemoryType(requirements.memoryTypeBits, required, preferred);
+        if (memoryType == UINT32_MAX) {
+            return false;
+        }
+
+        MemoryPool& pool = m_pools[memoryType];
+        const uint32_t order = orderFor(std::max(requirements.size, requirements.alignment));
+
+        bool allocated = false;
+        if (order < pool.blockOrder) {
+            for (uint32_t i = 0; i < pool.blocks.size() && !allocated; i++) {
+                allocated = allocateFromBlock(memoryType, i, order, allocation);
+            }
+            if (!allocated) {
+                const uint32_t blockIndex = createBlock(memoryType);
+                allocated = blockIndex != UINT32_MAX && allocateFromBlock(memoryType, blockIndex, order, allocation);
+            }
+        }
+
+        //      -  
+        if (!allocated) {
+            VkMemoryAllocateInfo info{};
+            info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            info.allocationSize = requirements.size;
+            info.memoryTypeIndex = memoryType;
+
+            allocation = MemoryAllocation{};
+            if (vkAllocateMemory(m_device, &info, m_allocator, &allocation.memory) != VK_SUCCESS) {
+                return false;
+            }
+
+            allocation.propertyFlags = m_memoryProperties.memoryTypes[memoryType].propertyFlags;
+            if (allocation.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+                VkResult result = vkMapMemory(m_device, allocation.memory, 0, VK_WHOLE_SIZE, 0, (void**)&allocation.mapped);
+                Core::checkVkResult(result);
+            }
+            allocation.size = requirements.size;
+            allocation.memoryType = memoryType;
+            m_dedicatedCount++;
+            m_dedicatedBytes += requirements.size;
+            pool.dedicatedBytes += requirements.size;
+        }
+
+        m_allocationCount++;
+        m_allocateCalls++;
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        m_allocateNsSum += elapsed;
+        m_allocateNsMax = std::max(m_allocateNsMax, elapsed);
+        return true;
+    }
+
+    void DeviceAllocator::freeFromBlock(MemoryAllocation& allocation) {
+        MemoryPool& pool = m_pools[allocation.memoryType];
+        Block& block = pool.blocks[allocation.block];
+
+        //     "",   
+        VkDeviceSize offset = allocation.offset;
+        uint32_t order = allocation.order;
+        while (order < pool.blockOrder) {
+            const VkDeviceSize buddy = offset ^ ((VkDeviceSize)1 << order);
+            auto found = block.freeLists[order].find(buddy);
+            if (found == block.freeLists[order].end()) {
+                break;
+            }
+
+            block.freeLists[order].erase(found);
+            offset = std::min(offset, buddy);
+            order++;
+        }
+        block.freeLists[order].insert(offset);
+        block.used -= (VkDeviceSize)1 << allocation.order;
+
+        //    ,         
+        if (block.used == 0) {
+            uint32_t liveBlocks = 0;
+            for (const auto& other : pool.blocks) {
+                liveBlocks += other.memory != VK_NULL_HANDLE ? 1 : 0;
+            }
+            if (liveBlocks > 1) {
+                vkFreeMemory(m_device, block.memory, m_allocator);
+                block = Block{};
+            }
+        }
+    }
+
+    void DeviceAllocator::free(MemoryAllocation& allocation) {
+        if (allocation.memory == VK_NULL_HANDLE) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (allocation.block == UINT32_MAX) {
+            vkFreeMemory(m_device, allocation.memory, m_allocator);
+            m_dedicatedCount--;
+            m_dedicatedBytes -= allocation.size;
+            m_pools[allocation.memoryType].dedicatedBytes -= allocation.size;
+        }
+        else {
+            freeFromBlock(allocation);
+        }
+
+        m_movable.erase(&allocation);
+        m_allocationCount--;
+        allocation = MemoryAllocation{};
+    }
+
+    void DeviceAllocator::registerMovable(MemoryAllocation* allocation, DefragmentCallback callback, void* userData) {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_movable[allocation] = Movable{ callback, userData };
+    }
+
+    void DeviceAllocator::unregisterMovable(MemoryAllocation* allocation) {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_movable.erase(allocation);
+    }
+
+    /*
+    *             ,
+    *     .          
+    */
+    uint32_t DeviceAllocator::defragment(uint32_t maxMoves) {
+        std::lock_guard<std::mutex> guard(m_lock);
+        uint32_t moves = 0;
+
+        for (uint32_t memoryType = 0; memoryType < m_pools.size() && moves < maxMoves; memoryType++) {
+            MemoryPool& pool = m_pools[memoryType];
+
+            //  -     ,        
+            uint32_t source = UINT32_MAX;
+            uint32_t liveBlocks = 0;
+            for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+                if (pool.blocks[i].memory == VK_NULL_HANDLE) {
+                    continue;
+                }
+                liveBlocks++;
+                if (source == UINT32_MAX || pool.blocks[i].used < pool.blocks[source].used) {
+                    source = i;
+                }
+            }
+            if (liveBlocks < 2 || pool.blocks[source].used * 2 > ((VkDeviceSize)1 << pool.blockOrder)) {
+                continue;
+            }
+
+            for (auto& [allocation, movable] : m_movable) {
+                if (moves >= maxMoves || pool.blocks[source].memory == VK_NULL_HANDLE) {
+                    break;
+                }
+                if (allocation->memoryType != memoryType || allocation->block != source) {
+                    continue;
+                }
+
+                MemoryAllocation moved;
+                bool allocated = false;
+                for (uint32_t i = 0; i < pool.blocks.size() && !allocated; i++) {
+                    allocated = i != source && allocateFromBlock(memoryType, i, allocation->order, moved);
+                }
+                if (!allocated) {
+                    break; //     
+                }
+
+                movable.callback(*allocation, moved, movable.userData);
+                MemoryAllocation old = *allocation;
+                freeFromBlock(old);
+                *allocation = moved;
+                moves++;
+            }
+        }
+
+        return moves;
+    }
+
+    MemoryStats DeviceAllocator::stats() {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        MemoryStats result;
+        VkDeviceSize freeBytes = 0;
+        VkDeviceSize largestFree = 0;
+        for (const auto& pool : m_pools) {
+            for (const auto& block : pool.blocks) {
+                if (block.memory == VK_NULL_HANDLE) {
+                    continue;
+                }
+
+                result.blockCount++;
+                result.reservedBytes += (VkDeviceSize)1 << pool.blockOrder;
+                result.usedBytes += block.used;
+                for (uint32_t order = 0; order < block.freeLists.size(); order++) {
+                    if (!block.freeLists[order].empty()) {
+                        freeBytes += block.freeLists[order].size() * ((VkDeviceSize)1 << order);
+                        largestFree = std::max(largestFree, (VkDeviceSize)1 << order);
+                    }
+                }
+            }
+        }
+
+        result.dedicatedCount = m_dedicatedCount;
+        result.reservedBytes += m_dedicatedBytes;
+        result.usedBytes += m_dedicatedBytes;
+        result.allocationCount = m_allocationCount;
+        result.fragmentation = freeBytes ? 1.0 - (double)largestFree / (double)freeBytes : 0.0;
+        result.averageAllocateNs = m_allocateCalls ? m_allocateNsSum / m_allocateCalls : 0.0;
+        result.maxAllocateNs = m_allocateNsMax;
+        return result;
+    }
+
+    MemoryBudget DeviceAllocator::budget() {
+        MemoryBudget result;
+        result.heaps.resize(m_memoryProperties.memoryHeapCount);
+        for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; i++) {
+            result.heaps[i].size = m_memoryProperties.memoryHeaps[i].size;
+            result.heaps[i].flags = m_memoryProperties.memoryHeaps[i].flags;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            for (uint32_t memoryType = 0; memoryType < m_pools.size(); memoryType++) {
+                const MemoryPool& pool = m_pools[memoryType];
+                MemoryHeapBudget& heap = result.heaps[m_memoryProperties.memoryTypes[memoryType].heapIndex];
+                heap.allocated += pool.dedicatedBytes;
+                for (const auto& block : pool.blocks) {
+                    heap.allocated += block.memory != VK_NULL_HANDLE ? (VkDeviceSize)1 << pool.blockOrder : 0;
+                }
+            }
+        }
+
+        if (m_budgetExtension) {
+            //  ,    ,     
+            VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+            budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+            VkPhysicalDeviceMemoryProperties2 properties{};
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+            properties.pNext = &budget;
+            vkGetPhysicalDeviceMemoryProperties2(m_physicalDevice, &properties);
+
+            for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; i++) {
+                result.heaps[i].budget = budget.heapBudget[i];
+                result.heaps[i].usage = budget.heapUsage[i];
+            }
+            result.fromExtension = true;
+        }
+        else {
+            for (MemoryHeapBudget& heap : result.heaps) {
+                heap.budget = heap.size;
+                heap.usage = heap.allocated;
+            }
+        }
+
+        return result;
+    }
+
+    /*
+    *    ImGui:      
+    */
+    bool Core::imguiAllocateMemory(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags properties, ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData) {
+        Core* core = (Core*)userData;
+        MemoryAllocation* handle = new MemoryAllocation();
+
+        //  host visible   ,     flush
+        const VkMemoryPropertyFlags preferred = (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
+        if (!core->memoryAllocator.allocate(*requirements, properties, preferred, *handle)) {
+            delete handle;
+            return false;
+        }
+
+        allocation->Memory = handle->memory;
+        allocation->Offset = handle->offset;
+        allocation->Size = handle->size;
+        allocation->MappedData = handle->mapped;
+        allocation->PropertyFlags = handle->propertyFlags;
+        allocation->Handle = handle;
+        return true;
+    }
+
+    void Core::imguiFreeMemory(ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData) {
+        Core* core = (Core*)userData;
+        MemoryAllocation* handle = (MemoryAllocation*)allocation->Handle;
+        if (handle != nullptr) {
+            core->memoryAllocator.free(*handle);
+            delete handle;
+        }
+
+        *allocation = ImGui_ImplVulkan_MemoryAllocation{};
+    }
+
+    void Core::reportMemoryStats() {
+        const MemoryStats stats = memoryAllocator.stats();
+        LOG_INFO(Memory, "Device memory: {} blocks, {} dedicated, {} allocations, {}/{} KiB used, fragmentation {:.1f}%, allocate avg {:.0f} ns, max {:.0f} ns",
+            stats.blockCount, stats.dedicatedCount, stats.allocationCount, stats.usedBytes >> 10, stats.reservedBytes >> 10,
+            stats.fragmentation * 100.0, stats.averageAllocateNs, stats.maxAllocateNs);
+
+        //       ( , ),    -    
+        if (memoryBudget) {
+            const MemoryBudget budget = memoryAllocator.budget();
+            for (size_t i = 0; i < budget.heaps.size(); i++) {
+                const MemoryHeapBudget& heap = budget.heaps[i];
+                if (heap.budget != 0 && heap.usage * 10 > heap.budget * 9) {
+                    LOG_WARNING(Memory, "Heap {} is at {} of {} MiB budget", i, heap.usage >> 20, heap.budget >> 20);
+                }
+            }
+        }
+
+        if (allocator != nullptr) {
+            hostAllocator.reportStats();
+        }
+    }
+
+    static uint64_t mixVersion(uint64_t hash, uint64_t value) {
+        hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 29);
+    }
+
+    /*
+    *  :          .
+    *   imguiCache:  -    ,    ,   
+    */
+    void Core::drawMemoryWindow(bool* open) {
+        const HostMemoryStats hostStats = allocator != nullptr ? hostAllocator.stats() : HostMemoryStats{};
+        const HostMemoryStats previousHostStats = memoryWindowStats;
+        memoryWindowStats = hostStats; //  ,      : " " -   
+        const MemoryStats stats = memoryAllocator.stats();
+        const MemoryBudget budget = memoryAllocator.budget();
+
+        uint64_t version = mixVersion(allocator != nullptr ? 1 : 0, hostStats.liveBytes);
+        version = mixVersion(version, hostStats.peakBytes);
+        version = mixVersion(version, hostStats.arenas);
+        version = mixVersion(version, hostStats.arenaAllocations);
+        version = mixVersion(version, hostStats.arenaFallbacks);
+        for (uint32_t i = 0; i < HostScopeCount; i++) {
+            const HostScopeStats& scope = hostStats.scopes[i];
+            version = mixVersion(version, scope.liveAllocations);
+            version = mixVersion(version, scope.liveBytes);
+            version = mixVersion(version, scope.peakBytes);
+            version = mixVersion(version, scope.allocations);
+            version = mixVersion(version, scope.allocations - previousHostStats.scopes[i].allocations);
+            version = mixVersion(version, scope.internalBytes);
+        }
+        uint64_t fragmentation;
+        memcpy(&fragmentation, &stats.fragmentation, sizeof(fragmentation));
+        version = mixVersion(version, stats.blockCount);
+        version = mixVersion(version, stats.dedicatedCount);
+        version = mixVersion(version, stats.allocationCount);
+        version = mixVersion(version, fragmentation);
+        version = mixVersion(version, budget.fromExtension);
+        for (const MemoryHeapBudget& heap : budget.heaps) {
+            version = mixVersion(version, heap.size);
+            version = mixVersion(version, heap.budget);
+            version = mixVersion(version, heap.usage);
+            version = mixVersion(version, heap.allocated);
+            version = mixVersion(version, heap.flags);
+        }
+
+        if (!imguiCache.begin(u8"", version, open)) {
+            imguiCache.end();
+            return;
+        }
+
+        if (ImGui::Button(u8" ")) {
+            writeMemoryReport("memory_report.json");
+        }
+
+        if (allocator != nullptr) {
+            ImGui::Text(u8"  : %.1f ,  %.1f ", hostStats.liveBytes / 1024.0, hostStats.peakBytes / 1024.0);
+            ImGui::Text(u8" : %u  %llu , %llu ,   %llu", hostStats.arenas, (unsigned long long)(HostAllocator::ArenaSize >> 10),
+                (unsigned long long)hostStats.arenaAllocations, (unsigned long long)hostStats.arenaFallbacks);
+
+            if (ImGui::BeginTable("host", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn(u8"");
+                ImGui::TableSetupColumn(u8"");
+                ImGui::TableSetupColumn(u8"");
+                ImGui::TableSetupColumn(u8" ");
+                ImGui::TableSetupColumn(u8"");
+                ImGui::TableSetupColumn(u8" ");
+                ImGui::TableSetupColumn(u8". ");
+                ImGui::TableHeadersRow();
+                for (uint32_t i = 0; i < HostScopeCount; i++) {
+                    const HostScopeStats& scope = hostStats.scopes[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(allocationScopeName(i));
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)scope.liveAllocations);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", scope.liveBytes / 1024.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", scope.peakBytes / 1024.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)scope.allocations);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)(scope.allocations - previousHostStats.scopes[i].allocations));
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", scope.internalBytes / 1024.0);
+                }
+                ImGui::EndTable();
+            }
+        }
+        else {
+            ImGui::TextUnformatted(u8" :   (--host-allocator=0)");
+        }
+
+        ImGui::Text(u8" : %u , %u , %llu ,  %.1f%%", stats.blockCount, stats.dedicatedCount,
+            (unsigned long long)stats.allocationCount, stats.fragmentation * 100.0);
+
+        ImGui::Text(u8"  (%s):", budget.fromExtension ? "VK_EXT_memory_budget" : u8"  ");
+        for (size_t i = 0; i < budget.heaps.size(); i++) {
+            const MemoryHeapBudget& heap = budget.heaps[i];
+            char overlay[96];
+            snprintf(overlay, sizeof(overlay), u8"%llu / %llu ,  %llu ", (unsigned long long)(heap.usage >> 20), (unsigned long long)(heap.budget >> 20), (unsigned long long)(heap.allocated >> 20));
+            ImGui::Text(u8"%zu %s, %llu ", i, (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "device local" : "host", (unsigned long long)(heap.size >> 20));
+            ImGui::ProgressBar(heap.budget ? (float)((double)heap.usage / (double)heap.budget) : 0.0f, ImVec2(-1.0f, 0.0f), overlay);
+        }
+
+        imguiCache.end();
+    }
+
+    /*
+    *     JSON    
+    */
+    bool Core::writeMemoryReport(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            LOG_ERROR(Memory, "Can't write memory report {}", path);
+            return false;
+        }
+
+        const HostMemoryStats host = hostAllocator.stats();
+        fprintf(file, "{\n\"host\":{\"enabled\":%s,\"liveBytes\":%llu,\"peakBytes\":%llu,\"arenas\":%u,\"arenaBytes\":%llu,\"arenaAllocations\":%llu,\"arenaFallbacks\":%llu,\"scopes\":{",
+            allocator != nullptr ? "true" : "false", (unsigned long long)host.liveBytes, (unsigned long long)host.peakBytes, host.arenas,
+            (unsigned long long)host.arenaBytes, (unsigned long long)host.arenaAllocations, (unsigned long long)host.arenaFallbacks);
+        for (uint32_t i = 0; i < HostScopeCount; i++) {
+            const HostScopeStats& scope = host.scopes[i];
+            fprintf(file, "%s\n  \"%s\":{\"allocations\":%llu,\"reallocations\":%llu,\"frees\":%llu,\"liveAllocations\":%llu,\"liveBytes\":%llu,\"peakBytes\":%llu,\"internalBytes\":%llu,\"internalPeakBytes\":%llu}",
+                i ? "," : "", allocationScopeName(i), (unsigned long long)scope.allocations, (unsigned long long)scope.reallocations, (unsigned long long)scope.frees,
+                (unsigned long long)scope.liveAllocations, (unsigned long long)scope.liveBytes, (unsigned long long)scope.peakBytes,
+                (unsigned long long)scope.internalBytes, (unsigned long long)scope.internalPeakBytes);
+        }
+
+        const MemoryStats device = memoryAllocator.stats();
+        fprintf(file, "}},\n\"device\":{\"blocks\":%u,\"dedicated\":%u,\"allocations\":%llu,\"reservedBytes\":%llu,\"usedBytes\":%llu,\"fragmentation\":%.4f},\n",
+            device.blockCount, device.dedicatedCount, (unsigned long long)device.allocationCount, (unsigned long long)device.reservedBytes,
+            (unsigned long long)device.usedBytes, device.fragmentation);
+
+        const MemoryBudget budget = memoryAllocator.budget();
+        fprintf(file, "\"budget\":{\"fromExtension\":%s,\"heaps\":[", budget.fromExtension ? "true" : "false");
+        for (size_t i = 0; i < budget.heaps.size(); i++) {
+            const MemoryHeapBudget& heap = budget.heaps[i];
+            fprintf(file, "%s\n  {\"size\":%llu,\"budget\":%llu,\"usage\":%llu,\"allocated\":%llu,\"deviceLocal\":%s}", i ? "," : "",
+                (unsigned long long)heap.size, (unsigned long long)heap.budget, (unsigned long long)heap.usage, (unsigned long long)heap.allocated,
+                (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "true" : "false");
+        }
+        fprintf(file, "]}\n}\n");
+
+        fclose(file);
+        LOG_INFO(Memory, "Memory report written to {}", path);
+        return true;
+    }
+}
@@ -0,0 +1,270 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <filesystem>
+
+namespace Engine {
+    /*
+    *      .    imguiWindowData  ,    ,
+    *  frameRender  ImGui      .      TRANSFER_SRC
+    */
+    void Core::createOffscreenTarget(ImGui_ImplVulkanH_Window* window, int width, int height) {
+        VkResult result;
+
+        window->Width = width;
+        window->Height = height;
+        window->SurfaceFormat = { VK_FORMAT_R8G8B8A8_UNORM, VK_COLORSPACE_SRGB_NONLINEAR_KHR };
+        if (minImageCount == 0) {
+            minImageCount = 2; //   ,  ImGui       
+        }
+        //      ,     .  --frames-in-flight=1     
+        window->ImageCount = std::max(framesInFlight, (uint32_t)minImageCount);
+        window->FrameIndex = 0;
+        createSwapchainRenderPass(window, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+        window->Frames = (ImGui_ImplVulkanH_Frame*)IM_ALLOC(sizeof(ImGui_ImplVulkanH_Frame) * window->ImageCount);
+        memset(window->Frames, 0, sizeof(window->Frames[0]) * window->ImageCount);
+        offscreenImages.resize(window->ImageCount);
+
+        const VkDeviceSize readbackSize = (VkDeviceSize)width * height * 4;
+        for (uint32_t i = 0; i < window->ImageCount; i++) {
+            OffscreenImage& target = offscreenImages[i];
+            ImGui_ImplVulkanH_Frame* frame = &window->Frames[i];
+            {
+                VkImageCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                info.imageType = VK_IMAGE_TYPE_2D;
+                info.format = window->SurfaceFormat.format;
+                info.extent = { (uint32_t)width, (uint32_t)height, 1 };
+                info.mipLevels = 1;
+                info.arrayLayers = 1;
+                info.samples = VK_SAMPLE_COUNT_1_BIT;
+                info.tiling = VK_IMAGE_TILING_OPTIMAL;
+                info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+                info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                result = vkCreateImage(logicalDevice, &info, allocator, &target.image);
+                checkVkResult(result);
+
+                VkMemoryRequirements requirements;
+                vkGetImageMemoryRequirements(logicalDevice, target.image, &requirements);
+                if (!memoryAllocator.allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, target.memory)) {
+                    callback(3, "can't allocate offscreen image");
+                    abort();
+                }
+                result = vkBindImageMemory(logicalDevice, target.image, target.memory.memory, target.memory.offset);
+                checkVkResult(result);
+            }
+            {
+                VkBufferCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                info.size = readbackSize;
+                info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+                info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                result = vkCreateBuffer(logicalDevice, &info, allocator, &target.readbackBuffer);
+                checkVkResult(result);
+
+                // CPU   ,      write combined
+                VkMemoryRequirements requirements;
+                vkGetBufferMemoryRequirements(logicalDevice, target.readbackBuffer, &requirements);
+                if (!memoryAllocator.allocate(requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT, target.readbackMemory)) {
+                    callback(3, "can't allocate readback buffer");
+                    abort();
+                }
+                result = vkBindBufferMemory(logicalDevice, target.readbackBuffer, target.readbackMemory.memory, target.readbackMemory.offset);
+                checkVkResult(result);
+            }
+
+            frame->Backbuffer = target.image;
+            {
+                VkImageViewCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                info.image = target.image;
+                info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                info.format = window->SurfaceFormat.format;
+                info.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+                info.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+                result = vkCreateImageView(logicalDevice, &info, allocator, &frame->BackbufferView);
+                checkVkResult(result);
+            }
+            {
+                VkFramebufferCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+                info.renderPass = window->RenderPass;
+                info.attachmentCount = 1;
+                info.pAttachments = &frame->BackbufferView;
+                info.width = (uint32_t)width;
+                info.height = (uint32_t)height;
+                info.layers = 1;
+                result = vkCreateFramebuffer(logicalDevice, &info, allocator, &frame->Framebuffer);
+                checkVkResult(result);
+            }
+        }
+
+        if (!frameDumpDirectory.empty()) {
+            std::error_code error;
+            std::filesystem::create_directories(frameDumpDirectory, error);
+            if (error) {
+                LOG_WARNING(Frames, "Can't create frame dump directory '{}': {}", frameDumpDirectory, error.message());
+            }
+        }
+
+        headlessStats = HeadlessStats{};
+        LOG_INFO(Frames, "Headless: {}x{}, {} offscreen images", width, height, window->ImageCount);
+    }
+
+    /*
+    *       ,        .
+    *       CPU   
+    */
+    void Core::recordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        const ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        OffscreenImage& target = offscreenImages[imageIndex];
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageExtent = { (uint32_t)window->Width, (uint32_t)window->Height, 1 };
+        vkCmdCopyImageToBuffer(commandBuffer, target.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target.readbackBuffer, 1, &region);
+
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = target.readbackBuffer;
+        barrier.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+        if (headlessStats.frames == 0) {
+            headlessStats.start = HeadlessStats::Clock::now(); // FPS    ,     
+        }
+        target.frameNumber = headlessStats.frames++;
+        target.readbackPending = true;
+    }
+
+    /*
+    *  ,  GPU  :   ,  ,   PPM.
+    *    ,     CPU,  GPU
+    */
+    void Core::collectReadback(uint32_t imageIndex) {
+        OffscreenImage& target = offscreenImages[imageIndex];
+        if (!target.readbackPending) {
+            return;
+        }
+
+        const auto start = HeadlessStats::Clock::now();
+        const ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        const size_t size = (size_t)window->Width * window->Height * 4;
+
+        if (!(target.readbackMemory.propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+            VkMappedMemoryRange range{};
+            range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range.memory = target.readbackMemory.memory;
+            range.offset = target.readbackMemory.offset;
+            range.size = target.readbackMemory.block == UINT32_MAX ? VK_WHOLE_SIZE : target.readbackMemory.size; //     nonCoherentAtomSize
+            VkResult result = vkInvalidateMappedMemoryRanges(logicalDevice, 1, &range);
+            checkVkResult(result);
+        }
+
+        const uint8_t* pixels = target.readbackMemory.mapped;
+        uint64_t checksum = 14695981039346656037ull;
+        for (size_t i = 0; i < size; i++) {
+            checksum = (checksum ^ pixels[i]) * 1099511628211ull;
+        }
+        headlessStats.lastChecksum = checksum;
+        headlessStats.readbacks++;
+
+        if (!frameDumpDirectory.empty() && target.frameNumber % frameDumpEvery == 0) {
+            char name[32];
+            snprintf(name, sizeof(name), "frame_%06llu.ppm", (unsigned long long)target.frameNumber);
+            if (writeFramePPM((std::filesystem::path(frameDumpDirectory) / name).string(), pixels, window->Width, window->Height)) {
+                headlessStats.dumped++;
+            }
+        }
+
+        target.readbackPending = false;
+        headlessStats.readbackMsSum += std::chrono::duration<double, std::milli>(HeadlessStats::Clock::now() - start).count();
+    }
+
+    /*
+    *  PPM (P6):         
+    */
+    bool Core::writeFramePPM(const std::string& path, const uint8_t* rgba, int width, int height) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            LOG_WARNING(Frames, "Can't write frame '{}'", path);
+            return false;
+        }
+
+        std::vector<uint8_t> row((size_t)width * 3);
+        bool written = fprintf(file, "P6\n%d %d\n255\n", width, height) > 0;
+        for (int y = 0; y < height && written; y++) {
+            const uint8_t* source = rgba + (size_t)y * width * 4;
+            for (int x = 0; x < width; x++) {
+                row[x * 3 + 0] = source[x * 4 + 0];
+                row[x * 3 + 1] = source[x * 4 + 1];
+                row[x * 3 + 2] = source[x * 4 + 2];
+            }
+            written = fwrite(row.data(), 1, row.size(), file) == row.size();
+        }
+
+        const bool closed = fclose(file) == 0;
+        if (!written || !closed) {
+            LOG_WARNING(Frames, "Failed to write frame '{}'", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    /*
+    *    ,   .     
+    */
+    void Core::destroyOffscreenTarget(ImGui_ImplVulkanH_Window* window) {
+        for (uint64_t remaining = offscreenImages.size(); remaining > 0; remaining--) {
+            uint32_t oldest = UINT32_MAX;
+            for (uint32_t i = 0; i < offscreenImages.size(); i++) {
+                if (offscreenImages[i].readbackPending && (oldest == UINT32_MAX || offscreenImages[i].frameNumber < offscreenImages[oldest].frameNumber)) {
+                    oldest = i;
+                }
+            }
+            if (oldest == UINT32_MAX) {
+                break;
+            }
+            collectReadback(oldest);
+        }
+        reportHeadlessStats();
+
+        deletionQueue.flush();
+        for (uint32_t i = 0; i < window->ImageCount; i++) {
+            vkDestroyFramebuffer(logicalDevice, window->Frames[i].Framebuffer, allocator);
+            vkDestroyImageView(logicalDevice, window->Frames[i].BackbufferView, allocator);
+        }
+        IM_FREE(window->Frames);
+        window->Frames = nullptr;
+        vkDestroyRenderPass(logicalDevice, window->RenderPass, allocator);
+
+        for (OffscreenImage& target : offscreenImages) {
+            vkDestroyImage(logicalDevice, target.image, allocator);
+            memoryAllocator.free(target.memory);
+            vkDestroyBuffer(logicalDevice, target.readbackBuffer, allocator);
+            memoryAllocator.free(target.readbackMemory);
+        }
+        offscreenImages.clear();
+
+        *window = ImGui_ImplVulkanH_Window();
+    }
+
+    /*
+    *    printf:  CI        
+    */
+    void Core::reportHeadlessStats() {
+        const double seconds = std::chrono::duration<double>(HeadlessStats::Clock::now() - headlessStats.start).count();
+        const double readbackMs = headlessStats.readbacks ? headlessStats.readbackMsSum / headlessStats.readbacks : 0.0;
+
+        printf("headless: %llu frames in %.3f s (%.1f fps), %llu read back (%.3f ms avg), %llu dumped, last checksum %016llx\n",
+            (unsigned long long)headlessStats.frames, seconds, seconds > 0.0 ? headlessStats.frames / seconds : 0.0,
+            (unsigned long long)headlessStats.readbacks, readbackMs, (unsigned long long)headlessStats.dumped, (unsigned long long)headlessStats.lastChecksum);
+    }
+}
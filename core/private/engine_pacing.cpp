@@ -0,0 +1,304 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include "../core/imgui/imgui_internal.h"
+
+#include <thread>
+
+namespace Engine {
+    const char* presentModeName(VkPresentModeKHR mode) {
+        switch (mode) {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return "immediate";
+        case VK_PRESENT_MODE_MAILBOX_KHR: return "mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR: return "fifo";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "relaxed";
+        default: return "unknown";
+        }
+    }
+
+    bool parsePresentMode(const char* name, VkPresentModeKHR& mode) {
+        const VkPresentModeKHR modes[] = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR };
+        for (VkPresentModeKHR candidate : modes) {
+            if (strcmp(name, presentModeName(candidate)) == 0) {
+                mode = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    FramePacer::~FramePacer() {
+#ifdef _WIN32
+        if (m_timer != nullptr) {
+            CloseHandle((HANDLE)m_timer);
+        }
+#endif
+    }
+
+    void FramePacer::setTargetFps(double fps) {
+        m_period = fps > 0.0 ? 1.0 / fps : 0.0;
+        m_deadline = Clock::time_point{}; //      
+    }
+
+    /*
+    *  Sleep  Windows   15.6 ,      (Windows 10 1803+)
+    */
+    void FramePacer::sleepFor(double seconds) {
+#ifdef _WIN32
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        if (m_timer == nullptr) {
+            m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        }
+#endif
+        if (m_timer != nullptr) {
+            LARGE_INTEGER due;
+            due.QuadPart = -(LONGLONG)(seconds * 1e7); //    100 
+            if (SetWaitableTimer((HANDLE)m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+                WaitForSingleObject((HANDLE)m_timer, INFINITE);
+                return;
+            }
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    }
+
+    void FramePacer::wait() {
+        m_stats.frames++;
+        if (m_period <= 0.0) {
+            return;
+        }
+
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_period));
+        auto now = Clock::now();
+        if (m_deadline == Clock::time_point{}) {
+            m_deadline = now + period;
+            return;
+        }
+
+        //   :    ,   
+        const double remaining = std::chrono::duration<double>(m_deadline - now).count();
+        if (remaining > m_sleepOvershoot) {
+            const double requested = remaining - m_sleepOvershoot;
+            sleepFor(requested);
+
+            const auto woke = Clock::now();
+            const double slept = std::chrono::duration<double>(woke - now).count();
+            m_sleepOvershoot = std::clamp(std::max(slept - requested, m_sleepOvershoot * 0.95), 0.0002, 0.004);
+            m_stats.sleepMs += slept * 1000.0;
+            now = woke;
+        }
+
+        const auto spinStart = now;
+        while (now < m_deadline) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+        m_stats.spinMs += std::chrono::duration<double, std::milli>(now - spinStart).count();
+
+        const double lateMs = std::chrono::duration<double, std::milli>(now - m_deadline).count();
+        m_stats.maxLateMs = std::max(m_stats.maxLateMs, lateMs);
+        if (now - m_deadline > period) {
+            m_stats.missed++;
+            m_deadline = now + period; //      ,   
+        }
+        else {
+            m_deadline += period;
+        }
+    }
+
+    /*
+    *     :     oldSwapchain    ,  
+    */
+    bool Core::setPresentMode(VkPresentModeKHR mode) {
+        ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+        if (mode == window->PresentMode) {
+            return true;
+        }
+        if (std::find(supportedPresentModes.begin(), supportedPresentModes.end(), mode) == supportedPresentModes.end()) {
+            LOG_WARNING(Swapchain, "Present mode {} is not supported by the surface", presentModeName(mode));
+            return false;
+        }
+
+        window->PresentMode = mode;
+        minImageCount = std::max(2, ImGui_ImplVulkanH_GetMinImageCountFromPresentMode(mode)); // MAILBOX   
+        swapChainRebuild = true;
+        LOG_INFO(Swapchain, "Present mode: {}", presentModeName(mode));
+        return true;
+    }
+
+    /*
+    *     :   ,   present wait,   .
+    *      ,   
+    */
+    void Core::paceFrame() {
+        PROFILE_FUNCTION();
+        pacer.wait();
+
+        if (!presentWait || maxQueuedPresents == 0 || presentId < maxQueuedPresents) {
+            return;
+        }
+
+        //       maxQueuedPresents - 1 
+        const uint64_t waitId = presentId - maxQueuedPresents + 1;
+        if (waitId <= presentIdBase) {
+            return; //        
+        }
+
+        const auto start = FrameStats::Clock::now();
+        VkResult result = waitForPresent(logicalDevice, imguiWindowData.Swapchain, waitId, 100ull * 1000 * 1000);
+        if (result != VK_SUCCESS && result != VK_TIMEOUT) {
+            swapChainRebuild = result == VK_ERROR_OUT_OF_DATE_KHR || swapChainRebuild;
+            return;
+        }
+        presentWaitMs += std::chrono::duration<double, std::milli>(FrameStats::Clock::now() - start).count();
+        collectPresentLatency();
+    }
+
+    /*
+    *      .  present wait     (    ),
+    *      GPU  ,   
+    */
+    void Core::collectPresentLatency() {
+        const auto now = FrameStats::Clock::now();
+
+        while (!presentSamples.empty()) {
+            const PresentSample& sample = presentSamples.front();
+            if (sample.presentId != 0) {
+                VkResult result = waitForPresent(logicalDevice, imguiWindowData.Swapchain, sample.presentId, 0);
+                if (result == VK_TIMEOUT) {
+                    break;
+                }
+                if (result != VK_SUCCESS) {
+                    presentSamples.clear();
+                    break;
+                }
+            }
+            else if (sample.frameValue > graphicsCompleted) {
+                break;
+            }
+
+            const double ms = std::chrono::duration<double, std::milli>(now - sample.input).count();
+            latencyStats.samples++;
+            latencyStats.sumMs += ms;
+            latencyStats.maxMs = std::max(latencyStats.maxMs, ms);
+            presentSamples.pop_front();
+        }
+    }
+
+    /*
+    *     :       ,    glfwWaitEventsTimeout
+    *     idleKeepAliveMs.     
+    */
+    void Core::pollEvents() {
+        PROFILE_FUNCTION();
+        if (idleSkipping && idleActiveFrames == 0 && !idleForceRender) {
+            const auto start = FrameStats::Clock::now();
+            glfwWaitEventsTimeout(idleKeepAliveMs / 1000.0);
+            idleStats.waits++;
+            idleStats.waitMs += std::chrono::duration<double, std::milli>(FrameStats::Clock::now() - start).count();
+            pacer.resync();
+        }
+        else {
+            //     :          
+            paceFrame();
+            glfwPollEvents();
+        }
+
+        //  GLFW     ImGui, NewFrame    
+        if (!GImGui->InputEventsQueue.empty()) {
+            idleActiveFrames = idleSettleFrames;
+        }
+        else if (idleActiveFrames > 0) {
+            idleActiveFrames--;
+        }
+    }
+
+    /*
+    *   8      :   ImGui -  ,   
+    */
+    static uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for (; size >= 8; size -= 8, bytes += 8) {
+            uint64_t word;
+            memcpy(&word, bytes, 8);
+            hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+            hash ^= hash >> 29;
+        }
+        if (size > 0) {
+            uint64_t word = 0;
+            memcpy(&word, bytes, size);
+            hash = (hash ^ word ^ ((uint64_t)size << 56)) * 0x9E3779B97F4A7C15ull;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    static uint64_t hashDrawData(const ImDrawData* drawData) {
+        uint64_t hash = hashBytes(0xCBF29CE484222325ull, &drawData->DisplayPos, sizeof(ImVec2));
+        hash = hashBytes(hash, &drawData->DisplaySize, sizeof(ImVec2));
+        hash = hashBytes(hash, &drawData->FramebufferScale, sizeof(ImVec2));
+        for (int i = 0; i < drawData->CmdListsCount; i++) {
+            const ImDrawList* list = drawData->CmdLists[i];
+            hash = hashBytes(hash, list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes());
+            hash = hashBytes(hash, list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes());
+            for (const ImDrawCmd& command : list->CmdBuffer) {
+                //   :      
+                hash = hashBytes(hash, &command.ClipRect, sizeof(command.ClipRect));
+                hash = hashBytes(hash, &command.TextureId, sizeof(command.TextureId));
+                hash = hashBytes(hash, &command.VtxOffset, sizeof(command.VtxOffset));
+                hash = hashBytes(hash, &command.IdxOffset, sizeof(command.IdxOffset));
+                hash = hashBytes(hash, &command.ElemCount, sizeof(command.ElemCount));
+                hash = hashBytes(hash, &command.UserCallback, sizeof(command.UserCallback));
+                hash = hashBytes(hash, &command.UserCallbackData, sizeof(command.UserCallbackData));
+            }
+        }
+        return hash;
+    }
+
+    /*
+    *       ImDrawData, ,     .
+    *    -  ,      
+    */
+    bool Core::frameChanged(ImGui_ImplVulkanH_Window* window, ImDrawData* drawData) {
+        idleStats.frames++;
+        if (!idleSkipping) {
+            return true;
+        }
+
+        PROFILE_FUNCTION();
+        uint64_t hash = hashDrawData(drawData);
+        hash = hashBytes(hash, &window->ClearValue, sizeof(window->ClearValue));
+        hash = hashBytes(hash, &window->Swapchain, sizeof(window->Swapchain));
+        hash = hashBytes(hash, &window->Width, sizeof(window->Width));
+        hash = hashBytes(hash, &window->Height, sizeof(window->Height));
+
+        const bool changed = idleForceRender || hash != idleHash;
+        idleForceRender = false;
+        idleHash = hash;
+        idleStats.skipped += changed ? 0 : 1;
+        return changed;
+    }
+
+    void Core::reportPacingStats() {
+        const FramePacer::Stats stats = pacer.stats();
+        if (pacer.targetFps() > 0.0 && stats.frames > 0) {
+            LOG_INFO(Frames, "Frame pacing ({} fps): sleep {:.3f} ms, spin {:.3f} ms, max late {:.3f} ms, {} missed", pacer.targetFps(), stats.sleepMs / stats.frames,
+                stats.spinMs / stats.frames, stats.maxLateMs, stats.missed);
+        }
+        pacer.resetStats();
+
+        if (idleSkipping && idleStats.frames > 0) {
+            LOG_INFO(Frames, "Idle: {} of {} frames skipped, {} waits for events, {:.1f} ms waiting", idleStats.skipped, idleStats.frames, idleStats.waits, idleStats.waitMs);
+        }
+        idleStats = IdleStats{};
+
+        if (latencyStats.samples > 0) {
+            LOG_INFO(Frames, "Input to {} latency: avg {:.2f} ms, max {:.2f} ms ({}, present wait {:.2f} ms)", presentWait ? "present" : "GPU done", latencyStats.average(),
+                latencyStats.maxMs, presentModeName(imguiWindowData.PresentMode), presentWaitMs);
+        }
+        lastLatency = latencyStats;
+        latencyStats = LatencyStats{};
+        presentWaitMs = 0.0;
+    }
+}
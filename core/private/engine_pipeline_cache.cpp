@@ -0,0 +1,197 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <cstdio>
+
+namespace Engine {
+    static uint64_t hashBytes(const uint8_t* data, size_t size) {
+        uint64_t hash = 14695981039346656037ull; // FNV-1a,  
+        for (size_t i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    static PipelineCacheFileHeader makeCacheHeader(VkPhysicalDevice physicalDevice) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        PipelineCacheFileHeader header{};
+        header.vendorID = properties.vendorID;
+        header.deviceID = properties.deviceID;
+        header.driverVersion = properties.driverVersion;
+        memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        return header;
+    }
+
+    /*
+    *     .   ,        /
+    */
+    static std::vector<uint8_t> loadCacheFile(const std::string& path, const PipelineCacheFileHeader& expected) {
+        std::vector<uint8_t> data;
+
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return data; //  ,   
+        }
+
+        PipelineCacheFileHeader header{};
+        if (fread(&header, sizeof(header), 1, file) == 1
+            && header.magic == expected.magic
+            && header.headerSize == expected.headerSize
+            && header.vendorID == expected.vendorID
+            && header.deviceID == expected.deviceID
+            && header.driverVersion == expected.driverVersion
+            && memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) == 0
+            && header.dataSize > 0) {
+            //     :     ,       
+            long fileSize = -1;
+            if (fseek(file, 0, SEEK_END) == 0) {
+                fileSize = ftell(file);
+            }
+            if (fileSize < (long)sizeof(header) || header.dataSize != (uint64_t)fileSize - sizeof(header) || fseek(file, sizeof(header), SEEK_SET) != 0) {
+                LOG_WARNING(Vulkan, "Pipeline cache '{}' is corrupted, ignoring it", path);
+            }
+            else {
+                data.resize((size_t)header.dataSize);
+                if (fread(data.data(), 1, data.size(), file) != data.size() || hashBytes(data.data(), data.size()) != header.dataHash) {
+                    LOG_WARNING(Vulkan, "Pipeline cache '{}' is corrupted, ignoring it", path);
+                    data.clear();
+                }
+            }
+        }
+        else {
+            LOG_INFO(Vulkan, "Pipeline cache '{}' belongs to another device or driver, ignoring it", path);
+        }
+
+        fclose(file);
+        return data;
+    }
+
+    void Core::createPipelineCache() {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<uint8_t> data = loadCacheFile(pipelineCachePath, makeCacheHeader(physicalDevice));
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+        VkResult result = vkCreatePipelineCache(logicalDevice, &createInfo, allocator, &pipelineCache);
+        if (result != VK_SUCCESS && !data.empty()) {
+            //     ,     
+            LOG_WARNING(Vulkan, "Driver rejected pipeline cache data ({}), starting cold", (int)result);
+            data.clear();
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            result = vkCreatePipelineCache(logicalDevice, &createInfo, allocator, &pipelineCache);
+        }
+        checkVkResult(result);
+
+        startupTimings.warmPipelineCache = !data.empty();
+        startupTimings.pipelineCacheBytes = data.size();
+        startupTimings.pipelineCacheLoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    VkPipelineCache Core::createWorkerPipelineCache() {
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        VkResult result = vkCreatePipelineCache(logicalDevice, &createInfo, allocator, &cache);
+        checkVkResult(result);
+
+        std::lock_guard<std::mutex> guard(workerPipelineCaches.lock);
+        workerPipelineCaches.caches.push_back(cache);
+        return cache;
+    }
+
+    /*
+    *      .        
+    */
+    void Core::mergeWorkerPipelineCaches() {
+        std::lock_guard<std::mutex> guard(workerPipelineCaches.lock);
+        if (workerPipelineCaches.caches.empty()) {
+            return;
+        }
+
+        VkResult result = vkMergePipelineCaches(logicalDevice, pipelineCache, (uint32_t)workerPipelineCaches.caches.size(), workerPipelineCaches.caches.data());
+        checkVkResult(result);
+
+        for (VkPipelineCache cache : workerPipelineCaches.caches) {
+            vkDestroyPipelineCache(logicalDevice, cache, allocator);
+        }
+        workerPipelineCaches.caches.clear();
+    }
+
+    /*
+    *    :        ,
+    *        
+    */
+    void Core::savePipelineCache() {
+        if (pipelineCache == VK_NULL_HANDLE) {
+            return;
+        }
+
+        mergeWorkerPipelineCaches();
+
+        size_t size = 0;
+        VkResult result = vkGetPipelineCacheData(logicalDevice, pipelineCache, &size, nullptr);
+        checkVkResult(result);
+        if (size == 0) {
+            return;
+        }
+
+        std::vector<uint8_t> data(size);
+        result = vkGetPipelineCacheData(logicalDevice, pipelineCache, &size, data.data());
+        checkVkResult(result);
+        data.resize(size);
+
+        PipelineCacheFileHeader header = makeCacheHeader(physicalDevice);
+        header.dataSize = data.size();
+        header.dataHash = hashBytes(data.data(), data.size());
+
+        const std::string temporaryPath = pipelineCachePath + ".tmp";
+        FILE* file = fopen(temporaryPath.c_str(), "wb");
+        if (file == nullptr) {
+            LOG_WARNING(Vulkan, "Can't write pipeline cache '{}'", temporaryPath);
+            return;
+        }
+
+        const bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data.data(), 1, data.size(), file) == data.size();
+        const bool closed = fclose(file) == 0;
+        if (!written || !closed) {
+            LOG_WARNING(Vulkan, "Failed to write pipeline cache '{}'", temporaryPath);
+            remove(temporaryPath.c_str());
+            return;
+        }
+
+#ifdef _WIN32
+        const bool replaced = MoveFileExA(temporaryPath.c_str(), pipelineCachePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        const bool replaced = rename(temporaryPath.c_str(), pipelineCachePath.c_str()) == 0;
+#endif
+        if (!replaced) {
+            LOG_WARNING(Vulkan, "Failed to replace pipeline cache '{}'", pipelineCachePath);
+            remove(temporaryPath.c_str());
+            return;
+        }
+
+        LOG_INFO(Vulkan, "Pipeline cache saved: {} bytes", data.size());
+    }
+
+    void Core::destroyPipelineCache() {
+        savePipelineCache();
+        vkDestroyPipelineCache(logicalDevice, pipelineCache, allocator);
+        pipelineCache = VK_NULL_HANDLE;
+    }
+
+    void Core::reportStartupTimings() {
+        LOG_INFO(Core, "Startup timings ({} pipeline cache, {} bytes): vulkan {:.2f} ms, cache load {:.2f} ms, pipeline creation {:.2f} ms",
+            startupTimings.warmPipelineCache ? "warm" : "cold", startupTimings.pipelineCacheBytes, startupTimings.vulkanInitializeMs,
+            startupTimings.pipelineCacheLoadMs, startupTimings.pipelineCreateMs);
+    }
+}
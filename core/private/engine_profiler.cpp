@@ -0,0 +1,417 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    static thread_local void* t_profilerBuffer = nullptr; // ThreadBuffer  
+
+    Profiler& profiler() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::Profiler() {
+        m_history.resize(HistorySize);
+        m_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        m_frameStart = 0;
+    }
+
+    int64_t Profiler::now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() - m_epoch;
+    }
+
+    Profiler::ThreadBuffer* Profiler::threadBuffer() {
+        if (t_profilerBuffer != nullptr) {
+            return (ThreadBuffer*)t_profilerBuffer;
+        }
+
+        //     :    ,     
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        m_threads.emplace_back(new ThreadBuffer());
+        ThreadBuffer* buffer = m_threads.back().get();
+        buffer->index = (uint16_t)(m_threads.size() - 1);
+        buffer->name = fmt::format("Thread {}", buffer->index); //        PROFILE_THREAD
+        t_profilerBuffer = buffer;
+        return buffer;
+    }
+
+    void Profiler::setThreadName(const char* name) {
+        ThreadBuffer* buffer = threadBuffer();
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        buffer->name = name;
+    }
+
+    std::string Profiler::threadName(uint16_t thread) {
+        if (thread == GpuThread) {
+            return "GPU";
+        }
+
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        return thread < m_threads.size() ? m_threads[thread]->name : "?";
+    }
+
+    int64_t Profiler::beginZone() {
+        if (!isEnabled()) {
+            return -1;
+        }
+
+        threadBuffer()->depth++;
+        return now();
+    }
+
+    void Profiler::endZone(const char* name, int64_t start) {
+        if (start < 0) {
+            return; //  ,    
+        }
+
+        ProfileZone zone;
+        zone.name = name;
+        zone.start = start;
+        zone.end = now();
+
+        ThreadBuffer* buffer = (ThreadBuffer*)t_profilerBuffer; // beginZone   
+        zone.depth = --buffer->depth;
+        zone.thread = buffer->index;
+
+        const uint64_t write = buffer->write.load(std::memory_order_relaxed);
+        if (write - buffer->read.load(std::memory_order_acquire) >= ThreadBufferSize) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer->zones[write % ThreadBufferSize] = zone;
+        buffer->write.store(write + 1, std::memory_order_release);
+    }
+
+    /*
+    *      ,   :          
+    */
+    void Profiler::newFrame() {
+        const int64_t end = now();
+
+        ProfileFrame* frame = nullptr;
+        if (!m_paused) {
+            frame = &m_history[m_frameNumber % HistorySize];
+            frame->number = m_frameNumber;
+            frame->start = m_frameStart;
+            frame->end = end;
+            frame->zones.clear();
+            frame->gpuZones.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_threadsLock);
+            for (auto& buffer : m_threads) {
+                const uint64_t read = buffer->read.load(std::memory_order_relaxed);
+                const uint64_t write = buffer->write.load(std::memory_order_acquire);
+                if (frame != nullptr) {
+                    for (uint64_t i = read; i < write; i++) {
+                        frame->zones.push_back(buffer->zones[i % ThreadBufferSize]);
+                    }
+                }
+                buffer->read.store(write, std::memory_order_release);
+            }
+        }
+
+        m_frameNumber++;
+        m_frameStart = end;
+    }
+
+    void Profiler::addGpuZones(uint64_t number, const std::vector<ProfileZone>& zones) {
+        ProfileFrame& frame = m_history[number % HistorySize];
+        if (m_paused || frame.number != number) {
+            return;
+        }
+
+        frame.gpuZones.insert(frame.gpuZones.end(), zones.begin(), zones.end());
+    }
+
+    const ProfileFrame* Profiler::frame(uint64_t number) const {
+        const ProfileFrame& frame = m_history[number % HistorySize];
+        return frame.number == number ? &frame : nullptr;
+    }
+
+    uint64_t Profiler::droppedZones() {
+        std::lock_guard<std::mutex> guard(m_threadsLock);
+        uint64_t dropped = 0;
+        for (const auto& buffer : m_threads) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
+    static void writeJsonString(FILE* file, const char* text) {
+        fputc('"', file);
+        for (const char* c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                fputc('\\', file);
+            }
+            fputc((unsigned char)*c < 0x20 ? ' ' : *c, file);
+        }
+        fputc('"', file);
+    }
+
+    /*
+    *     Chrome trace (chrome://tracing, Perfetto):  "X"      
+    */
+    bool Profiler::writeChromeTrace(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            LOG_ERROR(Profiler, "Can't write profiler trace {}", path);
+            return false;
+        }
+
+        fprintf(file, "{\"traceEvents\":[\n");
+        bool first = true;
+
+        std::vector<uint16_t> threads;
+        const uint64_t oldest = m_frameNumber > HistorySize ? m_frameNumber - HistorySize : 0;
+        for (uint64_t number = oldest; number < m_frameNumber; number++) {
+            const ProfileFrame* frame = this->frame(number);
+            if (frame == nullptr) {
+                continue;
+            }
+
+            for (const std::vector<ProfileZone>* zones : { &frame->zones, &frame->gpuZones }) {
+                for (const ProfileZone& zone : *zones) {
+                    fprintf(file, "%s{\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", first ? "" : ",\n", (unsigned)zone.thread, zone.start / 1e3, (zone.end - zone.start) / 1e3);
+                    writeJsonString(file, zone.name);
+                    fprintf(file, "}");
+                    first = false;
+
+                    if (std::find(threads.begin(), threads.end(), zone.thread) == threads.end()) {
+                        threads.push_back(zone.thread);
+                    }
+                }
+            }
+
+            //    
+            fprintf(file, "%s{\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"name\":\"Frame %llu\"}", first ? "" : ",\n", frame->start / 1e3, (unsigned long long)frame->number);
+            first = false;
+        }
+
+        for (uint16_t thread : threads) {
+            fprintf(file, ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", (unsigned)thread);
+            writeJsonString(file, threadName(thread).c_str());
+            fprintf(file, "}}");
+        }
+
+        fprintf(file, "\n]}\n");
+        const bool written = ferror(file) == 0;
+        fclose(file);
+
+        if (written) {
+            LOG_INFO(Profiler, "Profiler trace written to {}", path);
+        }
+        return written;
+    }
+
+    /*
+    *  :    (  )       .
+    *    ,    
+    */
+    void Profiler::drawWindow(bool* open) {
+        if (!ImGui::Begin(u8"", open)) {
+            ImGui::End();
+            return;
+        }
+
+        ImGui::Checkbox(u8"", &m_paused);
+        ImGui::SameLine();
+        if (ImGui::Button("Chrome trace")) {
+            writeChromeTrace("profile_trace.json");
+        }
+        ImGui::SameLine();
+        ImGui::Text(u8" : %llu", (unsigned long long)droppedZones());
+
+        //   ,    
+        float times[HistorySize] = {};
+        const uint64_t oldest = m_frameNumber > HistorySize ? m_frameNumber - HistorySize : 0;
+        for (uint64_t number = oldest; number < m_frameNumber; number++) {
+            const ProfileFrame* frame = this->frame(number);
+            times[number - oldest] = frame != nullptr ? (float)frame->milliseconds() : 0.0f;
+        }
+        ImGui::PlotHistogram("##frames", times, (int)std::min<uint64_t>(m_frameNumber, HistorySize), 0, u8"  ", 0.0f, 33.3f, ImVec2(-1.0f, 60.0f));
+        if (ImGui::IsItemClicked()) {
+            const float x = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+            const uint64_t count = std::min<uint64_t>(m_frameNumber, HistorySize);
+            m_selectedFrame = oldest + std::min<uint64_t>((uint64_t)(std::max(0.0f, x) * count), count - 1);
+            m_paused = true; //     
+        }
+        if (m_selectedFrame != UINT64_MAX && ImGui::SmallButton(u8"  ")) {
+            m_selectedFrame = UINT64_MAX;
+        }
+
+        const ProfileFrame* frame = m_selectedFrame == UINT64_MAX ? lastFrame() : this->frame(m_selectedFrame);
+        if (frame == nullptr || frame->end <= frame->start) {
+            ImGui::End();
+            return;
+        }
+
+        // GPU      ,       CPU
+        int64_t start = frame->start, end = frame->end;
+        double gpuMs = 0.0;
+        for (const ProfileZone& zone : frame->gpuZones) {
+            end = std::max(end, zone.end);
+            gpuMs += zone.depth == 0 ? (zone.end - zone.start) / 1e6 : 0.0;
+        }
+        ImGui::Text(u8" %llu: CPU %.2f , GPU %.2f ", (unsigned long long)frame->number, frame->milliseconds(), gpuMs);
+
+        std::vector<uint16_t> threads;
+        for (const ProfileZone& zone : frame->zones) {
+            if (std::find(threads.begin(), threads.end(), zone.thread) == threads.end()) {
+                threads.push_back(zone.thread);
+            }
+        }
+        std::sort(threads.begin(), threads.end());
+        if (!frame->gpuZones.empty()) {
+            threads.push_back(GpuThread);
+        }
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+        const float labelWidth = 90.0f;
+        const float width = std::max(50.0f, ImGui::GetContentRegionAvail().x - labelWidth);
+        const double scale = width / (double)(end - start);
+        const ImU32 colors[] = { IM_COL32(70, 130, 180, 255), IM_COL32(60, 160, 110, 255), IM_COL32(190, 120, 50, 255), IM_COL32(150, 90, 170, 255), IM_COL32(170, 70, 70, 255) };
+
+        for (uint16_t thread : threads) {
+            const std::vector<ProfileZone>& zones = thread == GpuThread ? frame->gpuZones : frame->zones;
+            uint16_t maxDepth = 0;
+            for (const ProfileZone& zone : zones) {
+                maxDepth = zone.thread == thread ? std::max(maxDepth, zone.depth) : maxDepth;
+            }
+
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImGui::TextUnformatted(threadName(thread).c_str());
+            ImGui::SetCursorScreenPos(origin);
+            ImGui::Dummy(ImVec2(labelWidth + width, rowHeight * (maxDepth + 1)));
+
+            for (const ProfileZone& zone : zones) {
+                if (zone.thread != thread) {
+                    continue;
+                }
+
+                const float x0 = origin.x + labelWidth + (float)((std::max(zone.start, start) - start) * scale);
+                const float x1 = std::max(x0 + 1.0f, origin.x + labelWidth + (float)((std::min(zone.end, end) - start) * scale));
+                const float y0 = origin.y + zone.depth * rowHeight;
+                const ImVec2 min(x0, y0), max(x1, y0 + rowHeight - 1.0f);
+                const ImU32 color = colors[((uintptr_t)zone.name >> 3) % IM_ARRAYSIZE(colors)]; //      -  
+
+                drawList->AddRectFilled(min, max, color);
+                if (x1 - x0 > ImGui::CalcTextSize(zone.name).x + 4.0f) {
+                    drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32_WHITE, zone.name);
+                }
+                if (ImGui::IsMouseHoveringRect(min, max)) {
+                    ImGui::SetTooltip(u8"%s\n%.3f ", zone.name, (zone.end - zone.start) / 1e6);
+                }
+            }
+        }
+
+        ImGui::End();
+    }
+
+    bool GpuProfiler::initialize(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamily, uint32_t slots, const VkAllocationCallbacks* allocator) {
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        const uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+        if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+            LOG_WARNING(Profiler, "GPU timestamps are not supported on the graphics queue, GPU profiling is off");
+            return false;
+        }
+
+        m_device = device;
+        m_allocator = allocator;
+        m_period = properties.limits.timestampPeriod;
+        m_mask = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+        m_results.resize(MaxZones * 2);
+        m_slots.resize(slots);
+
+        for (Slot& slot : m_slots) {
+            VkQueryPoolCreateInfo info{};
+            info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            info.queryCount = MaxZones * 2;
+            VkResult result = vkCreateQueryPool(device, &info, allocator, &slot.pool);
+            Core::checkVkResult(result);
+            slot.zones.reserve(MaxZones);
+        }
+
+        return true;
+    }
+
+    void GpuProfiler::destroy() {
+        for (Slot& slot : m_slots) {
+            vkDestroyQueryPool(m_device, slot.pool, m_allocator);
+        }
+        m_slots.clear();
+        m_current = nullptr;
+    }
+
+    void GpuProfiler::collect(Slot& slot) {
+        if (slot.frameNumber == UINT64_MAX || slot.zones.empty()) {
+            return;
+        }
+
+        const uint32_t queryCount = (uint32_t)slot.zones.size() * 2;
+        VkResult result = vkGetQueryPoolResults(m_device, slot.pool, 0, queryCount, queryCount * sizeof(uint64_t), m_results.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS) {
+            return; // VK_NOT_READY:    ,   
+        }
+
+        //    CPU  (   VK_EXT_calibrated_timestamps),    GPU     
+        const uint64_t base = m_results[0] & m_mask;
+        m_zones.clear();
+        for (const Zone& zone : slot.zones) {
+            ProfileZone profileZone;
+            profileZone.name = zone.name;
+            profileZone.start = slot.cpuStart + (int64_t)(((m_results[zone.query] & m_mask) - base) * m_period);
+            profileZone.end = slot.cpuStart + (int64_t)(((m_results[zone.query + 1] & m_mask) - base) * m_period);
+            profileZone.depth = zone.depth;
+            profileZone.thread = Profiler::GpuThread;
+            m_zones.push_back(profileZone);
+        }
+        profiler().addGpuZones(slot.frameNumber, m_zones);
+    }
+
+    void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t slot, uint64_t frameNumber) {
+        if (slot >= m_slots.size()) {
+            m_current = nullptr;
+            return;
+        }
+
+        Slot& current = m_slots[slot];
+        collect(current);
+
+        vkCmdResetQueryPool(commandBuffer, current.pool, 0, MaxZones * 2);
+        current.zones.clear();
+        current.frameNumber = frameNumber;
+        current.cpuStart = profiler().now();
+        m_current = &current;
+        m_depth = 0;
+    }
+
+    uint32_t GpuProfiler::beginZone(VkCommandBuffer commandBuffer, const char* name) {
+        if (m_current == nullptr || m_current->zones.size() >= MaxZones || !profiler().isEnabled()) {
+            return UINT32_MAX;
+        }
+
+        const uint32_t query = (uint32_t)m_current->zones.size() * 2;
+        m_current->zones.push_back(Zone{ name, query, m_depth++ });
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_current->pool, query);
+        return (uint32_t)m_current->zones.size() - 1;
+    }
+
+    void GpuProfiler::endZone(VkCommandBuffer commandBuffer, uint32_t zone) {
+        if (m_current == nullptr || zone == UINT32_MAX) {
+            return;
+        }
+
+        m_depth--;
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_current->pool, m_current->zones[zone].query + 1);
+    }
+}
@@ -0,0 +1,321 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    const char* queueTypeName(QueueType type) {
+        switch (type) {
+        case QueueType::Graphics: return "graphics";
+        case QueueType::Compute: return "compute";
+        case QueueType::Transfer: return "transfer";
+        case QueueType::Present: return "present";
+        default: return "unknown";
+        }
+    }
+
+    /*
+    *    :
+    *  -   ,  -    (      ),
+    *  -   ,     ,
+    *  -    transfer,      .
+    *      ,    0  
+    */
+    bool QueueTopology::discover(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
+        uint32_t familiesCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, nullptr);
+        std::vector<VkQueueFamilyProperties> properties(familiesCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, properties.data());
+
+        m_families.assign(familiesCount, Family{});
+        for (auto& queue : m_queues) {
+            queue = DeviceQueue{};
+        }
+
+        uint32_t graphics = UINT32_MAX, compute = UINT32_MAX, transfer = UINT32_MAX;
+        for (uint32_t i = 0; i < familiesCount; i++) {
+            Family& family = m_families[i];
+            family.properties = properties[i];
+            if (surface != VK_NULL_HANDLE) {
+                vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &family.present);
+            }
+
+            const VkQueueFlags flags = family.properties.queueFlags;
+            if ((flags & VK_QUEUE_GRAPHICS_BIT) && (graphics == UINT32_MAX || (family.present && !m_families[graphics].present))) {
+                graphics = i; //   ,   
+            }
+            if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) && compute == UINT32_MAX) {
+                compute = i;
+            }
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) && transfer == UINT32_MAX) {
+                transfer = i;
+            }
+        }
+
+        if (graphics == UINT32_MAX) {
+            LOG_ERROR(Device, "Queues: device has no graphics queue family");
+            return false;
+        }
+        if (surface != VK_NULL_HANDLE && !m_families[graphics].present) {
+            LOG_ERROR(Device, "Queues: no graphics queue family can present to the surface");
+            return false;
+        }
+
+        assign(QueueType::Graphics, graphics);
+        assign(QueueType::Compute, compute != UINT32_MAX ? compute : graphics);
+        assign(QueueType::Transfer, transfer != UINT32_MAX ? transfer : (compute != UINT32_MAX ? compute : graphics));
+        if (surface != VK_NULL_HANDLE) {
+            m_queues[(uint32_t)QueueType::Present].family = graphics;
+            m_queues[(uint32_t)QueueType::Present].index = m_queues[(uint32_t)QueueType::Graphics].index;
+        }
+
+        return true;
+    }
+
+    void QueueTopology::assign(QueueType type, uint32_t family) {
+        Family& properties = m_families[family];
+        DeviceQueue& queue = m_queues[(uint32_t)type];
+        queue.family = family;
+        if (properties.used < properties.properties.queueCount) {
+            queue.index = properties.used++;
+        }
+        else {
+            queue.index = 0; //   ,  
+        }
+    }
+
+    void QueueTopology::fillCreateInfos(std::vector<VkDeviceQueueCreateInfo>& createInfos, std::vector<float>& priorities) const {
+        const uint32_t graphics = m_queues[(uint32_t)QueueType::Graphics].family;
+
+        size_t total = 0;
+        for (const auto& family : m_families) {
+            total += family.used;
+        }
+        priorities.clear();
+        priorities.reserve(total); //      
+
+        createInfos.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_families.size(); i++) {
+            if (m_families[i].used == 0) {
+                continue;
+            }
+
+            const size_t first = priorities.size();
+            for (uint32_t j = 0; j < m_families[i].used; j++) {
+                priorities.push_back(i == graphics && j == 0 ? 1.0f : 0.5f); //    
+            }
+
+            VkDeviceQueueCreateInfo info{};
+            info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            info.queueFamilyIndex = i;
+            info.queueCount = m_families[i].used;
+            info.pQueuePriorities = &priorities[first];
+            createInfos.push_back(info);
+        }
+    }
+
+    void QueueTopology::resolve(VkDevice device, const VkAllocationCallbacks* allocator, bool timelines) {
+        m_locks.clear();
+        m_device = device;
+        m_allocator = allocator;
+
+        for (uint32_t i = 0; i < (uint32_t)QueueType::Count; i++) {
+            DeviceQueue& queue = m_queues[i];
+            if (queue.family == UINT32_MAX) {
+                continue;
+            }
+
+            vkGetDeviceQueue(device, queue.family, queue.index, &queue.queue);
+            queue.dedicated = true;
+
+            //    VkQueue   
+            for (uint32_t j = 0; j < i; j++) {
+                if (m_queues[j].queue == queue.queue) {
+                    queue.lock = m_queues[j].lock;
+                    queue.dedicated = m_queues[j].dedicated = false;
+                    break;
+                }
+            }
+            if (queue.lock == nullptr) {
+                m_locks.push_back(std::make_unique<std::mutex>());
+                queue.lock = m_locks.back().get();
+            }
+
+            if (timelines) {
+                VkSemaphoreTypeCreateInfo typeInfo{};
+                typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+                typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+                typeInfo.initialValue = 0;
+
+                VkSemaphoreCreateInfo semaphoreInfo{};
+                semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                semaphoreInfo.pNext = &typeInfo;
+                VkResult result = vkCreateSemaphore(device, &semaphoreInfo, allocator, &queue.timeline);
+                Core::checkVkResult(result);
+                queue.timelineValue = 0;
+            }
+        }
+
+        m_lastReport = std::chrono::steady_clock::now();
+    }
+
+    void QueueTopology::destroy() {
+        for (auto& queue : m_queues) {
+            if (queue.timeline != VK_NULL_HANDLE) {
+                vkDestroySemaphore(m_device, queue.timeline, m_allocator);
+                queue.timeline = VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    VkResult QueueTopology::submit(QueueType type, uint32_t submitCount, const VkSubmitInfo* submits, VkFence fence) {
+        DeviceQueue& queue = m_queues[(uint32_t)type];
+
+        const auto start = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> guard(*queue.lock);
+        const auto locked = std::chrono::steady_clock::now();
+
+        VkResult result = vkQueueSubmit(queue.queue, submitCount, submits, fence);
+
+        queue.stats.submits++;
+        for (uint32_t i = 0; i < submitCount; i++) {
+            queue.stats.commandBuffers += submits[i].commandBufferCount;
+        }
+        queue.stats.waitMs += std::chrono::duration<double, std::milli>(locked - start).count();
+        queue.stats.busyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - locked).count();
+        return result;
+    }
+
+    uint64_t QueueTopology::submitTimeline(QueueType type, uint32_t waitCount, const VkSemaphore* waits, const uint64_t* waitValues, const VkPipelineStageFlags* waitStages,
+        uint32_t commandBufferCount, const VkCommandBuffer* commandBuffers, uint32_t signalCount, const VkSemaphore* signals) {
+        DeviceQueue& queue = m_queues[(uint32_t)type];
+        assert(queue.timeline != VK_NULL_HANDLE);
+
+        const uint32_t maxSignals = 8;
+        assert(signalCount < maxSignals);
+        VkSemaphore signalSemaphores[maxSignals];
+        uint64_t signalValues[maxSignals] = {}; //    
+        for (uint32_t i = 0; i < signalCount; i++) {
+            signalSemaphores[i] = signals[i];
+        }
+        signalSemaphores[signalCount] = queue.timeline;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> guard(*queue.lock);
+        const auto locked = std::chrono::steady_clock::now();
+
+        //    ,        
+        const uint64_t value = queue.timelineValue + 1;
+        signalValues[signalCount] = value;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = waitValues != nullptr ? waitCount : 0;
+        timelineInfo.pWaitSemaphoreValues = waitValues;
+        timelineInfo.signalSemaphoreValueCount = signalCount + 1;
+        timelineInfo.pSignalSemaphoreValues = signalValues;
+
+        VkSubmitInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        info.pNext = &timelineInfo;
+        info.waitSemaphoreCount = waitCount;
+        info.pWaitSemaphores = waits;
+        info.pWaitDstStageMask = waitStages;
+        info.commandBufferCount = commandBufferCount;
+        info.pCommandBuffers = commandBuffers;
+        info.signalSemaphoreCount = signalCount + 1;
+        info.pSignalSemaphores = signalSemaphores;
+
+        VkResult result = vkQueueSubmit(queue.queue, 1, &info, VK_NULL_HANDLE);
+        Core::checkVkResult(result);
+        queue.timelineValue = value;
+
+        queue.stats.submits++;
+        queue.stats.commandBuffers += commandBufferCount;
+        queue.stats.waitMs += std::chrono::duration<double, std::milli>(locked - start).count();
+        queue.stats.busyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - locked).count();
+        return value;
+    }
+
+    uint64_t QueueTopology::completedValue(QueueType type) {
+        uint64_t value = 0;
+        VkResult result = vkGetSemaphoreCounterValue(m_device, m_queues[(uint32_t)type].timeline, &value);
+        Core::checkVkResult(result);
+        return value;
+    }
+
+    void QueueTopology::waitValue(QueueType type, uint64_t value) {
+        if (value == 0) {
+            return; //   
+        }
+
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_queues[(uint32_t)type].timeline;
+        waitInfo.pValues = &value;
+        VkResult result = vkWaitSemaphores(m_device, &waitInfo, UINT64_MAX);
+        Core::checkVkResult(result);
+    }
+
+    VkResult QueueTopology::present(const VkPresentInfoKHR* presentInfo) {
+        DeviceQueue& queue = m_queues[(uint32_t)QueueType::Present];
+
+        const auto start = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> guard(*queue.lock);
+        const auto locked = std::chrono::steady_clock::now();
+
+        VkResult result = vkQueuePresentKHR(queue.queue, presentInfo);
+
+        queue.stats.submits++;
+        queue.stats.waitMs += std::chrono::duration<double, std::milli>(locked - start).count();
+        queue.stats.busyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - locked).count();
+        return result;
+    }
+
+    VkResult QueueTopology::waitIdle(QueueType type) {
+        DeviceQueue& queue = m_queues[(uint32_t)type];
+        std::lock_guard<std::mutex> guard(*queue.lock);
+        return vkQueueWaitIdle(queue.queue);
+    }
+
+    void QueueTopology::logTopology() const {
+        for (uint32_t i = 0; i < (uint32_t)QueueType::Count; i++) {
+            const DeviceQueue& queue = m_queues[i];
+            if (queue.family == UINT32_MAX) {
+                LOG_INFO(Device, "Queue {}: none", queueTypeName((QueueType)i));
+                continue;
+            }
+
+            LOG_INFO(Device, "Queue {}: family {} index {} (flags {:#x}, {})", queueTypeName((QueueType)i), queue.family, queue.index,
+                m_families[queue.family].properties.queueFlags, queue.dedicated ? "dedicated" : "shared");
+        }
+    }
+
+    void QueueTopology::reportStats() {
+        const auto now = std::chrono::steady_clock::now();
+        const double wallMs = std::chrono::duration<double, std::milli>(now - m_lastReport).count();
+        m_lastReport = now;
+        if (wallMs <= 0.0) {
+            return;
+        }
+
+        for (uint32_t i = 0; i < (uint32_t)QueueType::Count; i++) {
+            DeviceQueue& queue = m_queues[i];
+            if (queue.lock == nullptr) {
+                continue;
+            }
+
+            QueueStats stats;
+            {
+                std::lock_guard<std::mutex> guard(*queue.lock);
+                stats = queue.stats;
+                queue.stats = QueueStats{};
+            }
+            if (stats.submits == 0) {
+                continue;
+            }
+
+            LOG_INFO(Device, "Queue {}: {} submits, {} command buffers, busy {:.1f}%, lock wait {:.3f} ms", queueTypeName((QueueType)i), stats.submits, stats.commandBuffers,
+                stats.busyMs / wallMs * 100.0, stats.waitMs);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    void SimulationClock::configure(double tickRate, uint32_t maxTicksPerFrame, double maxFrameTime, uint32_t ticksPerFrame) {
+        m_tickSeconds = 1.0 / std::max(1.0, tickRate);
+        m_maxTicksPerFrame = std::max(1u, maxTicksPerFrame);
+        m_maxFrameTime = std::max(m_tickSeconds, maxFrameTime);
+        m_ticksPerFrame = ticksPerFrame;
+    }
+
+    void SimulationClock::reset(Clock::time_point now) {
+        m_last = now;
+        m_accumulator = 0.0;
+        m_alpha = 0.0;
+        m_pendingTicks = 0;
+    }
+
+    uint32_t SimulationClock::advance(Clock::time_point now) {
+        m_stats.frames++;
+
+        if (m_ticksPerFrame != 0) {
+            m_pendingTicks = m_ticksPerFrame; //  :   ,  
+            m_tick += m_pendingTicks;
+            m_stats.ticks += m_pendingTicks;
+            m_alpha = 0.0;
+            return m_pendingTicks;
+        }
+
+        double frameTime = std::chrono::duration<double>(now - m_last).count();
+        m_last = now;
+
+        //    :         
+        if (frameTime > m_maxFrameTime) {
+            m_stats.droppedSeconds += frameTime - m_maxFrameTime;
+            m_stats.clampedFrames++;
+            frameTime = m_maxFrameTime;
+        }
+        m_accumulator += frameTime;
+
+        uint32_t ticks = (uint32_t)(m_accumulator / m_tickSeconds);
+        if (ticks > m_maxTicksPerFrame) {
+            //  :    ,  ,    
+            const uint32_t skipped = ticks - m_maxTicksPerFrame;
+            m_accumulator -= skipped * m_tickSeconds;
+            m_stats.droppedSeconds += skipped * m_tickSeconds;
+            m_stats.budgetHits++;
+            ticks = m_maxTicksPerFrame;
+        }
+        m_accumulator -= ticks * m_tickSeconds;
+
+        m_pendingTicks = ticks;
+        m_tick += ticks;
+        m_stats.ticks += ticks;
+        m_alpha = std::clamp(m_accumulator / m_tickSeconds, 0.0, 1.0);
+        return ticks;
+    }
+
+    /*
+    *     .     ,      
+    */
+    uint32_t Core::runSimulation() {
+        PROFILE_FUNCTION();
+        const uint32_t ticks = simulation.advance(SimulationClock::Clock::now());
+        const uint64_t first = simulation.firstTick();
+
+        for (uint32_t i = 0; i < ticks; i++) {
+            PROFILE_SCOPE("tick");
+            update((uint32_t)(first + i));
+            jobs.wait(updateJobs);
+        }
+        jobs.runMainThreadJobs();
+
+        return ticks;
+    }
+
+    void Core::reportSimulationStats() {
+        const SimulationClock::Stats stats = simulation.stats();
+        if (stats.frames == 0) {
+            return;
+        }
+
+        LOG_INFO(Core, "Simulation ({} Hz{}): {} ticks in {} frames, {} clamped frames, {} over budget, {:.1f} ms dropped", simulation.tickRate(),
+            simulation.isVirtual() ? ", virtual time" : "", stats.ticks, stats.frames, stats.clampedFrames, stats.budgetHits, stats.droppedSeconds * 1000.0);
+        simulation.resetStats();
+    }
+}
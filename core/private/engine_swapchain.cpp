@@ -0,0 +1,256 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    /*
+    *       :       ,
+    *   ImGui    . finalLayout - PRESENT_SRC    TRANSFER_SRC     
+    */
+    void Core::createSwapchainRenderPass(ImGui_ImplVulkanH_Window* window, VkImageLayout finalLayout) {
+        VkAttachmentDescription attachment{};
+        attachment.format = window->SurfaceFormat.format;
+        attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment.loadOp = window->ClearEnable ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment.finalLayout = finalLayout;
+
+        VkAttachmentReference colorAttachment{};
+        colorAttachment.attachment = 0;
+        colorAttachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachment;
+
+        VkSubpassDependency dependencies[2]{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[0].srcAccessMask = 0;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+        //           TRANSFER_SRC
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        VkRenderPassCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        info.attachmentCount = 1;
+        info.pAttachments = &attachment;
+        info.subpassCount = 1;
+        info.pSubpasses = &subpass;
+        info.dependencyCount = finalLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ? 2 : 1;
+        info.pDependencies = dependencies;
+
+        VkResult result = vkCreateRenderPass(logicalDevice, &info, allocator, &window->RenderPass);
+        checkVkResult(result);
+    }
+
+    /*
+    *     vkDeviceWaitIdle.
+    *      oldSwapchain,         deletionQueue
+    *  ,  GPU  ,    .  false,   
+    */
+    bool Core::recreateSwapchain(ImGui_ImplVulkanH_Window* window, int width, int height) {
+        VkResult result;
+        const auto start = SwapchainResize::Clock::now();
+
+        VkSurfaceCapabilitiesKHR capabilities;
+        result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, window->Surface, &capabilities);
+        checkVkResult(result);
+
+        VkExtent2D extent = capabilities.currentExtent;
+        if (extent.width == 0xFFFFFFFF) {
+            //   ,    
+            extent.width = std::clamp((uint32_t)width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+            extent.height = std::clamp((uint32_t)height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        }
+        if (extent.width == 0 || extent.height == 0) {
+            return false; //  ,      
+        }
+
+        uint32_t imageCount = std::max((uint32_t)minImageCount, capabilities.minImageCount);
+        if (capabilities.maxImageCount != 0) {
+            imageCount = std::min(imageCount, capabilities.maxImageCount);
+        }
+
+        VkSwapchainKHR oldSwapchain = window->Swapchain;
+        {
+            VkSwapchainCreateInfoKHR info{};
+            info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+            info.surface = window->Surface;
+            info.minImageCount = imageCount;
+            info.imageFormat = window->SurfaceFormat.format;
+            info.imageColorSpace = window->SurfaceFormat.colorSpace;
+            info.imageExtent = extent;
+            info.imageArrayLayers = 1;
+            info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE; //     
+            info.preTransform = (capabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR) ? VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR : capabilities.currentTransform;
+            info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+            info.presentMode = window->PresentMode;
+            info.clipped = VK_TRUE;
+            info.oldSwapchain = oldSwapchain; //     ,     
+
+            result = vkCreateSwapchainKHR(logicalDevice, &info, allocator, &window->Swapchain);
+            checkVkResult(result);
+        }
+
+        /*
+        *        ,   present   .
+        *     :    present       
+        */
+        if (oldSwapchain != VK_NULL_HANDLE) {
+            const uint64_t value = retireValue();
+            for (uint32_t i = 0; i < window->ImageCount; i++) {
+                deletionQueue.retireHandle(RetiredType::Framebuffer, (uint64_t)window->Frames[i].Framebuffer, value);
+                deletionQueue.retireHandle(RetiredType::ImageView, (uint64_t)window->Frames[i].BackbufferView, value);
+            }
+            deletionQueue.retireHandle(RetiredType::Swapchain, (uint64_t)oldSwapchain, value); //    
+            for (VkSemaphore semaphore : renderCompleteSemaphores) {
+                deletionQueue.retireHandle(RetiredType::Semaphore, (uint64_t)semaphore, value); //     present   
+            }
+            renderCompleteSemaphores.clear();
+        }
+        IM_FREE(window->Frames);
+        window->Frames = nullptr;
+
+        VkImage images[16] = {};
+        result = vkGetSwapchainImagesKHR(logicalDevice, window->Swapchain, &window->ImageCount, nullptr);
+        checkVkResult(result);
+        IM_ASSERT(window->ImageCount < IM_ARRAYSIZE(images));
+        result = vkGetSwapchainImagesKHR(logicalDevice, window->Swapchain, &window->ImageCount, images);
+        checkVkResult(result);
+
+        window->Width = (int)extent.width;
+        window->Height = (int)extent.height;
+        window->FrameIndex = 0;
+        window->Frames = (ImGui_ImplVulkanH_Frame*)IM_ALLOC(sizeof(ImGui_ImplVulkanH_Frame) * window->ImageCount);
+        memset(window->Frames, 0, sizeof(window->Frames[0]) * window->ImageCount);
+
+        for (uint32_t i = 0; i < window->ImageCount; i++) {
+            ImGui_ImplVulkanH_Frame* frame = &window->Frames[i];
+            frame->Backbuffer = images[i];
+            {
+                VkImageViewCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                info.image = frame->Backbuffer;
+                info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                info.format = window->SurfaceFormat.format;
+                info.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+                info.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+                result = vkCreateImageView(logicalDevice, &info, allocator, &frame->BackbufferView);
+                checkVkResult(result);
+            }
+            {
+                VkFramebufferCreateInfo info{};
+                info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+                info.renderPass = window->RenderPass;
+                info.attachmentCount = 1;
+                info.pAttachments = &frame->BackbufferView;
+                info.width = extent.width;
+                info.height = extent.height;
+                info.layers = 1;
+                result = vkCreateFramebuffer(logicalDevice, &info, allocator, &frame->Framebuffer);
+                checkVkResult(result);
+            }
+        }
+
+        //        
+        imagesInFlight.assign(window->ImageCount, VK_NULL_HANDLE);
+        imagesInFlightValues.assign(window->ImageCount, 0);
+        createPresentSemaphores(window->ImageCount);
+
+        // Id       
+        presentSamples.clear();
+        presentIdBase = presentId;
+
+        const auto end = SwapchainResize::Clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (oldSwapchain != VK_NULL_HANDLE) {
+            swapchainStats.recreations++;
+            swapchainStats.coalescedEvents += swapchainResize.events > 1 ? swapchainResize.events - 1 : 0;
+            swapchainStats.recreateMsSum += ms;
+            swapchainStats.recreateMsMax = std::max(swapchainStats.recreateMsMax, ms);
+        }
+
+        swapchainResize.events = 0;
+        swapchainResize.suboptimal = false;
+        swapchainResize.lastRecreate = end;
+        swapChainRebuild = false;
+        return true;
+    }
+
+    /*
+    *         .
+    *    ,       (OUT_OF_DATE).    
+    *   resizeIntervalMs:          .
+    *  false,      
+    */
+    bool Core::updateSwapchain(int width, int height) {
+        ImGui_ImplVulkanH_Window* window = &imguiWindowData;
+
+        if (width <= 0 || height <= 0) {
+            return false; //  , ,   
+        }
+
+        const bool resized = width != window->Width || height != window->Height;
+        if (resized && (swapchainResize.events == 0 || width != swapchainResize.width || height != swapchainResize.height)) {
+            swapchainResize.width = width;
+            swapchainResize.height = height;
+            swapchainResize.events++;
+        }
+
+        if (!swapChainRebuild && !resized && !swapchainResize.suboptimal) {
+            swapchainStats.coalescedEvents += swapchainResize.events; //      
+            swapchainResize.events = 0;
+            return true;
+        }
+
+        const double sinceRecreate = std::chrono::duration<double, std::milli>(SwapchainResize::Clock::now() - swapchainResize.lastRecreate).count();
+        if (!swapChainRebuild && sinceRecreate < resizeIntervalMs) {
+            return true; //     ,   
+        }
+
+        return recreateSwapchain(window, width, height);
+    }
+
+    /*
+    *     ,   
+    */
+    void Core::destroySwapchain(ImGui_ImplVulkanH_Window* window) {
+        deletionQueue.flush(); //        
+
+        for (uint32_t i = 0; i < window->ImageCount; i++) {
+            vkDestroyFramebuffer(logicalDevice, window->Frames[i].Framebuffer, allocator);
+            vkDestroyImageView(logicalDevice, window->Frames[i].BackbufferView, allocator);
+        }
+        IM_FREE(window->Frames);
+        window->Frames = nullptr;
+
+        vkDestroyRenderPass(logicalDevice, window->RenderPass, allocator);
+        vkDestroySwapchainKHR(logicalDevice, window->Swapchain, allocator);
+        vkDestroySurfaceKHR(instance, window->Surface, allocator);
+        surface = VK_NULL_HANDLE;
+
+        *window = ImGui_ImplVulkanH_Window();
+    }
+
+    void Core::reportSwapchainStats() {
+        if (swapchainStats.recreations == 0) {
+            return;
+        }
+
+        LOG_INFO(Swapchain, "Swapchain: {} recreations, {} resize events coalesced, recreate avg {:.3f} ms, max {:.3f} ms", swapchainStats.recreations,
+            swapchainStats.coalescedEvents, swapchainStats.averageRecreate(), swapchainStats.recreateMsMax);
+    }
+}
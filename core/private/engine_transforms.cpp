@@ -0,0 +1,448 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+#include "../core/public/engine_transforms.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_TRANSFORMS_SSE
+#include <immintrin.h>
+#endif
+
+namespace Engine {
+    namespace {
+        constexpr uint32_t ParallelLevelSize = 4096; //      ,   
+        constexpr uint32_t RangeSize = 1024;
+
+        /*
+        *   T * R * S   mat4 
+        */
+        inline void composeLocal(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4& out) {
+            const float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+            const float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+            const float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+
+            out[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f);
+            out[1] = glm::vec4(2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f);
+            out[2] = glm::vec4(2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f);
+            out[3] = glm::vec4(position, 1.0f);
+        }
+
+        inline void multiplyScalar(const glm::mat4& parent, const glm::mat4& local, glm::mat4& out) {
+            out = parent * local;
+        }
+
+#ifdef ENGINE_TRANSFORMS_SSE
+        /*
+        *   -         
+        */
+        inline void multiplySse(const glm::mat4& parent, const glm::mat4& local, glm::mat4& out) {
+            const float* a = &parent[0][0];
+            const float* b = &local[0][0];
+            float* c = &out[0][0];
+            const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+            for (int j = 0; j < 4; j++) {
+                __m128 column = _mm_mul_ps(a0, _mm_set1_ps(b[4 * j]));
+                column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(b[4 * j + 1])));
+                column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(b[4 * j + 2])));
+                column = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(b[4 * j + 3])));
+                _mm_storeu_ps(c + 4 * j, column);
+            }
+        }
+#endif
+
+#ifdef __AVX__
+        /*
+        *     :       ,
+        *          
+        */
+        inline void multiplyAvx(const glm::mat4& parent, const glm::mat4& local, glm::mat4& out) {
+            const float* a = &parent[0][0];
+            const float* b = &local[0][0];
+            float* c = &out[0][0];
+            const __m256 a0 = _mm256_broadcast_ps((const __m128*)a), a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+            const __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8)), a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+            for (int j = 0; j < 4; j += 2) {
+                const __m256 weights = _mm256_loadu_ps(b + 4 * j);
+                __m256 columns = _mm256_mul_ps(a0, _mm256_permute_ps(weights, 0x00));
+                columns = _mm256_add_ps(columns, _mm256_mul_ps(a1, _mm256_permute_ps(weights, 0x55)));
+                columns = _mm256_add_ps(columns, _mm256_mul_ps(a2, _mm256_permute_ps(weights, 0xAA)));
+                columns = _mm256_add_ps(columns, _mm256_mul_ps(a3, _mm256_permute_ps(weights, 0xFF)));
+                _mm256_storeu_ps(c + 4 * j, columns);
+            }
+        }
+#endif
+
+        /*
+        *     .  -  ,     
+        */
+        template<void (*Multiply)(const glm::mat4&, const glm::mat4&, glm::mat4&)>
+        uint32_t updateSlots(uint32_t begin, uint32_t end, const uint32_t* parents, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+            glm::mat4* locals, glm::mat4* worlds, uint8_t* dirty, uint8_t* changed) {
+            uint32_t recomputed = 0;
+            for (uint32_t i = begin; i < end; i++) {
+                const uint32_t parent = parents[i];
+                const bool parentChanged = parent != UINT32_MAX && changed[parent] != 0;
+                if (dirty[i] == 0 && !parentChanged) {
+                    changed[i] = 0;
+                    continue;
+                }
+
+                if (dirty[i] != 0) {
+                    composeLocal(positions[i], rotations[i], scales[i], locals[i]);
+                    dirty[i] = 0;
+                }
+                if (parent == UINT32_MAX) {
+                    worlds[i] = locals[i];
+                }
+                else {
+                    Multiply(worlds[parent], locals[i], worlds[i]);
+                }
+                changed[i] = 1;
+                recomputed++;
+            }
+            return recomputed;
+        }
+    }
+
+    const char* transformKernelName(TransformKernel kernel) {
+        switch (kernel) {
+        case TransformKernel::Scalar: return "scalar";
+        case TransformKernel::Sse: return "sse";
+        case TransformKernel::Avx: return "avx";
+        default: return "?";
+        }
+    }
+
+    bool isTransformKernelSupported(TransformKernel kernel) {
+        switch (kernel) {
+        case TransformKernel::Scalar: return true;
+#ifdef ENGINE_TRANSFORMS_SSE
+        case TransformKernel::Sse: return true;
+#endif
+#ifdef __AVX__
+        case TransformKernel::Avx: return true;
+#endif
+        default: return false;
+        }
+    }
+
+    TransformKernel bestTransformKernel() {
+        if (isTransformKernelSupported(TransformKernel::Avx)) {
+            return TransformKernel::Avx;
+        }
+        if (isTransformKernelSupported(TransformKernel::Sse)) {
+            return TransformKernel::Sse;
+        }
+        return TransformKernel::Scalar;
+    }
+
+    TransformHandle TransformHierarchy::create(TransformHandle parent) {
+        uint32_t index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        else {
+            index = (uint32_t)m_nodes.size();
+            m_nodes.emplace_back();
+        }
+
+        //    ,         
+        Node& node = m_nodes[index];
+        node.slot = (uint32_t)m_slotHandles.size();
+        node.firstChild = UINT32_MAX;
+        m_slotHandles.push_back(index);
+        m_parentSlots.push_back(UINT32_MAX);
+        m_positions.push_back(glm::vec3(0.0f));
+        m_rotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        m_scales.push_back(glm::vec3(1.0f));
+        m_locals.push_back(glm::mat4(1.0f));
+        m_worlds.push_back(glm::mat4(1.0f));
+        m_dirty.push_back(0);
+        m_changed.push_back(0);
+        markDirty(node.slot);
+
+        link(index, alive(parent) ? parent.index : UINT32_MAX);
+        m_structureDirty = true;
+        m_count++;
+        return { index, node.generation };
+    }
+
+    void TransformHierarchy::destroy(TransformHandle handle) {
+        if (!alive(handle)) {
+            return;
+        }
+
+        unlink(handle.index);
+        std::vector<uint32_t> subtree{ handle.index };
+        for (size_t i = 0; i < subtree.size(); i++) {
+            Node& node = m_nodes[subtree[i]];
+            for (uint32_t child = node.firstChild; child != UINT32_MAX; child = m_nodes[child].nextSibling) {
+                subtree.push_back(child);
+            }
+
+            m_slotHandles[node.slot] = UINT32_MAX; //   
+            if (m_dirty[node.slot] != 0) {
+                m_dirty[node.slot] = 0;
+                m_dirtyCount--;
+            }
+            node.slot = UINT32_MAX;
+            node.generation++;
+            node.parent = UINT32_MAX;
+            node.firstChild = UINT32_MAX;
+            m_free.push_back(subtree[i]);
+        }
+
+        m_count -= (uint32_t)subtree.size();
+        m_structureDirty = true;
+    }
+
+    bool TransformHierarchy::alive(TransformHandle handle) const {
+        return handle.index < m_nodes.size() && m_nodes[handle.index].generation == handle.generation && m_nodes[handle.index].slot != UINT32_MAX;
+    }
+
+    void TransformHierarchy::setParent(TransformHandle handle, TransformHandle parent) {
+        if (!alive(handle)) {
+            return;
+        }
+
+        const uint32_t parentIndex = alive(parent) ? parent.index : UINT32_MAX;
+        for (uint32_t ancestor = parentIndex; ancestor != UINT32_MAX; ancestor = m_nodes[ancestor].parent) {
+            if (ancestor == handle.index) {
+                LOG_WARNING(World, "Transform {} can't become a child of its own descendant {}", handle.index, parentIndex);
+                return;
+            }
+        }
+
+        unlink(handle.index);
+        link(handle.index, parentIndex);
+        markDirty(m_nodes[handle.index].slot);
+        m_structureDirty = true;
+    }
+
+    void TransformHierarchy::link(uint32_t node, uint32_t parent) {
+        Node& child = m_nodes[node];
+        uint32_t& head = parent != UINT32_MAX ? m_nodes[parent].firstChild : m_firstRoot;
+        child.parent = parent;
+        child.previousSibling = UINT32_MAX;
+        child.nextSibling = head;
+        if (head != UINT32_MAX) {
+            m_nodes[head].previousSibling = node;
+        }
+        head = node;
+    }
+
+    void TransformHierarchy::unlink(uint32_t node) {
+        Node& child = m_nodes[node];
+        if (child.previousSibling != UINT32_MAX) {
+            m_nodes[child.previousSibling].nextSibling = child.nextSibling;
+        }
+        else if (child.parent != UINT32_MAX) {
+            m_nodes[child.parent].firstChild = child.nextSibling;
+        }
+        else {
+            m_firstRoot = child.nextSibling;
+        }
+        if (child.nextSibling != UINT32_MAX) {
+            m_nodes[child.nextSibling].previousSibling = child.previousSibling;
+        }
+        child.parent = UINT32_MAX;
+        child.nextSibling = UINT32_MAX;
+        child.previousSibling = UINT32_MAX;
+    }
+
+    uint32_t TransformHierarchy::slotOf(TransformHandle handle) const {
+        return alive(handle) ? m_nodes[handle.index].slot : UINT32_MAX;
+    }
+
+    void TransformHierarchy::markDirty(uint32_t slot) {
+        if (m_dirty[slot] == 0) {
+            m_dirty[slot] = 1;
+            m_dirtyCount++;
+        }
+    }
+
+    void TransformHierarchy::setPosition(TransformHandle handle, const glm::vec3& position) {
+        const uint32_t slot = slotOf(handle);
+        if (slot != UINT32_MAX) {
+            m_positions[slot] = position;
+            markDirty(slot);
+        }
+    }
+
+    void TransformHierarchy::setRotation(TransformHandle handle, const glm::quat& rotation) {
+        const uint32_t slot = slotOf(handle);
+        if (slot != UINT32_MAX) {
+            m_rotations[slot] = rotation;
+            markDirty(slot);
+        }
+    }
+
+    void TransformHierarchy::setScale(TransformHandle handle, const glm::vec3& scale) {
+        const uint32_t slot = slotOf(handle);
+        if (slot != UINT32_MAX) {
+            m_scales[slot] = scale;
+            markDirty(slot);
+        }
+    }
+
+    void TransformHierarchy::setLocal(TransformHandle handle, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+        const uint32_t slot = slotOf(handle);
+        if (slot != UINT32_MAX) {
+            m_positions[slot] = position;
+            m_rotations[slot] = rotation;
+            m_scales[slot] = scale;
+            markDirty(slot);
+        }
+    }
+
+    glm::vec3 TransformHierarchy::position(TransformHandle handle) const {
+        const uint32_t slot = slotOf(handle);
+        return slot != UINT32_MAX ? m_positions[slot] : glm::vec3(0.0f);
+    }
+
+    glm::quat TransformHierarchy::rotation(TransformHandle handle) const {
+        const uint32_t slot = slotOf(handle);
+        return slot != UINT32_MAX ? m_rotations[slot] : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    glm::vec3 TransformHierarchy::scale(TransformHandle handle) const {
+        const uint32_t slot = slotOf(handle);
+        return slot != UINT32_MAX ? m_scales[slot] : glm::vec3(1.0f);
+    }
+
+    const glm::mat4& TransformHierarchy::world(TransformHandle handle) const {
+        static const glm::mat4 identity(1.0f);
+        const uint32_t slot = slotOf(handle);
+        return slot != UINT32_MAX ? m_worlds[slot] : identity;
+    }
+
+    void TransformHierarchy::setKernel(TransformKernel kernel) {
+        if (!isTransformKernelSupported(kernel)) {
+            LOG_WARNING(World, "Transform kernel {} is not available in this build, keeping {}", transformKernelName(kernel), transformKernelName(m_kernel));
+            return;
+        }
+        m_kernel = kernel;
+    }
+
+    /*
+    *      :   ,    .
+    *    ,     
+    */
+    void TransformHierarchy::rebuild() {
+        PROFILE_FUNCTION();
+        std::vector<uint32_t> order;
+        order.reserve(m_count);
+        m_levels.clear();
+        for (uint32_t root = m_firstRoot; root != UINT32_MAX; root = m_nodes[root].nextSibling) {
+            order.push_back(root);
+        }
+        size_t levelBegin = 0;
+        while (levelBegin < order.size()) {
+            m_levels.push_back((uint32_t)levelBegin);
+            const size_t levelEnd = order.size();
+            for (size_t i = levelBegin; i < levelEnd; i++) {
+                for (uint32_t child = m_nodes[order[i]].firstChild; child != UINT32_MAX; child = m_nodes[child].nextSibling) {
+                    order.push_back(child);
+                }
+            }
+            levelBegin = levelEnd;
+        }
+        m_levels.push_back((uint32_t)order.size());
+
+        std::vector<uint32_t> parentSlots(order.size());
+        std::vector<glm::vec3> positions(order.size());
+        std::vector<glm::quat> rotations(order.size());
+        std::vector<glm::vec3> scales(order.size());
+        std::vector<glm::mat4> locals(order.size());
+        std::vector<glm::mat4> worlds(order.size());
+        std::vector<uint8_t> dirty(order.size());
+        for (uint32_t slot = 0; slot < order.size(); slot++) {
+            const uint32_t old = m_nodes[order[slot]].slot;
+            positions[slot] = m_positions[old];
+            rotations[slot] = m_rotations[old];
+            scales[slot] = m_scales[old];
+            locals[slot] = m_locals[old];
+            worlds[slot] = m_worlds[old];
+            dirty[slot] = m_dirty[old];
+        }
+        for (uint32_t slot = 0; slot < order.size(); slot++) {
+            m_nodes[order[slot]].slot = slot; //  :     
+        }
+        for (uint32_t slot = 0; slot < order.size(); slot++) {
+            const uint32_t parent = m_nodes[order[slot]].parent;
+            parentSlots[slot] = parent != UINT32_MAX ? m_nodes[parent].slot : UINT32_MAX;
+        }
+
+        m_slotHandles = std::move(order);
+        m_parentSlots = std::move(parentSlots);
+        m_positions = std::move(positions);
+        m_rotations = std::move(rotations);
+        m_scales = std::move(scales);
+        m_locals = std::move(locals);
+        m_worlds = std::move(worlds);
+        m_dirty = std::move(dirty);
+        m_changed.assign(m_slotHandles.size(), 0);
+        m_structureDirty = false;
+        m_stats.rebuilds++;
+    }
+
+    uint32_t TransformHierarchy::updateRange(uint32_t begin, uint32_t end) {
+        switch (m_kernel) {
+#ifdef __AVX__
+        case TransformKernel::Avx:
+            return updateSlots<multiplyAvx>(begin, end, m_parentSlots.data(), m_positions.data(), m_rotations.data(), m_scales.data(), m_locals.data(), m_worlds.data(), m_dirty.data(), m_changed.data());
+#endif
+#ifdef ENGINE_TRANSFORMS_SSE
+        case TransformKernel::Sse:
+            return updateSlots<multiplySse>(begin, end, m_parentSlots.data(), m_positions.data(), m_rotations.data(), m_scales.data(), m_locals.data(), m_worlds.data(), m_dirty.data(), m_changed.data());
+#endif
+        default:
+            return updateSlots<multiplyScalar>(begin, end, m_parentSlots.data(), m_positions.data(), m_rotations.data(), m_scales.data(), m_locals.data(), m_worlds.data(), m_dirty.data(), m_changed.data());
+        }
+    }
+
+    /*
+    *   :    ,        .
+    *    ,    
+    */
+    void TransformHierarchy::update(JobSystem& jobs) {
+        PROFILE_FUNCTION();
+        if (!m_structureDirty && m_dirtyCount == 0) {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        if (m_structureDirty) {
+            rebuild();
+        }
+
+        std::atomic<uint64_t> recomputed{ 0 };
+        for (size_t level = 0; level + 1 < m_levels.size(); level++) {
+            const uint32_t begin = m_levels[level];
+            const uint32_t end = m_levels[level + 1];
+            if (end - begin < ParallelLevelSize || jobs.threadCount() < 2) {
+                recomputed += updateRange(begin, end);
+                continue;
+            }
+
+            jobs.parallelFor(end - begin, RangeSize, [&](uint32_t rangeBegin, uint32_t rangeEnd) {
+                recomputed.fetch_add(updateRange(begin + rangeBegin, begin + rangeEnd), std::memory_order_relaxed);
+            });
+        }
+        m_dirtyCount = 0;
+
+        m_stats.updates++;
+        m_stats.recomputed += recomputed.load();
+        m_stats.updateMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void TransformHierarchy::reportStats() {
+        if (m_stats.updates == 0) {
+            return;
+        }
+
+        LOG_INFO(World, "Transforms ({}, {} nodes, depth {}): {} updates, {:.3f} ms avg, {} recomputed, {} rebuilds", transformKernelName(m_kernel), m_count, depth(),
+            m_stats.updates, m_stats.updateMs / m_stats.updates, m_stats.recomputed, m_stats.rebuilds);
+        m_stats = TransformStats{};
+    }
+}
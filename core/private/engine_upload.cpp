@@ -0,0 +1,168 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+namespace Engine {
+    void UploadService::initialize(VkDevice device, const VkAllocationCallbacks* allocator, DeviceAllocator* memoryAllocator, QueueTopology* queues) {
+        VkResult result;
+
+        m_device = device;
+        m_allocator = allocator;
+        m_memoryAllocator = memoryAllocator;
+        m_queues = queues;
+        m_queueFamily = queues->get(QueueType::Transfer).family;
+        m_submitted = 0;
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; //        
+        poolInfo.queueFamilyIndex = m_queueFamily;
+        result = vkCreateCommandPool(device, &poolInfo, allocator, &m_commandPool);
+        Core::checkVkResult(result);
+    }
+
+    void UploadService::shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        waitIdle();
+
+        vkDestroyCommandPool(m_device, m_commandPool, m_allocator);
+        m_commandPool = VK_NULL_HANDLE;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    uint64_t UploadService::uploadImage(VkImage image, uint32_t width, uint32_t height, const void* pixels, size_t size) {
+        VkResult result;
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        Pending pending;
+        pending.bytes = size;
+        pending.submitTime = std::chrono::steady_clock::now();
+
+        // Staging     ,    collect
+        {
+            VkBufferCreateInfo bufferInfo{};
+            bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size = size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            result = vkCreateBuffer(m_device, &bufferInfo, m_allocator, &pending.staging);
+            Core::checkVkResult(result);
+
+            VkMemoryRequirements requirements;
+            vkGetBufferMemoryRequirements(m_device, pending.staging, &requirements);
+            if (!m_memoryAllocator->allocate(requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, pending.stagingMemory)) {
+                vkDestroyBuffer(m_device, pending.staging, m_allocator);
+                LOG_ERROR(Upload, "Upload: can't allocate {} bytes of staging memory", size);
+                return 0;
+            }
+            result = vkBindBufferMemory(m_device, pending.staging, pending.stagingMemory.memory, pending.stagingMemory.offset);
+            Core::checkVkResult(result);
+
+            memcpy(pending.stagingMemory.mapped, pixels, size);
+            if (!(pending.stagingMemory.propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+                VkMappedMemoryRange range{};
+                range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+                range.memory = pending.stagingMemory.memory;
+                range.offset = pending.stagingMemory.offset;
+                range.size = pending.stagingMemory.block == UINT32_MAX ? VK_WHOLE_SIZE : pending.stagingMemory.size; //     nonCoherentAtomSize
+                result = vkFlushMappedMemoryRanges(m_device, 1, &range);
+                Core::checkVkResult(result);
+            }
+        }
+
+        {
+            VkCommandBufferAllocateInfo allocateInfo{};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.commandPool = m_commandPool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            result = vkAllocateCommandBuffers(m_device, &allocateInfo, &pending.commandBuffer);
+            Core::checkVkResult(result);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            result = vkBeginCommandBuffer(pending.commandBuffer, &beginInfo);
+            Core::checkVkResult(result);
+        }
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        vkCmdPipelineBarrier(pending.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent.width = width;
+        region.imageExtent.height = height;
+        region.imageExtent.depth = 1;
+        vkCmdCopyBufferToImage(pending.commandBuffer, pending.staging, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        /*
+        * Transfer     ,     layout,
+        *           
+        */
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        vkCmdPipelineBarrier(pending.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        result = vkEndCommandBuffer(pending.commandBuffer);
+        Core::checkVkResult(result);
+
+        //     Transfer    timeline,    
+        pending.value = m_queues->submitTimeline(QueueType::Transfer, 0, nullptr, nullptr, nullptr, 1, &pending.commandBuffer);
+        m_submitted = pending.value;
+        m_pending.push_back(pending);
+        return pending.value;
+    }
+
+    void UploadService::waitIdle() {
+        m_queues->waitValue(QueueType::Transfer, m_submitted); //    ,    
+        collect();
+    }
+
+    void UploadService::collect() {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_pending.empty()) {
+            return;
+        }
+
+        const uint64_t completed = m_queues->completedValue(QueueType::Transfer);
+
+        const auto now = std::chrono::steady_clock::now();
+        size_t kept = 0;
+        for (size_t i = 0; i < m_pending.size(); i++) {
+            Pending& pending = m_pending[i];
+            if (pending.value > completed) {
+                m_pending[kept++] = pending; //  
+                continue;
+            }
+
+            const double ms = std::chrono::duration<double, std::milli>(now - pending.submitTime).count();
+            LOG_INFO(Upload, "Upload {} finished: {} KiB, collected {:.3f} ms after submit", pending.value, pending.bytes >> 10, ms);
+            vkFreeCommandBuffers(m_device, m_commandPool, 1, &pending.commandBuffer);
+            vkDestroyBuffer(m_device, pending.staging, m_allocator);
+            m_memoryAllocator->free(pending.stagingMemory);
+        }
+        m_pending.resize(kept);
+    }
+
+    bool Core::imguiUploadTexture(VkImage image, uint32_t width, uint32_t height, const void* pixels, size_t size, void* userData) {
+        Core* core = (Core*)userData;
+        return core->uploadService.uploadImage(image, width, height, pixels, size) != 0;
+    }
+}
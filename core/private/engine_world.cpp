@@ -0,0 +1,536 @@
+#include "../core/public/engine.hpp"
+#include "../core/public/engine_logs.hpp"
+
+#include <new>
+
+namespace Engine {
+    namespace {
+        struct ComponentRegistry {
+            std::mutex lock;
+            ComponentInfo infos[MaxComponents];
+            std::atomic<uint32_t> count{ 0 };
+        };
+
+        ComponentRegistry& componentRegistry() {
+            static ComponentRegistry registry;
+            return registry;
+        }
+
+        constexpr size_t ColumnAlignment = 64; //      
+
+        size_t alignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint8_t* allocateChunk() {
+            return (uint8_t*)::operator new(Archetype::ChunkSize, std::align_val_t(ColumnAlignment));
+        }
+
+        void freeChunk(uint8_t* chunk) {
+            ::operator delete(chunk, std::align_val_t(ColumnAlignment));
+        }
+
+        std::atomic<uint64_t> nextWorldId{ 1 };
+    }
+
+    uint32_t registerComponent(const ComponentInfo& info) {
+        ComponentRegistry& registry = componentRegistry();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        const uint32_t id = registry.count.load(std::memory_order_relaxed);
+        if (id >= MaxComponents) {
+            LOG_CRITICAL(World, "Too many component types, {} is over the limit of {}", info.name, MaxComponents);
+            std::abort();
+        }
+
+        registry.infos[id] = info;
+        registry.count.store(id + 1, std::memory_order_release);
+        LOG_DEBUG(World, "Component {} '{}': {} bytes", id, info.name, info.size);
+        return id;
+    }
+
+    const ComponentInfo& componentInfo(uint32_t id) {
+        return componentRegistry().infos[id];
+    }
+
+    uint32_t componentCount() {
+        return componentRegistry().count.load(std::memory_order_acquire);
+    }
+
+    Entity CommandBuffer::create() {
+        const Entity entity = m_world->reserve();
+        push(Op::Create, entity, 0, nullptr, 0);
+        return entity;
+    }
+
+    void CommandBuffer::destroy(Entity entity) {
+        push(Op::Destroy, entity, 0, nullptr, 0);
+    }
+
+    void CommandBuffer::push(Op op, Entity entity, uint32_t component, const void* value, uint32_t size) {
+        const size_t offset = m_data.size();
+        m_data.resize(offset + alignUp(sizeof(Header) + size, 8));
+
+        Header header = { entity, op, component, size };
+        memcpy(m_data.data() + offset, &header, sizeof(header));
+        if (size != 0) {
+            memcpy(m_data.data() + offset + sizeof(header), value, size);
+        }
+        m_count++;
+    }
+
+    World::World() : m_id(nextWorldId.fetch_add(1)) {
+        findArchetype(ComponentMask()); //   
+    }
+
+    World::~World() {
+        for (auto& archetype : m_archetypes) {
+            for (uint8_t* chunk : archetype->chunks) {
+                freeChunk(chunk);
+            }
+            if (archetype->spare != nullptr) {
+                freeChunk(archetype->spare);
+            }
+        }
+    }
+
+    /*
+    *   ,           
+    */
+    Archetype* World::findArchetype(const ComponentMask& mask) {
+        auto found = m_archetypeMap.find(mask);
+        if (found != m_archetypeMap.end()) {
+            return found->second;
+        }
+
+        auto archetype = std::make_unique<Archetype>();
+        archetype->mask = mask;
+        memset(archetype->columns, 0xFF, sizeof(archetype->columns));
+        size_t rowSize = sizeof(Entity);
+        for (uint32_t id = 0; id < MaxComponents; id++) {
+            if (mask.test(id)) {
+                archetype->columns[id] = (uint8_t)archetype->components.size();
+                archetype->components.push_back(id);
+                rowSize += componentInfo(id).size;
+            }
+        }
+
+        //         
+        uint32_t capacity = (uint32_t)((Archetype::ChunkSize - ColumnAlignment * archetype->components.size()) / rowSize);
+        for (;; capacity--) {
+            size_t offset = sizeof(Entity) * capacity;
+            archetype->offsets.clear();
+            for (uint32_t id : archetype->components) {
+                const ComponentInfo& info = componentInfo(id);
+                offset = alignUp(offset, std::max<size_t>(info.alignment, ColumnAlignment));
+                archetype->offsets.push_back((uint32_t)offset);
+                offset += (size_t)info.size * capacity;
+            }
+            if (offset <= Archetype::ChunkSize) {
+                break;
+            }
+        }
+        if (capacity == 0) {
+            LOG_CRITICAL(World, "Archetype with {} components doesn't fit into a {} byte chunk", archetype->components.size(), Archetype::ChunkSize);
+            std::abort();
+        }
+        archetype->capacity = capacity;
+
+        Archetype* result = archetype.get();
+        m_archetypes.push_back(std::move(archetype));
+        m_archetypeMap[mask] = result;
+        {
+            std::lock_guard<std::mutex> guard(m_queryLock);
+            for (auto& query : m_queries) {
+                if ((mask & query.first) == query.first) {
+                    query.second.push_back(result);
+                }
+            }
+        }
+        m_structureVersion++;
+        return result;
+    }
+
+    const std::vector<Archetype*>& World::query(const ComponentMask& mask) {
+        std::lock_guard<std::mutex> guard(m_queryLock);
+        auto found = m_queries.find(mask);
+        if (found != m_queries.end()) {
+            return found->second;
+        }
+
+        std::vector<Archetype*>& archetypes = m_queries[mask];
+        for (auto& archetype : m_archetypes) {
+            if ((archetype->mask & mask) == mask) {
+                archetypes.push_back(archetype.get());
+            }
+        }
+        return archetypes;
+    }
+
+    const std::vector<World::ChunkRef>& World::chunkList(const ComponentMask& mask) {
+        const std::vector<Archetype*>& archetypes = query(mask);
+
+        std::lock_guard<std::mutex> guard(m_queryLock);
+        ChunkList& list = m_chunkLists[mask];
+        if (list.version != m_structureVersion) {
+            list.chunks.clear();
+            for (Archetype* archetype : archetypes) {
+                for (size_t chunk = 0; chunk < archetype->chunks.size(); chunk++) {
+                    list.chunks.push_back({ archetype, chunk });
+                }
+            }
+            list.version = m_structureVersion;
+        }
+        return list.chunks;
+    }
+
+    Entity World::create() {
+        return createIn(m_archetypes[0].get());
+    }
+
+    Entity World::createIn(Archetype* archetype) {
+        Entity entity;
+        {
+            std::lock_guard<std::mutex> guard(m_reserveLock);
+            if (!m_free.empty()) {
+                entity.index = m_free.back();
+                m_free.pop_back();
+                entity.generation = m_records[entity.index].generation;
+            }
+            else {
+                //       ,  flush   
+                m_records.resize(m_records.size() + m_reserved + 1);
+                m_reserved = 0;
+                entity.index = (uint32_t)m_records.size() - 1;
+                entity.generation = 0;
+            }
+        }
+
+        place(entity, archetype);
+        return entity;
+    }
+
+    /*
+    *   CommandBuffer::create   .    m_records   flush
+    */
+    Entity World::reserve() {
+        std::lock_guard<std::mutex> guard(m_reserveLock);
+        Entity entity;
+        if (!m_free.empty()) {
+            entity.index = m_free.back();
+            m_free.pop_back();
+            entity.generation = m_records[entity.index].generation;
+        }
+        else {
+            entity.index = (uint32_t)m_records.size() + m_reserved++;
+            entity.generation = 0;
+        }
+        return entity;
+    }
+
+    void World::place(Entity entity, Archetype* archetype) {
+        Record& record = m_records[entity.index];
+        record.archetype = archetype;
+        record.row = pushRow(archetype, entity);
+        record.generation = entity.generation;
+        m_entityCount++;
+    }
+
+    void World::destroy(Entity entity) {
+        if (!alive(entity)) {
+            return;
+        }
+
+        Record& record = m_records[entity.index];
+        removeRow(record.archetype, record.row);
+        record.archetype = nullptr;
+        record.generation++;
+        m_entityCount--;
+
+        std::lock_guard<std::mutex> guard(m_reserveLock);
+        m_free.push_back(entity.index);
+    }
+
+    bool World::alive(Entity entity) const {
+        return entity.index < m_records.size() && m_records[entity.index].generation == entity.generation && m_records[entity.index].archetype != nullptr;
+    }
+
+    uint32_t World::pushRow(Archetype* archetype, Entity entity) {
+        const uint32_t row = archetype->count++;
+        const size_t chunk = row / archetype->capacity;
+        if (chunk == archetype->chunks.size()) {
+            uint8_t* memory = archetype->spare != nullptr ? archetype->spare : allocateChunk();
+            archetype->spare = nullptr;
+            archetype->chunks.push_back(memory);
+            m_structureVersion++;
+        }
+
+        archetype->entities(chunk)[row % archetype->capacity] = entity;
+        return row;
+    }
+
+    /*
+    *       ,    
+    */
+    void World::removeRow(Archetype* archetype, uint32_t row) {
+        const uint32_t last = --archetype->count;
+        if (row != last) {
+            const size_t toChunk = row / archetype->capacity, toRow = row % archetype->capacity;
+            const size_t fromChunk = last / archetype->capacity, fromRow = last % archetype->capacity;
+
+            const Entity moved = archetype->entities(fromChunk)[fromRow];
+            archetype->entities(toChunk)[toRow] = moved;
+            for (uint32_t id : archetype->components) {
+                const uint32_t size = componentInfo(id).size;
+                memcpy(archetype->column(toChunk, id) + toRow * size, archetype->column(fromChunk, id) + fromRow * size, size);
+            }
+            m_records[moved.index].row = row;
+        }
+
+        if (last % archetype->capacity == 0) {
+            if (archetype->spare != nullptr) {
+                freeChunk(archetype->spare);
+            }
+            archetype->spare = archetype->chunks.back();
+            archetype->chunks.pop_back();
+            m_structureVersion++;
+        }
+    }
+
+    /*
+    *     :   ,  
+    */
+    void World::move(Entity entity, Archetype* target) {
+        Record& record = m_records[entity.index];
+        Archetype* source = record.archetype;
+        const uint32_t sourceRow = record.row;
+        const uint32_t targetRow = pushRow(target, entity);
+
+        const size_t sourceChunk = sourceRow / source->capacity, sourceIndex = sourceRow % source->capacity;
+        const size_t targetChunk = targetRow / target->capacity, targetIndex = targetRow % target->capacity;
+        for (uint32_t id : source->components) {
+            if (target->mask.test(id)) {
+                const uint32_t size = componentInfo(id).size;
+                memcpy(target->column(targetChunk, id) + targetIndex * size, source->column(sourceChunk, id) + sourceIndex * size, size);
+            }
+        }
+
+        removeRow(source, sourceRow);
+        record.archetype = target;
+        record.row = targetRow;
+        m_stats.moves++;
+    }
+
+    void* World::addComponent(Entity entity, uint32_t component, const void* value) {
+        if (!alive(entity)) {
+            return nullptr;
+        }
+
+        Archetype* source = m_records[entity.index].archetype;
+        if (!source->mask.test(component)) {
+            Archetype* target = source->addEdges[component];
+            if (target == nullptr) {
+                ComponentMask mask = source->mask;
+                target = findArchetype(mask.set(component));
+                source->addEdges[component] = target;
+                target->removeEdges[component] = source;
+            }
+            move(entity, target);
+        }
+
+        void* data = getComponent(entity, component);
+        memcpy(data, value, componentInfo(component).size);
+        return data;
+    }
+
+    void World::removeComponent(Entity entity, uint32_t component) {
+        if (!alive(entity)) {
+            return;
+        }
+
+        Archetype* source = m_records[entity.index].archetype;
+        if (!source->mask.test(component)) {
+            return;
+        }
+
+        Archetype* target = source->removeEdges[component];
+        if (target == nullptr) {
+            ComponentMask mask = source->mask;
+            target = findArchetype(mask.reset(component));
+            source->removeEdges[component] = target;
+            target->addEdges[component] = source;
+        }
+        move(entity, target);
+    }
+
+    void* World::getComponent(Entity entity, uint32_t component) {
+        if (!alive(entity)) {
+            return nullptr;
+        }
+
+        const Record& record = m_records[entity.index];
+        if (!record.archetype->mask.test(component)) {
+            return nullptr;
+        }
+        return record.archetype->column(record.row / record.archetype->capacity, component) + (size_t)(record.row % record.archetype->capacity) * componentInfo(component).size;
+    }
+
+    /*
+    *     ,    thread_local  
+    */
+    CommandBuffer& World::commands() {
+        struct CachedBuffer {
+            uint64_t world = 0;
+            CommandBuffer* buffer = nullptr;
+        };
+        thread_local CachedBuffer t_cached;
+        if (t_cached.world == m_id) {
+            return *t_cached.buffer;
+        }
+
+        std::lock_guard<std::mutex> guard(m_commandsLock);
+        const std::thread::id thread = std::this_thread::get_id();
+        CommandBuffer* buffer = nullptr;
+        for (auto& existing : m_commandBuffers) {
+            if (existing->m_thread == thread) {
+                buffer = existing.get();
+                break;
+            }
+        }
+        if (buffer == nullptr) {
+            m_commandBuffers.push_back(std::make_unique<CommandBuffer>(this));
+            buffer = m_commandBuffers.back().get();
+            buffer->m_thread = thread;
+        }
+
+        t_cached = { m_id, buffer };
+        return *buffer;
+    }
+
+    /*
+    *    ,   -   .
+    *     ,            
+    */
+    void World::flush() {
+        PROFILE_FUNCTION();
+        {
+            //    ,   create   
+            std::lock_guard<std::mutex> guard(m_reserveLock);
+            m_records.resize(m_records.size() + m_reserved);
+            m_reserved = 0;
+        }
+
+        std::lock_guard<std::mutex> guard(m_commandsLock);
+        for (auto& buffer : m_commandBuffers) {
+            if (!buffer->empty()) {
+                apply(*buffer);
+            }
+        }
+    }
+
+    void World::apply(CommandBuffer& buffer) {
+        size_t offset = 0;
+        while (offset < buffer.m_data.size()) {
+            CommandBuffer::Header header;
+            memcpy(&header, buffer.m_data.data() + offset, sizeof(header));
+            const uint8_t* value = buffer.m_data.data() + offset + sizeof(header);
+            offset += alignUp(sizeof(header) + header.size, 8);
+
+            const Entity entity = header.entity;
+            if (header.op == CommandBuffer::Op::Create) {
+                place(entity, m_archetypes[0].get());
+                m_stats.commands++;
+                continue;
+            }
+            if (!alive(entity)) {
+                m_stats.staleCommands++;
+                continue;
+            }
+
+            switch (header.op) {
+            case CommandBuffer::Op::Destroy: destroy(entity); break;
+            case CommandBuffer::Op::Add: addComponent(entity, header.component, value); break;
+            case CommandBuffer::Op::Remove: removeComponent(entity, header.component); break;
+            default: break;
+            }
+            m_stats.commands++;
+        }
+
+        buffer.m_data.clear();
+        buffer.m_count = 0;
+    }
+
+    WorldStats World::stats() const {
+        WorldStats stats = m_stats;
+        stats.entities = m_entityCount;
+        stats.archetypes = m_archetypes.size();
+        stats.chunks = 0;
+        for (const auto& archetype : m_archetypes) {
+            stats.chunks += archetype->chunks.size();
+        }
+        return stats;
+    }
+
+    void World::reportStats() {
+        const WorldStats stats = this->stats();
+        if (stats.entities == 0 && stats.commands == 0) {
+            return;
+        }
+
+        LOG_INFO(World, "World: {} entities in {} archetypes, {} chunks ({} KB), {} moves, {} commands, {} stale", stats.entities, stats.archetypes, stats.chunks,
+            stats.chunks * Archetype::ChunkSize / 1024, stats.moves, stats.commands, stats.staleCommands);
+        m_stats.moves = 0;
+        m_stats.commands = 0;
+        m_stats.staleCommands = 0;
+    }
+
+    uint32_t SystemScheduler::add(const char* name, const ComponentMask& reads, const ComponentMask& writes, SystemFunction function, bool mainThread) {
+        m_systems.push_back({ name, reads, writes, std::move(function), mainThread });
+        m_dirty = true;
+        return (uint32_t)(m_systems.size() - 1);
+    }
+
+    void SystemScheduler::clear() {
+        m_systems.clear();
+        m_graph.clear();
+        m_dirty = false;
+    }
+
+    /*
+    *       :       ,   
+    */
+    void SystemScheduler::build() {
+        m_graph.clear();
+        for (uint32_t i = 0; i < m_systems.size(); i++) {
+            m_graph.add([this, i]() {
+                PROFILE_SCOPE(m_systems[i].name);
+                m_systems[i].function(*m_context);
+            }, m_systems[i].mainThread);
+        }
+
+        for (uint32_t i = 0; i < m_systems.size(); i++) {
+            for (uint32_t j = 0; j < i; j++) {
+                const System& later = m_systems[i];
+                const System& earlier = m_systems[j];
+                if ((later.writes & (earlier.reads | earlier.writes)).any() || (later.reads & earlier.writes).any()) {
+                    m_graph.depend(i, j);
+                }
+            }
+        }
+        m_dirty = false;
+    }
+
+    void SystemScheduler::run(World& world, JobSystem& jobs, uint32_t tick, double deltaTime) {
+        if (m_dirty) {
+            build();
+        }
+
+        SystemContext context{ world, jobs, tick, deltaTime };
+        m_context = &context;
+        if (!m_systems.empty()) {
+            m_graph.run(jobs);
+        }
+        m_context = nullptr;
+
+        world.flush();
+    }
+}
@@ -17,11 +17,16 @@
 #include <sstream>
 #include <optional>
 #include <set>
+#include <deque>
 #include <cstdint>
 #include <algorithm>
+#include <string>
+#include <chrono>
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 #include <vulkan/vulkan.h>
 
@@ -30,16 +35,30 @@
 #include "../core/imgui/imgui_impl_glfw.h"
 #include "../core/imgui/imgui_impl_vulkan.h"
 
+// engine
+#include "../core/public/engine_frames.hpp"
+#include "../core/public/engine_pipeline_cache.hpp"
+#include "../core/public/engine_device.hpp"
+#include "../core/public/engine_queues.hpp"
+#include "../core/public/engine_upload.hpp"
+#include "../core/public/engine_deletion.hpp"
+#include "../core/public/engine_host_memory.hpp"
+#include "../core/public/engine_swapchain.hpp"
+#include "../core/public/engine_offscreen.hpp"
+#include "../core/public/engine_jobs.hpp"
+#include "../core/public/engine_simulation.hpp"
+#include "../core/public/engine_world.hpp"
+#include "../core/public/engine_transforms.hpp"
+#include "../core/public/engine_pacing.hpp"
+#include "../core/public/engine_profiler.hpp"
+#include "../core/public/engine_imgui_cache.hpp"
+
 // volk headers
 #ifdef IMGUI_IMPL_VULKAN_USE_VOLK
 #define VOLK_IMPLEMENTATION
 #include <volk.h>
 #endif
 
-#define SS(x) ( ((std::stringstream&)(std::stringstream() << x )).str()) //    c++17 moment
-
-#define LockFPS = true
-
 namespace Engine {
 #ifdef _DEBUG
 #define APP_USE_VULKAN_DEBUG_REPORT
@@ -80,22 +99,138 @@ namespace Engine {
 		/*
 		*  
 		*/
-		VkAllocationCallbacks* allocator = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* allocator = nullptr; // hostAllocator.callbacks(),   
+		HostAllocator hostAllocator; //     ,    
+		bool hostAllocatorEnabled = true; // --host-allocator=0 -    
 		VkInstance instance = VK_NULL_HANDLE;
+		uint32_t instanceApiVersion = VK_API_VERSION_1_0; // apiVersion : 1.2  ,   
 		VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
 		VkDevice logicalDevice = VK_NULL_HANDLE;
 		uint32_t queueFamily = (uint32_t) - 1;
 		VkQueue queue = VK_NULL_HANDLE;
+		DeviceRequirements deviceRequirements; //   vulkanInitialize,    
+		std::string preferredDevice; // --device=<   >
+		std::vector<const char*> deviceExtensions; //   
+		QueueTopology queues; //   , queueFamily  queue -  
+		VkSurfaceKHR surface = VK_NULL_HANDLE;
+		bool timelineSemaphores = false; // Vulkan 1.2 timelineSemaphore,       
+		bool bindlessSupported = false; //   bindless  ImGui   
+		uint32_t bindlessMaxTextures = 0;
 		VkDebugReportCallbackEXT debugReport = VK_NULL_HANDLE;
 		VkPipelineCache pipelineCache = VK_NULL_HANDLE;
 		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		DeviceAllocator memoryAllocator; //      ImGui   
+		bool memoryBudget = false; // VK_EXT_memory_budget:      
+		bool showMemory = false;
+		HostMemoryStats memoryWindowStats; //    ,    
+		UploadService uploadService; //     transfer 
+		DeletionQueue deletionQueue; //  ,  GPU     
+		uint64_t graphicsSubmitted = 0; //     (timeline     )
+		uint64_t graphicsCompleted = 0; //   ,  GPU  
 
 		ImGui_ImplVulkanH_Window imguiWindowData;
-		int minImageCount = 0;
-		bool swapChainRebuild = false;
+		int minImageCount = 0; // 0 -   ,   createVulkanSurface
+		bool swapChainRebuild = false; //   OUT_OF_DATE,    
+		SwapchainResize swapchainResize;
+		SwapchainStats swapchainStats;
+		double resizeIntervalMs = 33.0; //   ,     
+
+		/*
+		*     
+		*/
+		std::vector<VkPresentModeKHR> presentModePreference{ VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_KHR }; // --present=<>    
+		std::vector<VkPresentModeKHR> supportedPresentModes;
+		FramePacer pacer;
+		double targetFps = 0.0; // 0 -   
+		bool presentWait = false; // VK_KHR_present_id + VK_KHR_present_wait
+		PFN_vkWaitForPresentKHR waitForPresent = nullptr;
+		uint64_t presentId = 0; // Id   
+		uint64_t presentIdBase = 0; // presentId     ,     
+		uint32_t maxQueuedPresents = 0; //     , 0 -    
+		std::deque<PresentSample> presentSamples;
+		LatencyStats latencyStats;
+		LatencyStats lastLatency; //    ,   
+		double presentWaitMs = 0.0;
+		std::chrono::steady_clock::time_point inputTime{}; //      
+
+		/*
+		*    (--idle=1):       ,
+		*     ImDrawData,   ,     
+		*/
+		bool idleSkipping = false;
+		double idleKeepAliveMs = 250.0; //      ,       
+		uint32_t idleSettleFrames = 3; //    :     ImGui   
+		uint32_t idleActiveFrames = 0;
+		uint64_t idleHash = 0; // ImDrawData,        
+		bool idleForceRender = true; //    
+		IdleStats idleStats;
+
+		/*
+		*   :    offscreen    
+		*/
+		bool headless = false;
+		std::vector<OffscreenImage> offscreenImages; //      ,  - imageIndex 
+		std::string frameDumpDirectory; //  -     
+		uint32_t frameDumpEvery = 1; //   N- 
+		uint64_t frameLimit = 0; //    , 0 -  
+		HeadlessStats headlessStats;
+
+		/*
+		*    
+		*/
+		JobSystem jobs;
+		uint32_t jobThreads = UINT32_MAX; //    , UINT32_MAX -   
+		JobCounter updateJobs; // ,   update,    
+
+		/*
+		*    
+		*/
+		SimulationClock simulation;
+		double tickRate = 60.0; //   
+		uint32_t maxTicksPerFrame = 8; //  :      
+		double maxFrameTime = 0.25; // ,     
+		uint32_t ticksPerFrame = 0; // > 0 -  ,     
+
+		/*
+		*     ,   
+		*/
+		World world;
+		SystemScheduler systems;
+		TransformHierarchy transforms; //        
+
+		/*
+		*   
+		*/
+		uint32_t framesInFlight = 2; //   CPU   ,  GPU  
+		uint32_t currentFrame = 0; //      frames
+		VkDeviceSize transientBufferSize = 1024 * 1024; //     
+		std::vector<FrameContext> frames;
+		std::vector<VkFence> imagesInFlight; // Fence ,       
+		std::vector<VkSemaphore> renderCompleteSemaphores; //      ,  present
+		std::vector<uint64_t> imagesInFlightValues; //     Timeline:      
+		FrameSyncMode syncMode = FrameSyncMode::Timeline; //   timeline    Fences
+		FrameStats frameStats;
+		bool imguiStreamingBuffer = true; //  ImGui         
+		bool imguiParallel = false; //      ImGui   ,    
+		uint32_t imguiParallelMinCommands = 1024; //   -    ,    
+		bool imguiStateTracking = true; //   scissor   ,   
+		bool imguiBindless = false; //     ,    -  vkCmdDrawIndexedIndirect
+		bool imguiBindlessCreated = false; //    bindless  :   --imgui-bindless=1   
+		uint32_t imguiMaxTextures = 1024; //        bindless 
+		ImGui_ImplVulkan_RenderStats imguiRenderStats{}; //  
+		ImGuiWindowCache imguiCache; //    ,    (--imgui-cache=1)
+		GpuProfiler gpuProfiler; //   GPU,    ENGINE_PROFILER
+		bool showProfiler = false;
+
+		/*
+		*    
+		*/
+		std::string pipelineCachePath = "pipeline_cache.bin";
+		WorkerPipelineCaches workerPipelineCaches;
+		StartupTimings startupTimings;
 
 		//  
-		 void vulkanInitialize(std::vector<const char*> instanceExtensions);
+		 void vulkanInitialize(std::vector<const char*> instanceExtensions, GLFWwindow* glfwWindow);
 		 void createInstance(std::vector<const char*> instanceExtensions);
 		 void selectQueueFamily();
 		 void createLogicalDevice();
@@ -107,8 +242,88 @@ namespace Engine {
 		 void framePresent(ImGui_ImplVulkanH_Window* window);
 		 VkPhysicalDevice selectPhysicalDevice();
 
+		//  
+		 void createSwapchainRenderPass(ImGui_ImplVulkanH_Window* window, VkImageLayout finalLayout);
+		 bool recreateSwapchain(ImGui_ImplVulkanH_Window* window, int width, int height);
+		 bool updateSwapchain(int width, int height);
+		 void destroySwapchain(ImGui_ImplVulkanH_Window* window);
+		 void reportSwapchainStats();
+
+		//  
+		 bool setPresentMode(VkPresentModeKHR mode);
+		 void paceFrame();
+		 void pollEvents(); //    ,  idleSkipping   -  
+		 bool frameChanged(ImGui_ImplVulkanH_Window* window, ImDrawData* drawData); // false -    
+		 void collectPresentLatency();
+		 void reportPacingStats();
+
+		// 
+		 uint32_t runSimulation();
+		 void reportSimulationStats();
+
+		//  
+		 void createOffscreenTarget(ImGui_ImplVulkanH_Window* window, int width, int height);
+		 void destroyOffscreenTarget(ImGui_ImplVulkanH_Window* window);
+		 void recordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+		 void collectReadback(uint32_t imageIndex);
+		 bool writeFramePPM(const std::string& path, const uint8_t* rgba, int width, int height);
+		 void reportHeadlessStats();
+
+		// 
+		 DeviceQueue& getQueue(QueueType type) { return queues.get(type); }
+		 VkResult submit(QueueType type, uint32_t submitCount, const VkSubmitInfo* submits, VkFence fence);
+
+		//   
+		 void createFrameContexts();
+		 void destroyFrameContexts();
+		 void createPresentSemaphores(uint32_t imageCount);
+		 void destroyPresentSemaphores();
+		 void* allocateTransient(VkDeviceSize size, VkDeviceSize alignment, VkBuffer* buffer, VkDeviceSize* offset);
+		 void recordImgui(FrameContext& frame, ImGui_ImplVulkanH_Window* window, ImDrawData* drawData); //    ImGui 
+		 void accumulateImguiStats(const ImGui_ImplVulkan_RenderStats& stats);
+		 void reportFrameStats();
+
+		//  
+		 void createPipelineCache();
+		 void savePipelineCache();
+		 void destroyPipelineCache();
+		 VkPipelineCache createWorkerPipelineCache();
+		 void mergeWorkerPipelineCaches();
+		 void reportStartupTimings();
+
+		//  
+		 void reportMemoryStats();
+		 void drawMemoryWindow(bool* open);
+		 bool writeMemoryReport(const std::string& path);
+		static bool imguiAllocateMemory(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags properties, ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData);
+		static void imguiFreeMemory(ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData);
+
+		//  
+		 uint64_t retireValue() const;
+		 void reportDeletionStats();
+		static void imguiReleaseBuffer(VkBuffer buffer, ImGui_ImplVulkan_MemoryAllocation* allocation, void* userData);
+
+		//  
+		static bool imguiUploadTexture(VkImage image, uint32_t width, uint32_t height, const void* pixels, size_t size, void* userData);
+
+		// 
+		 bool runBenchmark(const std::string& name);
+		 void benchmarkImguiUpload();
+		 void benchmarkImguiParallel();
+		 void benchmarkImguiThumbnails();
+		 void benchmarkImguiCache();
+		 void benchmarkResizeStorm();
+		 void benchmarkJobs();
+		 void benchmarkProfiler();
+		 void benchmarkLogging();
+		 void benchmarkBinaryLog();
+		 void benchmarkWorld();
+		 void benchmarkTransforms();
+		 void benchmarkHostMemory();
+
 		//  
 		 bool isExtensionAvailable(const std::vector<VkExtensionProperties>& properties, const char* extension);
+		 uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties);
 		 void callback(int level, const char* description);
 		static void checkVkResult(VkResult error);
 
@@ -116,7 +331,7 @@ namespace Engine {
 		*  
 		*/
 
-		GLFWwindow* window;
+		GLFWwindow* window = nullptr;
 		const char* m_title = "Engine";
 		const int m_width = 800;
 		const int m_height = 600;
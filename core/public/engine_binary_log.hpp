@@ -0,0 +1,208 @@
+#ifndef ENGINE_BINARY_LOG
+#define ENGINE_BINARY_LOG
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Engine {
+	/*
+	*    ,    tools/binlog_decode.
+	* : ,   { ,  }  .      ( Formats),
+	*  -  id , ,     
+	*/
+	namespace BinaryLogFormat {
+		constexpr char Magic[8] = { 'E', 'B', 'L', 'O', 'G', '\0', '\0', '1' };
+
+		struct FileHeader {
+			char magic[8];
+			int64_t wallClock; //    system_clock  ,     0
+		};
+
+		enum BlockType : uint32_t {
+			Formats = 1, // FormatRecord 
+			Events = 2, // EventHeader +  ,     8 
+		};
+
+		struct BlockHeader {
+			uint32_t type;
+			uint32_t size; //    
+		};
+
+		/*
+		*  FormatRecord    : , ,  , 
+		*/
+		struct FormatRecord {
+			uint32_t id;
+			int32_t level; // spdlog::level
+			uint32_t line;
+			uint16_t channelLength;
+			uint16_t formatLength;
+			uint16_t typesLength;
+			uint16_t fileLength;
+		};
+
+		struct EventHeader {
+			uint32_t format;
+			uint16_t thread;
+			uint16_t size; //  
+			int64_t time; //   initialize
+		};
+
+		constexpr uint32_t Padding = UINT32_MAX; //   :     
+		constexpr size_t MaxString = 1024; //   
+
+		constexpr size_t align(size_t size) { return (size + 7) & ~(size_t)7; }
+	}
+
+	/*
+	*    : i - int64, u - uint64, b - bool, f - double, c -  (  8 ), s -  (uint16  + )
+	*/
+	template<typename T>
+	constexpr char binaryArgType() {
+		using U = std::remove_cv_t<std::remove_reference_t<T>>;
+		if constexpr (std::is_same_v<U, bool>) {
+			return 'b';
+		}
+		else if constexpr (std::is_same_v<U, char>) {
+			return 'c';
+		}
+		else if constexpr (std::is_enum_v<U>) {
+			return 'i';
+		}
+		else if constexpr (std::is_floating_point_v<U>) {
+			return 'f';
+		}
+		else if constexpr (std::is_integral_v<U>) {
+			return std::is_signed_v<U> ? 'i' : 'u';
+		}
+		else if constexpr (std::is_array_v<U> || std::is_same_v<U, const char*> || std::is_same_v<U, char*> || std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+			return 's';
+		}
+		else {
+			static_assert(std::is_pointer_v<U>, "binary log supports numbers, enums, characters and strings");
+			return 'u';
+		}
+	}
+
+	template<typename T>
+	inline std::string_view binaryArgString(const T& value) {
+		if constexpr (std::is_array_v<T>) {
+			return std::string_view(value, strnlen(value, sizeof(value)));
+		}
+		else if constexpr (std::is_pointer_v<T>) {
+			return value != nullptr ? std::string_view(value) : std::string_view("(null)");
+		}
+		else {
+			return std::string_view(value);
+		}
+	}
+
+	template<typename T>
+	inline size_t binaryArgSize(const T& value) {
+		if constexpr (binaryArgType<T>() == 's') {
+			return sizeof(uint16_t) + std::min(binaryArgString(value).size(), BinaryLogFormat::MaxString);
+		}
+		else {
+			return sizeof(uint64_t);
+		}
+	}
+
+	template<typename T>
+	inline uint8_t* binaryArgWrite(uint8_t* out, const T& value) {
+		constexpr char type = binaryArgType<T>();
+		if constexpr (type == 's') {
+			const std::string_view text = binaryArgString(value);
+			const uint16_t length = (uint16_t)std::min(text.size(), BinaryLogFormat::MaxString);
+			memcpy(out, &length, sizeof(length));
+			memcpy(out + sizeof(length), text.data(), length);
+			return out + sizeof(length) + length;
+		}
+		else if constexpr (type == 'f') {
+			const double number = (double)value;
+			memcpy(out, &number, sizeof(number));
+		}
+		else if constexpr (type == 'i' || type == 'c') {
+			const int64_t number = (int64_t)value;
+			memcpy(out, &number, sizeof(number));
+		}
+		else {
+			const uint64_t number = (uint64_t)value;
+			memcpy(out, &number, sizeof(number));
+		}
+		return out + sizeof(uint64_t);
+	}
+
+	/*
+	*     .
+	*         : id ,    ,  .
+	*           .
+	*       N         .
+	*  :    ( -  ,   )   
+	*/
+	class BinaryLog {
+	public:
+		struct Settings {
+			std::string path; //  -    ,  
+			int level = 1; // spdlog::level,   debug
+			double flightRecorderSeconds = 0.0; // 0 -  
+			std::string flightRecorderPath = "flight_recorder.blog";
+			size_t flightRecorderLimit = 64u << 20; // ,       N 
+			size_t threadBufferSize = 1u << 20; //    
+			size_t writeSize = 4u << 20; //      ,    
+			uint32_t flushIntervalMs = 10; //      
+		};
+
+		struct Stats {
+			uint64_t events = 0;
+			uint64_t dropped = 0; //   
+			uint64_t bytesWritten = 0;
+			size_t flightRecorderBytes = 0;
+		};
+
+		static bool initialize(const Settings& settings);
+		static void shutdown(); //    
+		static bool isRunning();
+
+		static bool enabled(int level) { return level >= s_level.load(std::memory_order_relaxed); }
+		static void setLevel(int level);
+		static Stats stats();
+
+		static bool dumpFlightRecorder(); //    Settings::flightRecorderPath
+		static void crash(); //   :  ,    ,  
+
+		/*
+		* Site - ,   . Ÿ     ,     
+		*/
+		template<typename Site, typename... Args>
+		static void write(uint8_t channel, int level, const char* file, uint32_t line, Site site, const Args&... args) {
+			static const uint32_t format = registerFormat(channel, level, site(), argTypes<Args...>(), file, line);
+			const size_t size = (size_t(0) + ... + binaryArgSize(args));
+			uint8_t* out = begin(format, size);
+			if (out == nullptr) {
+				return;
+			}
+			((out = binaryArgWrite(out, args)), ...);
+			commit();
+		}
+
+	private:
+		template<typename... Args>
+		static const char* argTypes() {
+			static constexpr char types[] = { binaryArgType<Args>()..., '\0' };
+			return types;
+		}
+
+		static uint32_t registerFormat(uint8_t channel, int level, const char* format, const char* types, const char* file, uint32_t line);
+		static uint8_t* begin(uint32_t format, size_t size);
+		static void commit();
+
+		static std::atomic<int> s_level;
+	};
+}
+
+#endif // ENGINE_BINARY_LOG
@@ -0,0 +1,84 @@
+#ifndef ENGINE_DELETION
+#define ENGINE_DELETION
+
+#include <vulkan/vulkan.h>
+
+#include "../core/public/engine_memory.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace Engine {
+	enum class RetiredType : uint32_t {
+		Buffer,
+		Image,
+		ImageView,
+		Sampler,
+		Pipeline,
+		PipelineLayout,
+		DescriptorSet,
+		Framebuffer,
+		RenderPass,
+		Swapchain,
+		Semaphore,
+		Memory, //  DeviceAllocator  
+		DeviceMemory // VkDeviceMemory,  
+	};
+
+	/*
+	* ,  .
+	* value -   (timeline  ),      
+	*/
+	struct RetiredResource {
+		RetiredType type = RetiredType::Buffer;
+		uint64_t handle = 0; //  non-dispatchable handle
+		VkDescriptorPool pool = VK_NULL_HANDLE; //  DescriptorSet
+		MemoryAllocation memory; //  ,    
+		VkDeviceSize bytes = 0;
+		uint64_t value = 0;
+	};
+
+	struct DeletionStats {
+		uint64_t pendingCount = 0;
+		VkDeviceSize pendingBytes = 0;
+		VkDeviceSize peakPendingBytes = 0;
+		uint64_t destroyedCount = 0;
+		VkDeviceSize destroyedBytes = 0;
+	};
+
+	/*
+	*   :   ,  GPU     ,
+	*  vkDeviceWaitIdle     ,    GPU
+	*/
+	class DeletionQueue {
+	public:
+		void initialize(VkDevice device, const VkAllocationCallbacks* allocator, DeviceAllocator* memoryAllocator);
+
+		void retire(const RetiredResource& resource);
+		void retireBuffer(VkBuffer buffer, const MemoryAllocation& memory, uint64_t value);
+		void retireImage(VkImage image, const MemoryAllocation& memory, uint64_t value);
+		void retireHandle(RetiredType type, uint64_t handle, uint64_t value);
+		void retireDescriptorSet(VkDescriptorPool pool, VkDescriptorSet set, uint64_t value);
+
+		//  ,     completedValue
+		void collect(uint64_t completedValue);
+		//   ,   
+		void flush();
+
+		DeletionStats stats();
+
+	private:
+		void destroy(RetiredResource& resource);
+
+		VkDevice m_device = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* m_allocator = nullptr;
+		DeviceAllocator* m_memoryAllocator = nullptr;
+
+		std::mutex m_lock;
+		std::deque<RetiredResource> m_pending; //   value
+		DeletionStats m_stats;
+	};
+}
+
+#endif // ENGINE_DELETION
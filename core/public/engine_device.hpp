@@ -0,0 +1,55 @@
+#ifndef ENGINE_DEVICE
+#define ENGINE_DEVICE
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace Engine {
+	/*
+	*    .
+	*        ,    
+	*/
+	struct DeviceRequirements {
+		uint32_t minApiVersion = VK_API_VERSION_1_0;
+		std::vector<const char*> requiredExtensions;
+		std::vector<const char*> optionalExtensions; // ,  
+		VkPhysicalDeviceFeatures requiredFeatures{}; // VK_TRUE -  
+		bool requireTimelineSemaphore = false;
+		bool requirePresent = true; //       
+		VkDeviceSize minDeviceLocalMemory = 0;
+		uint32_t minImageDimension2D = 0;
+		uint32_t minBoundDescriptorSets = 0;
+	};
+
+	/*
+	*    
+	*/
+	struct DeviceCandidate {
+		VkPhysicalDevice device = VK_NULL_HANDLE;
+		VkPhysicalDeviceProperties properties{};
+		uint32_t apiVersion = 0; //      :     
+		int64_t score = 0;
+		std::vector<std::string> rejections; //  -  
+		std::vector<const char*> extensions; //     
+
+		VkDeviceSize deviceLocalMemory = 0; //   device local 
+		uint32_t subgroupSize = 0; // 0,    Vulkan 1.1
+		bool timestamps = false; //     
+		bool timelineSemaphore = false;
+		bool bindless = false; //   1.2  multi draw indirect  bindless  ImGui
+		uint32_t maxBindlessTextures = 0; //   sampled image  update after bind
+		bool presentWait = false; // VK_KHR_present_id  VK_KHR_present_wait   
+		bool dedicatedCompute = false;
+		bool dedicatedTransfer = false;
+
+		bool suitable() const { return rejections.empty(); }
+	};
+
+	//  , surface   VK_NULL_HANDLE ( )
+	DeviceCandidate evaluateDevice(VkPhysicalDevice device, VkSurfaceKHR surface, const DeviceRequirements& requirements, uint32_t instanceApiVersion);
+}
+
+#endif // ENGINE_DEVICE
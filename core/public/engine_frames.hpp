@@ -0,0 +1,86 @@
+#ifndef ENGINE_FRAMES
+#define ENGINE_FRAMES
+
+#include <vulkan/vulkan.h>
+
+#include "../core/public/engine_memory.hpp"
+
+#include <cstdint>
+#include <chrono>
+#include <vector>
+
+namespace Engine {
+	/*
+	*  : fence     ,   timeline   .
+	*   Timeline CPU     vkWaitSemaphores, fence     
+	*/
+	enum class FrameSyncMode {
+		Fences,
+		Timeline
+	};
+
+	/*
+	*    " ".
+	*          :
+	*  GPU   N, CPU    N + 1     
+	*/
+	struct FrameContext {
+		VkCommandPool commandPool = VK_NULL_HANDLE; //    ,  
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE; // ,  GPU   
+		uint64_t timelineValue = 0; //  timeline     ( Timeline)
+		VkSemaphore imageAcquiredSemaphore = VK_NULL_HANDLE;
+		uint32_t imageIndex = 0; //   ,    
+
+		//    ( ),    fence
+		VkBuffer transientBuffer = VK_NULL_HANDLE;
+		MemoryAllocation transientMemory; //   DeviceAllocator,  
+		VkDeviceSize transientSize = 0;
+		VkDeviceSize transientOffset = 0;
+		uint8_t* transientMapped = nullptr;
+
+		//     ImGui,    .
+		//     :        
+		std::vector<VkCommandPool> secondaryPools;
+		std::vector<VkCommandBuffer> secondaryBuffers;
+	};
+
+	/*
+	*   ,       
+	*/
+	struct FrameStats {
+		using Clock = std::chrono::steady_clock;
+
+		Clock::time_point lastFrame{};
+		Clock::time_point lastReport{};
+		uint64_t frames = 0;
+		double frameTimeSum = 0.0; // ,    frameRender
+		double frameTimeMin = 0.0;
+		double frameTimeMax = 0.0;
+		double fenceWaitSum = 0.0; // ,   CPU  fence 
+		double recordSum = 0.0; // ,    
+		double imguiSum = 0.0; // ,      ImGui
+		uint64_t imguiParallelFrames = 0; // ,    
+		uint64_t imguiSecondaryBuffers = 0;
+		uint64_t imguiCommands = 0; //  ImDrawCmd   vkCmdDrawIndexed  
+		uint64_t imguiDrawCalls = 0;
+		uint64_t imguiStateChanges = 0; // vkCmdSetScissor  vkCmdBindDescriptorSets
+		uint64_t imguiStateSkipped = 0;
+
+		double averageFrameTime() const { return frames ? frameTimeSum / frames : 0.0; }
+		double averageFenceWait() const { return frames ? fenceWaitSum / frames : 0.0; }
+		double averageRecord() const { return frames ? recordSum / frames : 0.0; }
+		double averageImgui() const { return frames ? imguiSum / frames : 0.0; }
+
+		void reset(Clock::time_point now) {
+			lastReport = now;
+			frames = 0;
+			frameTimeSum = frameTimeMin = frameTimeMax = 0.0;
+			fenceWaitSum = recordSum = imguiSum = 0.0;
+			imguiParallelFrames = imguiSecondaryBuffers = 0;
+			imguiCommands = imguiDrawCalls = imguiStateChanges = imguiStateSkipped = 0;
+		}
+	};
+}
+
+#endif // ENGINE_FRAMES
@@ -0,0 +1,110 @@
+#ifndef ENGINE_HOST_MEMORY
+#define ENGINE_HOST_MEMORY
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+	constexpr uint32_t HostScopeCount = 5; // VkSystemAllocationScope: COMMAND, OBJECT, CACHE, DEVICE, INSTANCE
+
+	const char* allocationScopeName(uint32_t scope);
+
+	struct HostScopeStats {
+		uint64_t allocations = 0; //  pfnAllocation  pfnReallocation   
+		uint64_t reallocations = 0;
+		uint64_t frees = 0;
+		uint64_t liveAllocations = 0;
+		uint64_t liveBytes = 0;
+		uint64_t peakBytes = 0; //    
+		uint64_t internalBytes = 0; //  ,    (pfnInternalAllocation)
+		uint64_t internalPeakBytes = 0;
+	};
+
+	struct HostMemoryStats {
+		HostScopeStats scopes[HostScopeCount];
+		uint64_t liveBytes = 0; //    
+		uint64_t peakBytes = 0;
+		uint64_t arenaAllocations = 0; //     
+		uint64_t arenaFallbacks = 0; //    ,   
+		uint32_t arenas = 0;
+		uint64_t arenaBytes = 0; //   
+	};
+
+	/*
+	*      VkAllocationCallbacks.      :
+	*           ,      (scope)  .
+	*   COMMAND      vk* ,       :
+	*  ,       
+	*/
+	class HostAllocator {
+	public:
+		static constexpr size_t ArenaSize = 64 * 1024;
+		static constexpr size_t ArenaMaxAllocation = 4 * 1024; //  -   
+
+		HostAllocator();
+		~HostAllocator();
+
+		HostAllocator(HostAllocator const&) = delete;
+		void operator=(HostAllocator const&) = delete;
+
+		const VkAllocationCallbacks* callbacks() const { return &m_callbacks; }
+		void setArenas(bool enabled) { m_arenasEnabled = enabled; } //   
+
+		HostMemoryStats stats() const;
+		void reportStats();
+
+	private:
+		struct Header; //    
+
+		//      (load + store), atomic ,  stats    
+		struct ThreadState {
+			std::thread::id thread;
+			std::atomic<uint64_t> allocations[HostScopeCount] = {};
+			std::atomic<uint64_t> reallocations[HostScopeCount] = {};
+			std::atomic<uint64_t> frees[HostScopeCount] = {}; //   ,    
+			std::atomic<uint64_t> arenaAllocations{ 0 };
+			std::atomic<uint64_t> arenaFallbacks{ 0 };
+
+			uint8_t* arena = nullptr; //      COMMAND
+			size_t arenaOffset = 0; //   -
+			std::atomic<uint32_t> arenaLive{ 0 }; //    
+		};
+
+		struct ScopeCounters {
+			std::atomic<uint64_t> liveBytes{ 0 };
+			std::atomic<uint64_t> peakBytes{ 0 };
+			std::atomic<uint64_t> internalBytes{ 0 };
+			std::atomic<uint64_t> internalPeakBytes{ 0 };
+		};
+
+		static void* VKAPI_CALL allocation(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+		static void* VKAPI_CALL reallocation(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+		static void VKAPI_CALL free(void* userData, void* memory);
+		static void VKAPI_CALL internalAllocation(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+		static void VKAPI_CALL internalFree(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+		void* allocate(size_t size, size_t alignment, uint32_t scope);
+		void release(void* memory);
+		ThreadState* threadState(); //   
+		void track(uint32_t scope, uint64_t size);
+		void untrack(uint32_t scope, uint64_t size);
+
+		VkAllocationCallbacks m_callbacks{};
+		bool m_arenasEnabled = true;
+		ScopeCounters m_scopes[HostScopeCount];
+		std::atomic<uint64_t> m_liveBytes{ 0 };
+		std::atomic<uint64_t> m_peakBytes{ 0 };
+
+		mutable std::mutex m_threadsLock;
+		std::vector<std::unique_ptr<ThreadState>> m_threads;
+		uint64_t m_id; //     ,    
+	};
+}
+
+#endif // ENGINE_HOST_MEMORY
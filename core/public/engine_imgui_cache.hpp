@@ -0,0 +1,97 @@
+#ifndef ENGINE_IMGUI_CACHE
+#define ENGINE_IMGUI_CACHE
+
+#include "../core/imgui/imgui.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+	struct ImGuiCacheStats {
+		uint64_t recorded = 0; // ,     
+		uint64_t replayed = 0; // ,     
+		uint64_t uncacheable = 0; //  , ,  Begin  
+		uint64_t replayedVertices = 0;
+		size_t cachedBytes = 0; // ,       
+	};
+
+	/*
+	*     ImGui. ,     , , ,  
+	*     ,        ,   :
+	*  ,            ImGui::Begin.
+	* ,       Begin  ,   .
+	*       (BeginChild, Begin):     ,    .
+	*      version (, ),  invalidate  setMaxAge
+	*/
+	class ImGuiWindowCache {
+	public:
+		/*
+		*  ImGui::Begin. true -   , false -      .
+		* end  ,  ImGui::End
+		*/
+		bool begin(const char* name, uint64_t version = 0, bool* open = nullptr, ImGuiWindowFlags flags = 0);
+		void end();
+
+		void invalidate(const char* name); //   ,     
+		void invalidateAll(); //     
+		void setEnabled(bool enabled); //   -  ImGui::Begin/End
+		bool enabled() const { return m_enabled; }
+		void setMaxAge(uint32_t frames) { m_maxAge = frames; } //      frames , 0 -   
+
+		ImGuiCacheStats stats() const;
+		void resetStats();
+
+	private:
+		// ,     ,   
+		struct Key {
+			ImVec2 position;
+			ImVec2 size;
+			ImVec2 scroll;
+			ImVec2 displaySize;
+			float fontSize = 0.0f;
+			ImGuiWindowFlags flags = 0;
+			uint64_t version = 0;
+			bool focused = false;
+			//   Begin: ,    Begin,    
+			int prefixVertices = 0;
+			int prefixIndices = 0;
+			int prefixCommands = 0;
+			ImDrawCmdHeader prefixHeader{};
+
+			bool operator==(const Key& other) const;
+		};
+
+		struct Entry {
+			Key key;
+			bool valid = false;
+			int recordedFrame = 0;
+			std::vector<ImDrawVert> vertices; //    Begin
+			std::vector<ImDrawIdx> indices;
+			std::vector<ImDrawCmd> commands; //     Begin,   
+			unsigned int vertexCurrentIndex = 0;
+			ImDrawCmdHeader header{};
+			//  ,   :   Begin     
+			ImVec2 cursorPosition;
+			ImVec2 cursorMaxPosition;
+			ImVec2 idealMaxPosition;
+			short navLayers = 0;
+		};
+
+		struct Scope {
+			Entry* recording = nullptr; // nullptr -     
+			Key key;
+		};
+
+		void replay(Entry& entry);
+		void record(Entry& entry, const Key& key);
+
+		std::unordered_map<ImGuiID, Entry> m_entries;
+		std::vector<Scope> m_stack; //  begin/end
+		bool m_enabled = false;
+		uint32_t m_maxAge = 0;
+		ImGuiCacheStats m_stats;
+	};
+}
+
+#endif // ENGINE_IMGUI_CACHE
@@ -0,0 +1,126 @@
+#ifndef ENGINE_JOBS
+#define ENGINE_JOBS
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+namespace Engine {
+	using JobFunction = std::function<void()>;
+
+	/*
+	*   . schedule  ,   ,
+	* wait      ,  
+	*/
+	struct JobCounter {
+		std::atomic<uint32_t> pending{ 0 };
+
+		bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	struct JobStats {
+		uint64_t executed = 0;
+		uint64_t stolen = 0; //    
+		uint64_t mainThread = 0; //     
+	};
+
+	/*
+	*     :     ,      (LIFO,  ),
+	*       .  0   ,    ,  
+	*/
+	class JobSystem {
+	public:
+		// workerCount -   , UINT32_MAX -   
+		void initialize(uint32_t workerCount = UINT32_MAX);
+		void shutdown();
+
+		void schedule(JobFunction function, JobCounter* counter = nullptr);
+		//       (GLFW, ImGui,      )
+		void scheduleMainThread(JobFunction function, JobCounter* counter = nullptr);
+		void wait(JobCounter& counter);
+		void runMainThreadJobs();
+
+		/*
+		*  [0, count)    grain   function(begin, end)   ,    .
+		* grain 0 -     
+		*/
+		void parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t begin, uint32_t end)>& function);
+
+		uint32_t threadCount() const { return m_queueCount; } //   
+		bool isInitialized() const { return m_queueCount != 0; }
+		JobStats stats();
+		void reportStats();
+
+	private:
+		struct Job {
+			JobFunction function;
+			JobCounter* counter = nullptr;
+		};
+
+		struct alignas(64) WorkQueue {
+			std::mutex lock;
+			std::deque<Job> jobs;
+		};
+
+		void workerLoop(uint32_t index);
+		bool findJob(uint32_t index, Job& job);
+		bool popMainThread(Job& job);
+		void execute(Job& job);
+		void wake();
+
+		std::unique_ptr<WorkQueue[]> m_queues;
+		uint32_t m_queueCount = 0;
+		std::vector<std::thread> m_workers;
+		std::thread::id m_mainThread;
+
+		std::mutex m_mainLock;
+		std::deque<Job> m_mainJobs;
+
+		//  : m_queued  m_sleeping   ,    
+		std::mutex m_sleepLock;
+		std::condition_variable m_wake;
+		std::atomic<uint32_t> m_queued{ 0 };
+		std::atomic<uint32_t> m_sleeping{ 0 };
+		std::atomic<bool> m_running{ false };
+
+		std::atomic<uint64_t> m_executed{ 0 };
+		std::atomic<uint64_t> m_stolen{ 0 };
+		std::atomic<uint64_t> m_mainExecuted{ 0 };
+	};
+
+	/*
+	*    .    ,    ,    ,
+	*    .     ,   
+	*/
+	class JobGraph {
+	public:
+		uint32_t add(JobFunction function, bool mainThread = false);
+		void depend(uint32_t node, uint32_t dependency); // node   dependency
+		bool run(JobSystem& jobs); // false,    
+		void clear();
+
+		size_t size() const { return m_nodes.size(); }
+
+	private:
+		struct Node {
+			JobFunction function;
+			bool mainThread = false;
+			std::vector<uint32_t> successors;
+			uint32_t dependencies = 0;
+			std::atomic<uint32_t> remaining{ 0 };
+		};
+
+		void submit(JobSystem& jobs, uint32_t index);
+
+		std::deque<Node> m_nodes; // deque:   atomic  
+		JobCounter m_counter;
+	};
+}
+
+#endif // ENGINE_JOBS
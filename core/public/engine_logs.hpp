@@ -3,27 +3,92 @@
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../core/public/engine_binary_log.hpp"
+
 namespace Engine {
-#ifdef NDEBUG
+	/*
+	*  .    ,    (--log=jobs=debug,device=warn   )
+	*/
+	enum class LogChannel : uint8_t {
+		Core,
+		Vulkan,
+		Device,
+		Memory,
+		Frames,
+		Swapchain,
+		Upload,
+		Jobs,
+		Profiler,
+		World,
+		Count
+	};
 
-	/*   != ,      */
+	const char* logChannelName(LogChannel channel);
 
-#define LOG_INFO
-#define LOG_WARNING
-#define LOG_ERROR
-#define LOG_CRITICAL
+	/*
+	*   spdlog::async_logger.
+	*      ,      .
+	*           ( 250    )
+	*       ,       spdlog
+	*/
+	class Log {
+	public:
+		struct Settings {
+			bool async = true; // false -  , ,   
+			size_t queueSize = 8192; //   ,     ,    
+			std::string file; //  -  
+		};
 
-#else
+		static void initialize(const Settings& settings);
+		static void shutdown(); //  .       spdlog  
 
-	/*   == ,      */
+		static bool enabled(LogChannel channel, spdlog::level::level_enum level) { return (int)level >= s_levels[(size_t)channel].load(std::memory_order_relaxed); }
+		static spdlog::level::level_enum level(LogChannel channel) { return (spdlog::level::level_enum)s_levels[(size_t)channel].load(std::memory_order_relaxed); }
+		static void setLevel(LogChannel channel, spdlog::level::level_enum level);
+		static void setLevel(spdlog::level::level_enum level); //  
+		static bool configure(const std::string& spec); // "info", "jobs=debug,device=warn",    -  
+		static uint64_t dropped(); //    
 
-#define LOG_INFO spdlog::info //   
-#define LOG_WARNING spdlog::warn //  
-#define LOG_ERROR spdlog::error //  
-#define LOG_CRITICAL spdlog::critical //   
-#define RUNTIME_ERROR std::runtime_error("")
+		template<typename... Args>
+		static void write(LogChannel channel, spdlog::level::level_enum level, spdlog::format_string_t<Args...> format, Args&&... args) {
+			spdlog::logger* logger = s_loggers[(size_t)channel].get();
+			if (logger == nullptr) {
+				logger = spdlog::default_logger_raw(); //  initialize   shutdown
+			}
+			logger->log(level, format, std::forward<Args>(args)...);
+		}
 
-#endif // NDEBUG
+	private:
+		static std::atomic<int> s_levels[(size_t)LogChannel::Count]; //  initialize 0 (trace):   
+		static std::shared_ptr<spdlog::logger> s_loggers[(size_t)LogChannel::Count];
+		static std::shared_ptr<spdlog::details::thread_pool> s_threadPool;
+	};
 }
 
-#endif // ENGINE_LOGS
\ No newline at end of file
+/*
+* LOG_INFO(Jobs, "{} worker threads", count).     .
+*      :       (--log=off),   
+*/
+#define ENGINE_LOG(channel, level, format, ...) \
+	do { \
+		if (::Engine::Log::enabled(channel, level)) { \
+			::Engine::Log::write(channel, level, FMT_STRING(format), ##__VA_ARGS__); \
+		} \
+		if (::Engine::BinaryLog::enabled((int)(level))) { \
+			::Engine::BinaryLog::write((uint8_t)(channel), (int)(level), __FILE__, __LINE__, [] { return format; }, ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+#define LOG_DEBUG(channel, format, ...) ENGINE_LOG(::Engine::LogChannel::channel, spdlog::level::debug, format, ##__VA_ARGS__) //    
+#define LOG_INFO(channel, format, ...) ENGINE_LOG(::Engine::LogChannel::channel, spdlog::level::info, format, ##__VA_ARGS__) //   
+#define LOG_WARNING(channel, format, ...) ENGINE_LOG(::Engine::LogChannel::channel, spdlog::level::warn, format, ##__VA_ARGS__) //  
+#define LOG_ERROR(channel, format, ...) ENGINE_LOG(::Engine::LogChannel::channel, spdlog::level::err, format, ##__VA_ARGS__) //  
+#define LOG_CRITICAL(channel, format, ...) ENGINE_LOG(::Engine::LogChannel::channel, spdlog::level::critical, format, ##__VA_ARGS__) //   
+#define RUNTIME_ERROR std::runtime_error("")
+
+#endif // ENGINE_LOGS
@@ -0,0 +1,132 @@
+#ifndef ENGINE_MEMORY
+#define ENGINE_MEMORY
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <unordered_map>
+
+namespace Engine {
+	/*
+	*   ,  .
+	*  host visible  mapped      (     )
+	*/
+	struct MemoryAllocation {
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		uint8_t* mapped = nullptr;
+		VkMemoryPropertyFlags propertyFlags = 0;
+		uint32_t memoryType = UINT32_MAX;
+		uint32_t block = UINT32_MAX; // UINT32_MAX -  (dedicated) 
+		uint32_t order = 0; //  buddy ,   = 1 << order
+	};
+
+	/*
+	*   :     from  to   .
+	*    from 
+	*/
+	using DefragmentCallback = void(*)(const MemoryAllocation& from, const MemoryAllocation& to, void* userData);
+
+	struct MemoryStats {
+		uint32_t blockCount = 0;
+		uint32_t dedicatedCount = 0;
+		uint64_t allocationCount = 0; //  
+		VkDeviceSize reservedBytes = 0; //   
+		VkDeviceSize usedBytes = 0; //   (   buddy )
+		double fragmentation = 0.0; // 1 -    /   , 0 -  
+		double averageAllocateNs = 0.0;
+		double maxAllocateNs = 0.0;
+	};
+
+	/*
+	*    .  VK_EXT_memory_budget budget  usage   (   ),
+	*   budget -  , usage -  ,   
+	*/
+	struct MemoryHeapBudget {
+		VkDeviceSize size = 0;
+		VkDeviceSize budget = 0;
+		VkDeviceSize usage = 0;
+		VkDeviceSize allocated = 0; //      
+		VkMemoryHeapFlags flags = 0;
+	};
+
+	struct MemoryBudget {
+		std::vector<MemoryHeapBudget> heaps;
+		bool fromExtension = false;
+	};
+
+	/*
+	*   :        buddy   .
+	*   (  )   vkAllocateMemory
+	*/
+	class DeviceAllocator {
+	public:
+		void initialize(VkPhysicalDevice physicalDevice, VkDevice device, const VkAllocationCallbacks* allocator, bool budgetExtension = false, VkDeviceSize blockSize = 32ull * 1024 * 1024);
+		void shutdown();
+
+		// preferred -   ( HOST_COHERENT),     
+		bool allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, MemoryAllocation& allocation);
+		void free(MemoryAllocation& allocation);
+
+		// : allocation     ,  
+		void registerMovable(MemoryAllocation* allocation, DefragmentCallback callback, void* userData);
+		void unregisterMovable(MemoryAllocation* allocation);
+		uint32_t defragment(uint32_t maxMoves);
+
+		MemoryStats stats();
+		MemoryBudget budget();
+		VkDeviceSize minAllocationSize() const { return m_minAllocation; }
+		bool isInitialized() const { return m_device != VK_NULL_HANDLE; }
+
+	private:
+		struct Block {
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			uint8_t* mapped = nullptr;
+			VkDeviceSize used = 0;
+			std::vector<std::set<VkDeviceSize>> freeLists; //    
+		};
+
+		struct MemoryPool {
+			std::vector<Block> blocks; //     ,    
+			uint32_t blockOrder = 0; //   = 1 << blockOrder,    
+			VkDeviceSize dedicatedBytes = 0;
+		};
+
+		struct Movable {
+			DefragmentCallback callback;
+			void* userData;
+		};
+
+		uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) const;
+		bool allocateFromBlock(uint32_t memoryType, uint32_t blockIndex, uint32_t order, MemoryAllocation& allocation);
+		uint32_t createBlock(uint32_t memoryType); //     UINT32_MAX
+		void freeFromBlock(MemoryAllocation& allocation);
+		uint32_t orderFor(VkDeviceSize size) const;
+
+		VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+		VkDevice m_device = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* m_allocator = nullptr;
+		bool m_budgetExtension = false; // VK_EXT_memory_budget   
+		VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+		VkDeviceSize m_blockSize = 0;
+		VkDeviceSize m_minAllocation = 256;
+		uint32_t m_minOrder = 8;
+
+		std::mutex m_lock;
+		std::vector<MemoryPool> m_pools; //     
+		std::unordered_map<MemoryAllocation*, Movable> m_movable;
+
+		uint32_t m_dedicatedCount = 0;
+		VkDeviceSize m_dedicatedBytes = 0;
+		uint64_t m_allocationCount = 0;
+		uint64_t m_allocateCalls = 0;
+		double m_allocateNsSum = 0.0;
+		double m_allocateNsMax = 0.0;
+	};
+}
+
+#endif // ENGINE_MEMORY
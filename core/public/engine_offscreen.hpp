@@ -0,0 +1,37 @@
+#ifndef ENGINE_OFFSCREEN
+#define ENGINE_OFFSCREEN
+
+#include <vulkan/vulkan.h>
+
+#include "../core/public/engine_memory.hpp"
+
+#include <cstdint>
+#include <chrono>
+
+namespace Engine {
+	/*
+	*    :         host visible     .
+	*       ,  CPU  ,        
+	*/
+	struct OffscreenImage {
+		VkImage image = VK_NULL_HANDLE;
+		MemoryAllocation memory;
+		VkBuffer readbackBuffer = VK_NULL_HANDLE;
+		MemoryAllocation readbackMemory;
+		uint64_t frameNumber = 0; // ,     
+		bool readbackPending = false;
+	};
+
+	struct HeadlessStats {
+		using Clock = std::chrono::steady_clock;
+
+		Clock::time_point start{};
+		uint64_t frames = 0;
+		uint64_t readbacks = 0;
+		uint64_t dumped = 0;
+		uint64_t lastChecksum = 0; // FNV-1a    ,    
+		double readbackMsSum = 0.0; // ,  CPU    
+	};
+}
+
+#endif // ENGINE_OFFSCREEN
@@ -0,0 +1,76 @@
+#ifndef ENGINE_PACING
+#define ENGINE_PACING
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <chrono>
+
+namespace Engine {
+	const char* presentModeName(VkPresentModeKHR mode);
+	bool parsePresentMode(const char* name, VkPresentModeKHR& mode); // fifo, relaxed, mailbox, immediate
+
+	/*
+	*   :              .
+	*  ,      ,       
+	*/
+	class FramePacer {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Stats {
+			uint64_t frames = 0;
+			uint64_t missed = 0; //     
+			double sleepMs = 0.0;
+			double spinMs = 0.0;
+			double maxLateMs = 0.0; //    
+		};
+
+		~FramePacer();
+
+		void setTargetFps(double fps); // 0 -  
+		double targetFps() const { return m_period > 0.0 ? 1.0 / m_period : 0.0; }
+
+		//    ,    
+		void wait();
+
+		Stats stats() const { return m_stats; }
+		void resetStats() { m_stats = Stats{}; }
+		void resync() { m_deadline = Clock::time_point{}; } //   :   -   
+
+	private:
+		void sleepFor(double seconds);
+
+		double m_period = 0.0; // 
+		Clock::time_point m_deadline{};
+		double m_sleepOvershoot = 0.001; // ,  ,   .    
+		void* m_timer = nullptr; //    Windows
+		Stats m_stats;
+	};
+
+	/*
+	* ,  :     ,   ,   
+	*/
+	struct PresentSample {
+		uint64_t presentId = 0; // VK_KHR_present_id, 0 -  present wait
+		uint64_t frameValue = 0; //  ,    present wait    GPU
+		std::chrono::steady_clock::time_point input{};
+	};
+
+	struct IdleStats {
+		uint64_t frames = 0; //   ImGui
+		uint64_t skipped = 0; //        
+		uint64_t waits = 0; //    
+		double waitMs = 0.0;
+	};
+
+	struct LatencyStats {
+		uint64_t samples = 0;
+		double sumMs = 0.0;
+		double maxMs = 0.0;
+
+		double average() const { return samples ? sumMs / samples : 0.0; }
+	};
+}
+
+#endif // ENGINE_PACING
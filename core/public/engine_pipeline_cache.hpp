@@ -0,0 +1,47 @@
+#ifndef ENGINE_PIPELINE_CACHE
+#define ENGINE_PIPELINE_CACHE
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+namespace Engine {
+	/*
+	*    .
+	*            ,   
+	*/
+	struct PipelineCacheFileHeader {
+		uint32_t magic = 0x31435045; // "EPC1"
+		uint32_t headerSize = sizeof(PipelineCacheFileHeader);
+		uint32_t vendorID = 0;
+		uint32_t deviceID = 0;
+		uint32_t driverVersion = 0;
+		uint8_t pipelineCacheUUID[VK_UUID_SIZE]{};
+		uint64_t dataSize = 0; //   vkGetPipelineCacheData  
+		uint64_t dataHash = 0; // FNV-1a  ,      
+	};
+
+	/*
+	*   ,      
+	*/
+	struct StartupTimings {
+		bool warmPipelineCache = false; // true,        
+		size_t pipelineCacheBytes = 0;
+		double vulkanInitializeMs = 0.0;
+		double pipelineCacheLoadMs = 0.0;
+		double pipelineCreateMs = 0.0;
+	};
+
+	/*
+	*    :       ,
+	*        
+	*/
+	struct WorkerPipelineCaches {
+		std::mutex lock;
+		std::vector<VkPipelineCache> caches;
+	};
+}
+
+#endif // ENGINE_PIPELINE_CACHE
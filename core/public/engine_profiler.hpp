@@ -0,0 +1,193 @@
+#ifndef ENGINE_PROFILER_H
+#define ENGINE_PROFILER_H
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Engine {
+	/*
+	*  :  -   (   ),      
+	*/
+	struct ProfileZone {
+		const char* name = nullptr;
+		int64_t start = 0;
+		int64_t end = 0;
+		uint16_t depth = 0; //    
+		uint16_t thread = 0; //   , GpuThread -  GPU
+	};
+
+	/*
+	*    :  CPU  ,    ,   GPU,   
+	*/
+	struct ProfileFrame {
+		uint64_t number = UINT64_MAX; // UINT64_MAX -    
+		int64_t start = 0;
+		int64_t end = 0;
+		std::vector<ProfileZone> zones;
+		std::vector<ProfileZone> gpuZones;
+
+		double milliseconds() const { return (end - start) / 1e6; }
+	};
+
+	/*
+	*   .
+	*           ( ,  ),
+	*    newFrame     .        
+	*/
+	class Profiler {
+	public:
+		static constexpr uint16_t GpuThread = UINT16_MAX;
+		static constexpr uint32_t HistorySize = 240; //   
+		static constexpr uint32_t ThreadBufferSize = 1 << 14; //      newFrame,  
+
+		Profiler();
+
+		int64_t now() const;
+
+		void setThreadName(const char* name); //   ,      trace
+		void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+		bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+		//  ,    .   PROFILE_SCOPE
+		int64_t beginZone();
+		void endZone(const char* name, int64_t start);
+
+		//  ,    :      
+		void newFrame();
+		uint64_t frameNumber() const { return m_frameNumber; }
+		void addGpuZones(uint64_t frame, const std::vector<ProfileZone>& zones);
+
+		const ProfileFrame* frame(uint64_t number) const; // nullptr,      
+		const ProfileFrame* lastFrame() const { return m_frameNumber > 0 ? frame(m_frameNumber - 1) : nullptr; }
+		std::string threadName(uint16_t thread);
+		uint64_t droppedZones();
+
+		bool writeChromeTrace(const std::string& path);
+		void drawWindow(bool* open);
+
+	private:
+		struct ThreadBuffer {
+			std::unique_ptr<ProfileZone[]> zones{ new ProfileZone[ThreadBufferSize] };
+			std::atomic<uint64_t> write{ 0 };
+			std::atomic<uint64_t> read{ 0 };
+			std::atomic<uint64_t> dropped{ 0 };
+			uint16_t index = 0;
+			uint16_t depth = 0; //   -
+			std::string name;
+		};
+
+		ThreadBuffer* threadBuffer();
+
+		std::atomic<bool> m_enabled{ true };
+		int64_t m_epoch = 0;
+
+		std::mutex m_threadsLock; //      
+		std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+		std::vector<ProfileFrame> m_history;
+		uint64_t m_frameNumber = 0;
+		int64_t m_frameStart = 0;
+
+		// 
+		bool m_paused = false; //   ,     
+		uint64_t m_selectedFrame = UINT64_MAX; // UINT64_MAX -   
+	};
+
+	Profiler& profiler();
+
+	class ProfileScope {
+	public:
+		explicit ProfileScope(const char* name) : m_name(name), m_start(profiler().beginZone()) {}
+		~ProfileScope() { profiler().endZone(m_name, m_start); }
+
+		ProfileScope(ProfileScope const&) = delete;
+		void operator=(ProfileScope const&) = delete;
+
+	private:
+		const char* m_name;
+		int64_t m_start;
+	};
+
+	/*
+	*  GPU:  vkCmdWriteTimestamp       .
+	*  ,       (  fence/timeline),    vkGetQueryPoolResults
+	*/
+	class GpuProfiler {
+	public:
+		static constexpr uint32_t MaxZones = 64; //  
+
+		bool initialize(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamily, uint32_t slots, const VkAllocationCallbacks* allocator);
+		void destroy();
+		bool isEnabled() const { return !m_slots.empty(); }
+
+		//   vkBeginCommandBuffer :        
+		void beginFrame(VkCommandBuffer commandBuffer, uint32_t slot, uint64_t frameNumber);
+		uint32_t beginZone(VkCommandBuffer commandBuffer, const char* name);
+		void endZone(VkCommandBuffer commandBuffer, uint32_t zone);
+
+	private:
+		struct Zone {
+			const char* name;
+			uint32_t query; // ,  - query + 1
+			uint16_t depth;
+		};
+		struct Slot {
+			VkQueryPool pool = VK_NULL_HANDLE;
+			std::vector<Zone> zones;
+			uint64_t frameNumber = UINT64_MAX;
+			int64_t cpuStart = 0; //   ,      GPU   
+		};
+
+		void collect(Slot& slot);
+
+		VkDevice m_device = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* m_allocator = nullptr;
+		std::vector<Slot> m_slots;
+		Slot* m_current = nullptr;
+		uint16_t m_depth = 0;
+		double m_period = 1.0; //     
+		uint64_t m_mask = UINT64_MAX; // timestampValidBits
+		std::vector<uint64_t> m_results;
+		std::vector<ProfileZone> m_zones;
+	};
+
+	class GpuProfileScope {
+	public:
+		GpuProfileScope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name) : m_profiler(profiler), m_commandBuffer(commandBuffer), m_zone(profiler.beginZone(commandBuffer, name)) {}
+		~GpuProfileScope() { m_profiler.endZone(m_commandBuffer, m_zone); }
+
+		GpuProfileScope(GpuProfileScope const&) = delete;
+		void operator=(GpuProfileScope const&) = delete;
+
+	private:
+		GpuProfiler& m_profiler;
+		VkCommandBuffer m_commandBuffer;
+		uint32_t m_zone;
+	};
+}
+
+/*
+*  ENGINE_PROFILER  ,     
+*/
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENGINE_PROFILER
+#define PROFILE_SCOPE(name) ::Engine::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_GPU_SCOPE(gpuProfiler, commandBuffer, name) ::Engine::GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(gpuProfiler, commandBuffer, name)
+#define PROFILE_THREAD(name) ::Engine::profiler().setThreadName(name)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_GPU_SCOPE(gpuProfiler, commandBuffer, name)
+#define PROFILE_THREAD(name)
+#endif
+
+#endif // ENGINE_PROFILER_H
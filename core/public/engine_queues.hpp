@@ -0,0 +1,103 @@
+#ifndef ENGINE_QUEUES
+#define ENGINE_QUEUES
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+namespace Engine {
+	enum class QueueType : uint32_t {
+		Graphics = 0,
+		Compute, //  ,      
+		Transfer, // ,       transfer (DMA)
+		Present,
+		Count
+	};
+
+	const char* queueTypeName(QueueType type);
+
+	/*
+	*     CPU.
+	* busy -   vkQueueSubmit/vkQueuePresentKHR, wait -     
+	*/
+	struct QueueStats {
+		uint64_t submits = 0;
+		uint64_t commandBuffers = 0;
+		double busyMs = 0.0;
+		double waitMs = 0.0;
+	};
+
+	/*
+	*   .      VkQueue (     ),
+	*     ,   vkQueueSubmit    
+	*/
+	struct DeviceQueue {
+		VkQueue queue = VK_NULL_HANDLE;
+		uint32_t family = UINT32_MAX;
+		uint32_t index = 0;
+		bool dedicated = false; // true,     VkQueue   
+		std::mutex* lock = nullptr;
+		QueueStats stats;
+
+		// Timeline  :    submitTimeline   
+		VkSemaphore timeline = VK_NULL_HANDLE;
+		uint64_t timelineValue = 0; //   
+	};
+
+	/*
+	*   :  ,       
+	*/
+	class QueueTopology {
+	public:
+		// surface   VK_NULL_HANDLE,     
+		bool discover(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+		//  createInfos  vkCreateDevice, priorities     
+		void fillCreateInfos(std::vector<VkDeviceQueueCreateInfo>& createInfos, std::vector<float>& priorities) const;
+		// timelines -  timeline     ( Vulkan 1.2 timelineSemaphore)
+		void resolve(VkDevice device, const VkAllocationCallbacks* allocator, bool timelines);
+		void destroy();
+
+		VkResult submit(QueueType type, uint32_t submitCount, const VkSubmitInfo* submits, VkFence fence);
+		VkResult present(const VkPresentInfoKHR* presentInfo);
+		VkResult waitIdle(QueueType type);
+
+		/*
+		*      timeline  ,   .
+		* waitValues    , signals -   
+		*/
+		uint64_t submitTimeline(QueueType type, uint32_t waitCount, const VkSemaphore* waits, const uint64_t* waitValues, const VkPipelineStageFlags* waitStages,
+			uint32_t commandBufferCount, const VkCommandBuffer* commandBuffers, uint32_t signalCount = 0, const VkSemaphore* signals = nullptr);
+		uint64_t completedValue(QueueType type); // ,   GPU  
+		void waitValue(QueueType type, uint64_t value); //   CPU  ,  fence
+		bool hasTimelines() const { return m_queues[0].timeline != VK_NULL_HANDLE; }
+
+		DeviceQueue& get(QueueType type) { return m_queues[(uint32_t)type]; }
+		const DeviceQueue& get(QueueType type) const { return m_queues[(uint32_t)type]; }
+		bool hasPresent() const { return m_queues[(uint32_t)QueueType::Present].family != UINT32_MAX; }
+
+		void logTopology() const;
+		void reportStats(); //       ,   
+
+	private:
+		struct Family {
+			VkQueueFamilyProperties properties{};
+			VkBool32 present = VK_FALSE;
+			uint32_t used = 0; //      
+		};
+
+		void assign(QueueType type, uint32_t family);
+
+		std::vector<Family> m_families;
+		DeviceQueue m_queues[(uint32_t)QueueType::Count];
+		std::vector<std::unique_ptr<std::mutex>> m_locks; //     VkQueue
+		VkDevice m_device = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* m_allocator = nullptr;
+		std::chrono::steady_clock::time_point m_lastReport;
+	};
+}
+
+#endif // ENGINE_QUEUES
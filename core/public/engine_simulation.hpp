@@ -0,0 +1,57 @@
+#ifndef ENGINE_SIMULATION
+#define ENGINE_SIMULATION
+
+#include <cstdint>
+#include <chrono>
+
+namespace Engine {
+	/*
+	*     .
+	*         ,   alpha    .
+	*     (ticksPerFrame > 0)  :    ticksPerFrame ,     
+	*/
+	class SimulationClock {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Stats {
+			uint64_t ticks = 0;
+			uint64_t frames = 0;
+			uint64_t clampedFrames = 0; //   maxFrameTime (,  )
+			uint64_t budgetHits = 0; //    maxTicksPerFrame,   
+			double droppedSeconds = 0.0; //      
+		};
+
+		void configure(double tickRate, uint32_t maxTicksPerFrame, double maxFrameTime, uint32_t ticksPerFrame);
+		void reset(Clock::time_point now);
+
+		//      ,     firstTick()
+		uint32_t advance(Clock::time_point now);
+
+		uint64_t firstTick() const { return m_tick - m_pendingTicks; }
+		uint64_t tick() const { return m_tick; } //     
+		double alpha() const { return m_alpha; } // 0..1     
+		double tickSeconds() const { return m_tickSeconds; }
+		double tickRate() const { return 1.0 / m_tickSeconds; }
+		bool isVirtual() const { return m_ticksPerFrame != 0; }
+		uint32_t ticksPerFrame() const { return m_ticksPerFrame; }
+
+		Stats stats() const { return m_stats; }
+		void resetStats() { m_stats = Stats{}; }
+
+	private:
+		double m_tickSeconds = 1.0 / 60.0;
+		uint32_t m_maxTicksPerFrame = 8;
+		double m_maxFrameTime = 0.25;
+		uint32_t m_ticksPerFrame = 0;
+
+		Clock::time_point m_last{};
+		double m_accumulator = 0.0;
+		double m_alpha = 0.0;
+		uint64_t m_tick = 0;
+		uint32_t m_pendingTicks = 0;
+		Stats m_stats;
+	};
+}
+
+#endif // ENGINE_SIMULATION
@@ -0,0 +1,37 @@
+#ifndef ENGINE_SWAPCHAIN
+#define ENGINE_SWAPCHAIN
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <chrono>
+
+namespace Engine {
+	/*
+	*        .
+	*   ,  ,         
+	*/
+	struct SwapchainResize {
+		using Clock = std::chrono::steady_clock;
+
+		int width = 0; //   
+		int height = 0;
+		uint32_t events = 0; //    
+		bool suboptimal = false; // present  SUBOPTIMAL,    ,    
+		Clock::time_point lastRecreate{};
+	};
+
+	/*
+	*  ,     
+	*/
+	struct SwapchainStats {
+		uint64_t recreations = 0;
+		uint64_t coalescedEvents = 0; // ,     
+		double recreateMsSum = 0.0; // ,  CPU  recreateSwapchain
+		double recreateMsMax = 0.0;
+
+		double averageRecreate() const { return recreations ? recreateMsSum / recreations : 0.0; }
+	};
+}
+
+#endif // ENGINE_SWAPCHAIN
@@ -0,0 +1,117 @@
+#ifndef ENGINE_TRANSFORMS
+#define ENGINE_TRANSFORMS
+
+#include "../core/public/engine_jobs.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+	/*
+	*    .    ,    
+	*/
+	struct TransformHandle {
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator==(const TransformHandle& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const TransformHandle& other) const { return !(*this == other); }
+	};
+
+	enum class TransformKernel : uint32_t {
+		Scalar, // glm
+		Sse,
+		Avx //     ENGINE_AVX
+	};
+
+	const char* transformKernelName(TransformKernel kernel);
+	bool isTransformKernelSupported(TransformKernel kernel);
+	TransformKernel bestTransformKernel();
+
+	struct TransformStats {
+		uint64_t updates = 0;
+		uint64_t recomputed = 0; //   
+		uint64_t rebuilds = 0; //    
+		double updateMs = 0.0;
+	};
+
+	/*
+	*  :  TRS ->  .
+	*    SoA ,   :  ,      ,    .
+	* update   ,        .
+	*       :        
+	*/
+	class TransformHierarchy {
+	public:
+		TransformHandle create(TransformHandle parent = TransformHandle{});
+		void destroy(TransformHandle handle); //   
+		bool alive(TransformHandle handle) const;
+		void setParent(TransformHandle handle, TransformHandle parent);
+
+		void setPosition(TransformHandle handle, const glm::vec3& position);
+		void setRotation(TransformHandle handle, const glm::quat& rotation);
+		void setScale(TransformHandle handle, const glm::vec3& scale);
+		void setLocal(TransformHandle handle, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+
+		glm::vec3 position(TransformHandle handle) const;
+		glm::quat rotation(TransformHandle handle) const;
+		glm::vec3 scale(TransformHandle handle) const;
+		const glm::mat4& world(TransformHandle handle) const; //    update
+
+		void update(JobSystem& jobs);
+
+		void setKernel(TransformKernel kernel);
+		TransformKernel kernel() const { return m_kernel; }
+
+		size_t size() const { return m_count; }
+		uint32_t depth() const { return m_levels.empty() ? 0 : (uint32_t)m_levels.size() - 1; }
+		TransformStats stats() const { return m_stats; }
+		void reportStats();
+
+	private:
+		//    ,  
+		struct Node {
+			uint32_t slot = UINT32_MAX; // UINT32_MAX - 
+			uint32_t generation = 0;
+			uint32_t parent = UINT32_MAX; //   
+			uint32_t firstChild = UINT32_MAX;
+			uint32_t nextSibling = UINT32_MAX;
+			uint32_t previousSibling = UINT32_MAX;
+		};
+
+		uint32_t slotOf(TransformHandle handle) const;
+		void link(uint32_t node, uint32_t parent);
+		void unlink(uint32_t node);
+		void markDirty(uint32_t slot);
+		void rebuild();
+		uint32_t updateRange(uint32_t begin, uint32_t end); //   
+
+		std::vector<Node> m_nodes;
+		std::vector<uint32_t> m_free;
+		uint32_t m_firstRoot = UINT32_MAX; //  -    
+		uint32_t m_count = 0;
+
+		// SoA  ,   
+		std::vector<uint32_t> m_slotHandles; //  
+		std::vector<uint32_t> m_parentSlots; // UINT32_MAX - 
+		std::vector<glm::vec3> m_positions;
+		std::vector<glm::quat> m_rotations;
+		std::vector<glm::vec3> m_scales;
+		std::vector<glm::mat4> m_locals;
+		std::vector<glm::mat4> m_worlds;
+		std::vector<uint8_t> m_dirty; //  TRS 
+		std::vector<uint8_t> m_changed; //      update,   
+		std::vector<uint32_t> m_levels; //     ,   - 
+
+		bool m_structureDirty = false; // ,    ,  
+		uint32_t m_dirtyCount = 0;
+		TransformKernel m_kernel = bestTransformKernel();
+		TransformStats m_stats;
+	};
+}
+
+#endif // ENGINE_TRANSFORMS
@@ -0,0 +1,65 @@
+#ifndef ENGINE_UPLOAD
+#define ENGINE_UPLOAD
+
+#include <vulkan/vulkan.h>
+
+#include "../core/public/engine_memory.hpp"
+#include "../core/public/engine_queues.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+namespace Engine {
+	/*
+	*     GPU.
+	*     Transfer ( transfer ,   )    timeline .
+	*      GPU, CPU       
+	*/
+	class UploadService {
+	public:
+		void initialize(VkDevice device, const VkAllocationCallbacks* allocator, DeviceAllocator* memoryAllocator, QueueTopology* queues);
+		void shutdown();
+
+		/*
+		*  pixels (RGBA8)  image     SHADER_READ_ONLY_OPTIMAL.
+		*    staging   .   ,   image , 0  
+		*/
+		uint64_t uploadImage(VkImage image, uint32_t width, uint32_t height, const void* pixels, size_t size);
+
+		//  staging      
+		void collect();
+		//     ,      
+		void waitIdle();
+
+		VkSemaphore semaphore() const { return m_queues != nullptr ? m_queues->get(QueueType::Transfer).timeline : VK_NULL_HANDLE; }
+		uint64_t submittedValue() const { return m_submitted; }
+		uint32_t queueFamily() const { return m_queueFamily; }
+		bool isInitialized() const { return m_commandPool != VK_NULL_HANDLE; }
+
+	private:
+		struct Pending {
+			uint64_t value = 0;
+			VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+			VkBuffer staging = VK_NULL_HANDLE;
+			MemoryAllocation stagingMemory;
+			size_t bytes = 0;
+			std::chrono::steady_clock::time_point submitTime;
+		};
+
+		VkDevice m_device = VK_NULL_HANDLE;
+		const VkAllocationCallbacks* m_allocator = nullptr;
+		DeviceAllocator* m_memoryAllocator = nullptr;
+		QueueTopology* m_queues = nullptr; //     Transfer,   
+		uint32_t m_queueFamily = UINT32_MAX;
+
+		VkCommandPool m_commandPool = VK_NULL_HANDLE;
+		uint64_t m_submitted = 0; //     
+
+		std::mutex m_lock;
+		std::vector<Pending> m_pending;
+	};
+}
+
+#endif // ENGINE_UPLOAD
@@ -0,0 +1,343 @@
+#ifndef ENGINE_WORLD
+#define ENGINE_WORLD
+
+#include "../core/public/engine_jobs.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+	/*
+	*  -      .    ,     
+	*/
+	struct Entity {
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const Entity& other) const { return !(*this == other); }
+	};
+
+	constexpr uint32_t MaxComponents = 64;
+	using ComponentMask = std::bitset<MaxComponents>;
+
+	struct ComponentInfo {
+		const char* name = "";
+		uint32_t size = 0;
+		uint32_t alignment = 1;
+	};
+
+	/*
+	*      ,     
+	*/
+	uint32_t registerComponent(const ComponentInfo& info);
+	const ComponentInfo& componentInfo(uint32_t id);
+	uint32_t componentCount();
+
+	/*
+	*  -  :   memcpy,   
+	*/
+	template<typename T>
+	uint32_t componentId() {
+		if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+			return componentId<std::remove_cv_t<T>>(); // const T -   
+		}
+		else {
+			static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "components must be trivially copyable");
+			static const uint32_t id = registerComponent({ typeid(T).name(), (uint32_t)sizeof(T), (uint32_t)alignof(T) });
+			return id;
+		}
+	}
+
+	template<typename... Ts>
+	ComponentMask componentMask() {
+		ComponentMask mask;
+		(mask.set(componentId<Ts>()), ...);
+		return mask;
+	}
+
+	/*
+	*  -      .
+	*     ChunkSize :     Entity,       (SoA).
+	*  :       
+	*/
+	struct Archetype {
+		static constexpr size_t ChunkSize = 16 * 1024;
+
+		ComponentMask mask;
+		std::vector<uint32_t> components; //   id
+		std::vector<uint32_t> offsets; //     ,    components
+		uint8_t columns[MaxComponents]; // id  ->   components, UINT8_MAX - 
+		uint32_t capacity = 0; //   
+		uint32_t count = 0;
+		std::vector<uint8_t*> chunks; //  ,    count
+		uint8_t* spare = nullptr; //  ,         
+		Archetype* addEdges[MaxComponents] = {}; //      ,    
+		Archetype* removeEdges[MaxComponents] = {};
+
+		Entity* entities(size_t chunk) const { return (Entity*)chunks[chunk]; }
+		uint8_t* column(size_t chunk, uint32_t component) const { return chunks[chunk] + offsets[columns[component]]; }
+		uint32_t chunkCount(size_t chunk) const { return std::min(capacity, count - (uint32_t)chunk * capacity); }
+	};
+
+	class World;
+
+	/*
+	*   .   ,   :   ,
+	* World::flush    .       (World::commands),  
+	*/
+	class CommandBuffer {
+	public:
+		explicit CommandBuffer(World* world) : m_world(world) {}
+
+		Entity create(); //   ,    flush
+		void destroy(Entity entity);
+
+		template<typename T>
+		void add(Entity entity, const T& value = T{}) {
+			push(Op::Add, entity, componentId<T>(), &value, sizeof(T));
+		}
+
+		template<typename T>
+		void remove(Entity entity) {
+			push(Op::Remove, entity, componentId<T>(), nullptr, 0);
+		}
+
+		uint32_t size() const { return m_count; }
+		bool empty() const { return m_count == 0; }
+
+	private:
+		friend class World;
+
+		enum class Op : uint32_t {
+			Create,
+			Destroy,
+			Add,
+			Remove
+		};
+
+		struct Header {
+			Entity entity;
+			Op op;
+			uint32_t component;
+			uint32_t size; //    ,    8
+		};
+
+		void push(Op op, Entity entity, uint32_t component, const void* value, uint32_t size);
+
+		World* m_world;
+		std::vector<uint8_t> m_data;
+		uint32_t m_count = 0;
+		std::thread::id m_thread;
+	};
+
+	struct WorldStats {
+		uint64_t entities = 0;
+		uint64_t archetypes = 0;
+		uint64_t chunks = 0;
+		uint64_t moves = 0; //   
+		uint64_t commands = 0; //    
+		uint64_t staleCommands = 0; //   
+	};
+
+	/*
+	*    .
+	*  (each, parallelEach)          .
+	*            .
+	*   (create, destroy, add, remove) -      ,   -  commands()
+	*/
+	class World {
+	public:
+		World();
+		~World();
+
+		World(World const&) = delete;
+		void operator=(World const&) = delete;
+
+		Entity create();
+
+		//      ,   
+		template<typename... Ts>
+		Entity create(const Ts&... values) {
+			const Entity entity = createIn(findArchetype(componentMask<Ts...>()));
+			(memcpy(getComponent(entity, componentId<Ts>()), &values, sizeof(Ts)), ...);
+			return entity;
+		}
+
+		void destroy(Entity entity);
+		bool alive(Entity entity) const;
+
+		template<typename T>
+		T& add(Entity entity, const T& value = T{}) {
+			return *(T*)addComponent(entity, componentId<T>(), &value);
+		}
+
+		template<typename T>
+		void remove(Entity entity) {
+			removeComponent(entity, componentId<T>());
+		}
+
+		template<typename T>
+		bool has(Entity entity) const {
+			return alive(entity) && m_records[entity.index].archetype->mask.test(componentId<T>());
+		}
+
+		template<typename T>
+		T* get(Entity entity) {
+			return (T*)getComponent(entity, componentId<T>());
+		}
+
+		/*
+		* fn(Ts&...)  fn(Entity, Ts&...). const  Ts -  ,     
+		*/
+		template<typename... Ts, typename F>
+		void each(F&& function) {
+			const std::vector<Archetype*>& archetypes = query(componentMask<Ts...>());
+			for (Archetype* archetype : archetypes) {
+				for (size_t chunk = 0; chunk < archetype->chunks.size(); chunk++) {
+					eachInChunk<Ts...>(*archetype, chunk, function);
+				}
+			}
+		}
+
+		/*
+		*     . fn     ,   -  commands()
+		*/
+		template<typename... Ts, typename F>
+		void parallelEach(JobSystem& jobs, F&& function) {
+			const std::vector<ChunkRef>& chunks = chunkList(componentMask<Ts...>());
+			jobs.parallelFor((uint32_t)chunks.size(), 0, [&](uint32_t begin, uint32_t end) {
+				for (uint32_t i = begin; i < end; i++) {
+					eachInChunk<Ts...>(*chunks[i].archetype, chunks[i].chunk, function);
+				}
+			});
+		}
+
+		CommandBuffer& commands(); //   
+		void flush(); //    ,    
+
+		size_t size() const { return m_entityCount; }
+		WorldStats stats() const;
+		void reportStats();
+
+	private:
+		friend class CommandBuffer;
+
+		struct Record {
+			Archetype* archetype = nullptr; // nullptr -      
+			uint32_t row = 0;
+			uint32_t generation = 0;
+		};
+
+		struct ChunkRef {
+			Archetype* archetype;
+			size_t chunk;
+		};
+
+		struct ChunkList {
+			uint64_t version = UINT64_MAX; // m_structureVersion   
+			std::vector<ChunkRef> chunks;
+		};
+
+		template<typename... Ts, typename F>
+		static void eachInChunk(Archetype& archetype, size_t chunk, F& function) {
+			const uint32_t count = archetype.chunkCount(chunk);
+			Entity* entities = archetype.entities(chunk);
+			auto arrays = std::make_tuple((Ts*)archetype.column(chunk, componentId<Ts>())...);
+			for (uint32_t i = 0; i < count; i++) {
+				if constexpr (std::is_invocable_v<F&, Entity, Ts&...>) {
+					function(entities[i], std::get<Ts*>(arrays)[i]...);
+				}
+				else {
+					function(std::get<Ts*>(arrays)[i]...);
+				}
+			}
+		}
+
+		Archetype* findArchetype(const ComponentMask& mask);
+		const std::vector<Archetype*>& query(const ComponentMask& mask);
+		const std::vector<ChunkRef>& chunkList(const ComponentMask& mask);
+
+		Entity createIn(Archetype* archetype);
+		Entity reserve(); // ,  CommandBuffer::create
+		void place(Entity entity, Archetype* archetype);
+		uint32_t pushRow(Archetype* archetype, Entity entity);
+		void removeRow(Archetype* archetype, uint32_t row);
+		void move(Entity entity, Archetype* target);
+		void* addComponent(Entity entity, uint32_t component, const void* value);
+		void removeComponent(Entity entity, uint32_t component);
+		void* getComponent(Entity entity, uint32_t component);
+		void apply(CommandBuffer& buffer);
+
+		std::vector<Record> m_records;
+		std::vector<uint32_t> m_free;
+		std::mutex m_reserveLock; // m_free  m_reserved   
+		uint32_t m_reserved = 0; //    m_records,     flush
+		size_t m_entityCount = 0;
+
+		std::vector<std::unique_ptr<Archetype>> m_archetypes;
+		std::unordered_map<ComponentMask, Archetype*> m_archetypeMap;
+		std::mutex m_queryLock; //     ,    
+		std::unordered_map<ComponentMask, std::vector<Archetype*>> m_queries;
+		std::unordered_map<ComponentMask, ChunkList> m_chunkLists; //    
+		uint64_t m_structureVersion = 0;
+
+		std::mutex m_commandsLock;
+		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+		uint64_t m_id; //     ,    
+
+		WorldStats m_stats;
+	};
+
+	struct SystemContext {
+		World& world;
+		JobSystem& jobs;
+		uint32_t tick;
+		double deltaTime;
+	};
+
+	using SystemFunction = std::function<void(SystemContext& context)>;
+
+	/*
+	*   .   -     :
+	*   ,   ,     ,   ,   .
+	*      JobGraph,   - World::flush
+	*/
+	class SystemScheduler {
+	public:
+		uint32_t add(const char* name, const ComponentMask& reads, const ComponentMask& writes, SystemFunction function, bool mainThread = false);
+		void run(World& world, JobSystem& jobs, uint32_t tick, double deltaTime);
+		void clear();
+
+		size_t size() const { return m_systems.size(); }
+
+	private:
+		struct System {
+			const char* name;
+			ComponentMask reads;
+			ComponentMask writes;
+			SystemFunction function;
+			bool mainThread = false;
+		};
+
+		void build();
+
+		std::vector<System> m_systems;
+		JobGraph m_graph;
+		bool m_dirty = false;
+		SystemContext* m_context = nullptr; //   run
+	};
+}
+
+#endif // ENGINE_WORLD
@@ -0,0 +1,278 @@
+#include "../core/public/engine_binary_log.hpp"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/fmt/bundled/args.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/*
+*     (--binlog, --flight-recorder)   .
+* binlog_decode <> [--level=warning] [--channel=vulkan] [--stats]
+*         ,      
+*/
+
+namespace {
+    struct Format {
+        bool known = false;
+        int level = 0;
+        uint32_t line = 0;
+        std::string channel;
+        std::string format;
+        std::string types;
+        std::string file;
+        uint64_t count = 0;
+    };
+
+    struct Event {
+        const uint8_t* data; // EventHeader + 
+        int64_t time;
+    };
+
+    constexpr uint32_t MaxFormats = 1 << 20; //       ,  id -  
+
+    const char* levelNames[] = { "trace", "debug", "info", "warning", "error", "critical", "off" };
+
+    const char* levelName(int level) {
+        return level >= 0 && level < (int)(sizeof(levelNames) / sizeof(levelNames[0])) ? levelNames[level] : "?";
+    }
+
+    int parseLevel(const char* name) {
+        for (int i = 0; i < (int)(sizeof(levelNames) / sizeof(levelNames[0])); i++) {
+            if (strcmp(name, levelNames[i]) == 0) {
+                return i;
+            }
+        }
+        return atoi(name);
+    }
+
+    bool readFile(const char* path, std::vector<uint8_t>& bytes) {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        bytes.resize(size > 0 ? (size_t)size : 0);
+        const bool read = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        fclose(file);
+        return read;
+    }
+
+    std::string readString(const uint8_t*& cursor, size_t length) {
+        std::string text((const char*)cursor, length);
+        cursor += length;
+        return text;
+    }
+
+    /*
+    *           
+    */
+    std::string formatMessage(const Format& format, const uint8_t* args, size_t size) {
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        const uint8_t* cursor = args;
+        const uint8_t* end = args + size;
+        for (char type : format.types) {
+            if (type == 's') {
+                uint16_t length;
+                if (cursor + sizeof(length) > end) {
+                    break;
+                }
+                memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                length = (uint16_t)std::min<size_t>(length, end - cursor);
+                store.push_back(std::string((const char*)cursor, length));
+                cursor += length;
+                continue;
+            }
+
+            if (cursor + sizeof(uint64_t) > end) {
+                break;
+            }
+            uint64_t bits;
+            memcpy(&bits, cursor, sizeof(bits));
+            cursor += sizeof(bits);
+            if (type == 'i') {
+                store.push_back((int64_t)bits);
+            }
+            else if (type == 'c') {
+                store.push_back((char)bits);
+            }
+            else if (type == 'b') {
+                store.push_back(bits != 0);
+            }
+            else if (type == 'f') {
+                double number;
+                memcpy(&number, &bits, sizeof(number));
+                store.push_back(number);
+            }
+            else {
+                store.push_back(bits);
+            }
+        }
+
+        try {
+            return fmt::vformat(format.format, store);
+        }
+        catch (const fmt::format_error& error) {
+            return fmt::format("{} <format error: {}>", format.format, error.what());
+        }
+    }
+
+    std::string formatTime(int64_t wallClock, int64_t time) {
+        const int64_t ns = wallClock + time;
+        const time_t seconds = (time_t)(ns / 1000000000);
+        tm local;
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        char text[32];
+        strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        return fmt::format("{}.{:06}", text, (ns % 1000000000) / 1000);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    int minLevel = 0;
+    std::string channel;
+    bool stats = false;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--level=", 8) == 0) {
+            minLevel = parseLevel(argv[i] + 8);
+        }
+        else if (strncmp(argv[i], "--channel=", 10) == 0) {
+            channel = argv[i] + 10;
+        }
+        else if (strcmp(argv[i], "--stats") == 0) {
+            stats = true; //   -     
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    if (path == nullptr) {
+        fprintf(stderr, "usage: binlog_decode <file.blog> [--level=warning] [--channel=vulkan] [--stats]\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes) || bytes.size() < sizeof(Engine::BinaryLogFormat::FileHeader)) {
+        fprintf(stderr, "Can't read '%s'\n", path);
+        return 1;
+    }
+
+    Engine::BinaryLogFormat::FileHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (memcmp(header.magic, Engine::BinaryLogFormat::Magic, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "'%s' is not an engine binary log\n", path);
+        return 1;
+    }
+
+    std::vector<Format> formats;
+    std::vector<Event> events;
+    uint64_t total = 0;
+    size_t offset = sizeof(header);
+    while (offset + sizeof(Engine::BinaryLogFormat::BlockHeader) <= bytes.size()) {
+        Engine::BinaryLogFormat::BlockHeader block;
+        memcpy(&block, bytes.data() + offset, sizeof(block));
+        offset += sizeof(block);
+        if (offset + block.size > bytes.size()) {
+            fprintf(stderr, "Truncated block at %zu, the rest of the file is skipped\n", offset - sizeof(block)); //    
+            break;
+        }
+
+        const uint8_t* cursor = bytes.data() + offset;
+        const uint8_t* end = cursor + block.size;
+        offset += block.size;
+
+        if (block.type == Engine::BinaryLogFormat::Formats) {
+            while (cursor + sizeof(Engine::BinaryLogFormat::FormatRecord) <= end) {
+                Engine::BinaryLogFormat::FormatRecord record;
+                memcpy(&record, cursor, sizeof(record));
+                cursor += sizeof(record);
+                const size_t length = (size_t)record.channelLength + record.formatLength + record.typesLength + record.fileLength;
+                if (record.id >= MaxFormats || length > (size_t)(end - cursor)) {
+                    fprintf(stderr, "Corrupted format record at %zu, the rest of the block is skipped\n", (size_t)(cursor - bytes.data()) - sizeof(record));
+                    break;
+                }
+                if (record.id >= formats.size()) {
+                    formats.resize(record.id + 1);
+                }
+
+                Format& format = formats[record.id];
+                format.known = true;
+                format.level = record.level;
+                format.line = record.line;
+                format.channel = readString(cursor, record.channelLength);
+                format.format = readString(cursor, record.formatLength);
+                format.types = readString(cursor, record.typesLength);
+                format.file = readString(cursor, record.fileLength);
+            }
+            continue;
+        }
+
+        if (block.type != Engine::BinaryLogFormat::Events) {
+            continue; //    
+        }
+
+        //      ,      
+        const size_t first = events.size();
+        while (cursor + sizeof(Engine::BinaryLogFormat::EventHeader) <= end) {
+            Engine::BinaryLogFormat::EventHeader event;
+            memcpy(&event, cursor, sizeof(event));
+            if (event.size > (size_t)(end - cursor) - sizeof(event)) {
+                fprintf(stderr, "Corrupted event at %zu, the rest of the block is skipped\n", (size_t)(cursor - bytes.data()));
+                break;
+            }
+            events.push_back({ cursor, event.time });
+            cursor += Engine::BinaryLogFormat::align(sizeof(event) + event.size);
+        }
+        std::stable_sort(events.begin() + first, events.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+
+        for (size_t i = first; i < events.size(); i++) {
+            Engine::BinaryLogFormat::EventHeader event;
+            memcpy(&event, events[i].data, sizeof(event));
+            total++;
+            if (event.format >= formats.size() || !formats[event.format].known) {
+                printf("[%s] [?] [?] [t%u] <unknown format %u>\n", formatTime(header.wallClock, event.time).c_str(), event.thread, event.format);
+                continue;
+            }
+
+            Format& format = formats[event.format];
+            if (format.level < minLevel || (!channel.empty() && format.channel != channel)) {
+                continue;
+            }
+            format.count++;
+            if (!stats) {
+                const std::string message = formatMessage(format, events[i].data + sizeof(event), event.size);
+                printf("[%s] [%s] [%s] [t%u] %s\n", formatTime(header.wallClock, event.time).c_str(), format.channel.c_str(), levelName(format.level), event.thread, message.c_str());
+            }
+        }
+        events.clear();
+    }
+
+    if (stats) {
+        std::vector<const Format*> sorted;
+        for (const Format& format : formats) {
+            if (format.count > 0) {
+                sorted.push_back(&format);
+            }
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Format* a, const Format* b) { return a->count > b->count; });
+        for (const Format* format : sorted) {
+            printf("%12llu  %-9s %-8s %s:%u  %s\n", (unsigned long long)format->count, format->channel.c_str(), levelName(format->level), format->file.c_str(), format->line, format->format.c_str());
+        }
+        printf("%llu events, %zu formats\n", (unsigned long long)total, formats.size());
+    }
+
+    return 0;
+}